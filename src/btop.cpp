@@ -20,6 +20,7 @@ tab-size = 4
 #include <csignal>
 #include <clocale>
 #include <pthread.h>
+#include <sys/resource.h>
 #ifdef __FreeBSD__
 	#include <pthread_np.h>
 #endif
@@ -39,12 +40,10 @@ tab-size = 4
 	#include <mach-o/dyld.h>
 	#include <limits.h>
 #endif
-#if !defined(__clang__) && __GNUC__ < 11
-	#include <semaphore.h>
-#else
-	#include <semaphore>
-#endif
+#include <condition_variable>
+#include <mutex>
 
+#include "btop.hpp"
 #include "btop_shared.hpp"
 #include "btop_tools.hpp"
 #include "btop_config.hpp"
@@ -52,6 +51,8 @@ tab-size = 4
 #include "btop_theme.hpp"
 #include "btop_draw.hpp"
 #include "btop_menu.hpp"
+#include "btop_procfs.hpp"
+#include "btop_screen.hpp"
 #include "config.h"
 #include "fmt/core.h"
 #include "fmt/ostream.h"
@@ -65,6 +66,7 @@ using std::string;
 using std::string_view;
 using std::to_string;
 using std::vector;
+using Theme::Color;
 
 namespace fs = std::filesystem;
 
@@ -275,6 +277,7 @@ void term_resize(bool force) {
 #endif
 	Global::resized = true;
 	if (Runner::active) Runner::stop();
+	Screen::drain(1000);
 	Term::refresh();
 	Config::unlock();
 
@@ -303,6 +306,7 @@ void term_resize(bool force) {
 						"minWidth"_a = minWidth,
 						"minHeight"_a = minHeight
 			) << std::flush;
+			Screen::invalidate();
 
          std::optional<KeyEvent> k_opt;
          for (; !Term::refresh() && !k_opt.has_value(); k_opt = Input::try_get(10));
@@ -356,9 +360,12 @@ void clean_quit(int sig) {
 
 	Config::write();
 
+	Screen::stop();
+
 	if (Term::initialized) {
 		Input::clear();
 		Term::restore();
+		Screen::invalidate();
 	}
 
 	if (not Global::exit_error_msg.empty()) {
@@ -380,13 +387,17 @@ void clean_quit(int sig) {
 //* Handler for SIGTSTP; stops threads, restores terminal and sends SIGSTOP
 void _sleep() {
 	Runner::stop();
+	Screen::drain(1000);
 	Term::restore();
+	Screen::invalidate();
 	std::raise(SIGSTOP);
 }
 
 //* Handler for SIGCONT; re-initialize terminal and force a resize event
 void _resume() {
 	Term::init();
+	//? The terminal was cleared while stopped, nothing from the last frame can be diffed against
+	Screen::invalidate();
 	term_resize(true);
 }
 
@@ -437,6 +448,7 @@ void init_config(){
 	atomic_lock lck(Global::init_conf);
    
    g_CfgMgr.load();
+	update_units();
 
 	static bool first_init = true;
 
@@ -463,35 +475,73 @@ namespace Runner {
 	atomic<bool> waiting (false);
 	atomic<bool> redraw (false);
 	atomic<bool> coreNum_reset (false);
+	atomic<bool> focused (true);
+	atomic<bool> alive (false);
+	atomic<State> state (State::idle);
+
+	//* Incremented when a stalled runner thread is replaced, a cancelled thread still unwinding has an older generation
+	atomic<uint64_t> generation (1);
+
+	atomic<uint64_t> cycles (0);
+	atomic<uint64_t> overlapped_cycles (0);
+	atomic<int> cycles_running (0);
+
+	//* Guards state changes so waiters on state_cv can't miss a notification
+	std::mutex state_mtx;
+	std::condition_variable state_cv;
+
+	//* Set runner state, Runner::active mirrors any state other than idle.
+	//* Changes made by the runner thread pass its <owner> generation and are ignored once that thread has been replaced,
+	//* the runner can also only move from stopping to idle, returns false if the change was ignored
+	bool set_state(const State new_state, const uint64_t owner = 0) {
+		{
+			std::lock_guard lck(state_mtx);
+			if (owner != 0 and (owner != generation or (state == State::stopping and new_state != State::idle))) return false;
+			state = new_state;
+			active = (new_state != State::idle);
+		}
+		state_cv.notify_all();
+		active.notify_all();
+		return true;
+	}
 
-	//* Setup semaphore for triggering thread to do work
-#if !defined(__clang__) && __GNUC__ < 11
-	sem_t do_work;
-	inline void thread_sem_init() { sem_init(&do_work, 0, 0); }
-	inline void thread_wait() { sem_wait(&do_work); }
-	inline void thread_trigger() { sem_post(&do_work); }
-#else
-	std::binary_semaphore do_work(0);
-	inline void thread_sem_init() { ; }
-	inline void thread_wait() { do_work.acquire(); }
-	inline void thread_trigger() { do_work.release(); }
-#endif
+	bool wait_idle(const uint64_t wait_ms) {
+		std::unique_lock lck(state_mtx);
+		return state_cv.wait_for(lck, std::chrono::milliseconds(wait_ms), [] { return state == State::idle; });
+	}
 
-	//* RAII wrapper for pthread_mutex locking
-	class thread_lock {
-		pthread_mutex_t& pt_mutex;
+	//* Blocks runner thread until work is handed over by Runner::run or quitting is set,
+	//* the state might already have moved on to stopping before the runner wakes up
+	void wait_work() {
+		std::unique_lock lck(state_mtx);
+		state_cv.wait(lck, [] { return state != State::idle or Global::quitting; });
+	}
+
+	//* Returns runner to idle when a cycle ends, including early exits with continue
+	class cycle_guard {
+		uint64_t owner;
 	public:
-		int status;
-		thread_lock(pthread_mutex_t& mtx) : pt_mutex(mtx) {
-			pthread_mutex_init(&pt_mutex, nullptr);
-			status = pthread_mutex_lock(&pt_mutex);
+		explicit cycle_guard(uint64_t owner) : owner(owner) {
+			cycles++;
+			if (cycles_running.fetch_add(1) > 0) {
+				overlapped_cycles++;
+				Logger::error("Runner cycle started while another one was still running!");
+			}
 		}
-		~thread_lock() {
-			if (status == 0)
-				pthread_mutex_unlock(&pt_mutex);
+		~cycle_guard() {
+			cycles_running--;
+			set_state(State::idle, owner);
 		}
 	};
 
+	//* Tracks whether the runner thread is still running its loop, a replaced thread leaves the flag to its successor
+	class alive_guard {
+		uint64_t owner;
+	public:
+		explicit alive_guard(uint64_t owner) : owner(owner) { alive = true; }
+		~alive_guard() { if (owner == generation) alive = false; }
+	};
+
 	//* Wrapper for raising privileges when using SUID bit
 	class gain_priv {
 		int status = -1;
@@ -511,7 +561,6 @@ namespace Runner {
 	bool pause_output{};
 	sigset_t mask;
 	pthread_t runner_id;
-	pthread_mutex_t mtx;
 
 	enum debug_actions {
 		collect_begin,
@@ -529,6 +578,21 @@ namespace Runner {
 	string debug_bg;
 	std::unordered_map<string, array<uint64_t, 2>> debug_times;
 
+	//* Tick lateness percentiles in microseconds, written by the main thread and shown in the debug box
+	atomic<uint64_t> jitter_p50 (0), jitter_p99 (0);
+
+	void tick_jitter(const uint64_t late_us) {
+		static array<uint64_t, 128> samples{};
+		static size_t count = 0;
+		samples[count++ % samples.size()] = late_us;
+
+		array<uint64_t, 128> sorted = samples;
+		const size_t n = min(count, sorted.size());
+		std::sort(sorted.begin(), sorted.begin() + n);
+		jitter_p50 = sorted[n / 2];
+		jitter_p99 = sorted[(n * 99) / 100];
+	}
+
 	class MyNumPunct : public std::numpunct<char>
 	{
 	protected:
@@ -542,6 +606,7 @@ namespace Runner {
 		bool no_update;
 		bool force_redraw;
 		bool background_update;
+		bool collect_only;
 		string overlay;
 		string clock;
 	};
@@ -582,32 +647,17 @@ namespace Runner {
 		sigaddset(&mask, SIGTERM);
 		pthread_sigmask(SIG_BLOCK, &mask, nullptr);
 
-		//? pthread_mutex_lock to lock thread and monitor health from main thread
-		thread_lock pt_lck(mtx);
-		if (pt_lck.status != 0) {
-			Global::exit_error_msg = "Exception in runner thread -> pthread_mutex_lock error id: " + to_string(pt_lck.status);
-			Global::thread_exception = true;
-			Input::interrupt();
-			stopping = true;
-		}
+		//? Lets the main thread detect if this thread has exited
+		const uint64_t owner = generation;
+		alive_guard alive_lck(owner);
 
 		//* ----------------------------------------------- THREAD LOOP -----------------------------------------------
 		while (not Global::quitting) {
-			thread_wait();
-			atomic_wait_for(active, true, 5000);
-			if (active) {
-				Global::exit_error_msg = "Runner thread failed to get active lock!";
-				Global::thread_exception = true;
-				Input::interrupt();
-				stopping = true;
-			}
-			if (stopping or Global::resized) {
-				sleep_ms(1);
-				continue;
-			}
+			wait_work();
+			if (Global::quitting) break;
 
-			//? Atomic lock used for blocking non thread-safe actions in main thread
-			atomic_lock lck(active);
+			cycle_guard cycle_lck(owner);
+			if (stopping or Global::resized) continue;
 
 			//? Set effective user if SUID bit is set
 			gain_priv powers{};
@@ -619,9 +669,9 @@ namespace Runner {
                 if (debug_bg.empty() or redraw)
                     Runner::debug_bg = Draw::createBox(2, 2, 33,
 					#ifdef GPU_SUPPORT
-						9,
+						15,
 					#else
-						8,
+						14,
 					#endif
 					"", true, "μs");
 
@@ -630,6 +680,7 @@ namespace Runner {
 			}
 
 			output.clear();
+			if (not conf.no_update) Adaptive::begin_sample();
 
 			//* Run collection and draw functions for all boxes
 			try {
@@ -663,6 +714,7 @@ namespace Runner {
 
 						//? Start collect
 						auto cpu = Cpu::collect(conf.no_update);
+						if (not conf.no_update) Adaptive::sample(cpu);
 
 						if (coreNum_reset) {
 							coreNum_reset = false;
@@ -675,7 +727,7 @@ namespace Runner {
 						if (Global::debug) debug_timer("cpu", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Cpu::draw(cpu, gpus_ref, conf.force_redraw, conf.no_update);
+						if (not pause_output and not conf.collect_only) output += Cpu::draw(cpu, gpus_ref, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("cpu", draw_done);
 					}
@@ -690,7 +742,7 @@ namespace Runner {
 						if (Global::debug) debug_timer("gpu", draw_begin_only);
 
 						//? Draw box
-						if (not pause_output)
+						if (not pause_output and not conf.collect_only)
 							for (unsigned long i = 0; i < gpu_panels.size(); ++i)
 								output += Gpu::draw(gpus_ref[gpu_panels[i]], i, conf.force_redraw, conf.no_update);
 
@@ -708,11 +760,12 @@ namespace Runner {
 
 						//? Start collect
 						auto mem = Mem::collect(conf.no_update);
+						if (not conf.no_update) Adaptive::sample(mem);
 
 						if (Global::debug) debug_timer("mem", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Mem::draw(mem, conf.force_redraw, conf.no_update);
+						if (not pause_output and not conf.collect_only) output += Mem::draw(mem, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("mem", draw_done);
 					}
@@ -728,11 +781,12 @@ namespace Runner {
 
 						//? Start collect
 						auto net = Net::collect(conf.no_update);
+						if (not conf.no_update) Adaptive::sample(net);
 
 						if (Global::debug) debug_timer("net", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Net::draw(net, conf.force_redraw, conf.no_update);
+						if (not pause_output and not conf.collect_only) output += Net::draw(net, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("net", draw_done);
 					}
@@ -752,7 +806,7 @@ namespace Runner {
 						if (Global::debug) debug_timer("proc", draw_begin);
 
 						//? Draw box
-						if (not pause_output) output += Proc::draw(proc, conf.force_redraw, conf.no_update);
+						if (not pause_output and not conf.collect_only) output += Proc::draw(proc, conf.force_redraw, conf.no_update);
 
 						if (Global::debug) debug_timer("proc", draw_done);
 					}
@@ -773,6 +827,11 @@ namespace Runner {
 				continue;
 			}
 
+			if (not conf.no_update) Adaptive::end_sample();
+
+			//? Keep collecting history but skip output while the terminal is unfocused
+			if (conf.collect_only) continue;
+
 			if (redraw or conf.force_redraw) {
 				empty_bg.clear();
 				redraw = false;
@@ -795,7 +854,7 @@ namespace Runner {
 						"{mv7}{hiFg}esc {mainFg}| Show menu"
 						"{mv8}{hiFg}q {mainFg}| Quit",
 						"banner"_a = Draw::banner_gen(y, 0, true),
-						"titleFg"_a = Theme::c("title"), "b"_a = Fx::b, "hiFg"_a = Theme::c("hi_fg"), "mainFg"_a = Theme::c("main_fg"),
+						"titleFg"_a = Theme::c(Color::title), "b"_a = Fx::b, "hiFg"_a = Theme::c(Color::hi_fg), "mainFg"_a = Theme::c(Color::main_fg),
 						"mv1"_a = Mv::to(y+6, x),
 						"mv2"_a = Mv::to(y+8, x),
 						"mv3"_a = Mv::to(y+9, x),
@@ -811,10 +870,10 @@ namespace Runner {
 
 			//! DEBUG stats -->
 			if (Global::debug and not Menu::active) {
-				output += fmt::format("{pre}{box:5.5} {collect:>12.12} {draw:>12.12}{post}",
-					"pre"_a = debug_bg + Theme::c("title") + Fx::b,
+				fmt::format_to(std::back_inserter(output), "{pre}{box:5.5} {collect:>12.12} {draw:>12.12}{post}",
+					"pre"_a = debug_bg + Theme::c(Color::title) + Fx::b,
 					"box"_a = "box", "collect"_a = "collect", "draw"_a = "draw",
-					"post"_a = Theme::c("main_fg") + Fx::ub
+					"post"_a = Theme::c(Color::main_fg) + Fx::ub
 				);
 				static auto loc = std::locale(std::locale::classic(), new MyNumPunct);
 			#ifdef GPU_SUPPORT
@@ -825,46 +884,119 @@ namespace Runner {
 					if (not debug_times.contains(name)) debug_times[name] = {0,0};
 					const auto& [time_collect, time_draw] = debug_times.at(name);
 					if (name == "total") output += Fx::b;
-					output += fmt::format(loc, "{mvLD}{name:5.5} {collect:12L} {draw:12L}",
+					fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {collect:12L} {draw:12L}",
 						"mvLD"_a = Mv::l(31) + Mv::d(1),
 						"name"_a = name,
 						"collect"_a = time_collect,
 						"draw"_a = time_draw
 					);
 				}
+				fmt::format_to(std::back_inserter(output), loc, "{mvLD}{ub}{name:5.5} {interval:>10L}ms {wakeups:>8L}/min",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"ub"_a = Fx::ub,
+					"name"_a = "rate",
+					"interval"_a = Adaptive::interval.load(),
+					"wakeups"_a = Adaptive::wakeups_per_min()
+				);
+
+				fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {p50:>9L}p50 {p99:>9L}p99",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "tick",
+					"p50"_a = jitter_p50.load(),
+					"p99"_a = jitter_p99.load()
+				);
+
+				//? Bytes written since last frame, including the clock and overlay writes in between
+				static uint64_t last_bytes_in = Screen::bytes_in.load(), last_bytes_out = Screen::bytes_out.load();
+				const uint64_t bytes_in = Screen::bytes_in.load(), bytes_out = Screen::bytes_out.load();
+				fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {in:12L} {out:12L}",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "bytes",
+					"in"_a = bytes_in - last_bytes_in,
+					"out"_a = bytes_out - last_bytes_out
+				);
+				last_bytes_in = bytes_in;
+				last_bytes_out = bytes_out;
+
+				fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {latency:12L} {dropped:>8L}drop",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "write",
+					"latency"_a = Screen::write_latency.load(),
+					"dropped"_a = Screen::frames_dropped.load()
+				);
+
+				//? File syscalls made by the collectors since last frame and sysfs attributes held open
+				static uint64_t last_syscalls = Procfs::syscalls.load();
+				const uint64_t syscalls = Procfs::syscalls.load();
+				fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {calls:>9L}/tk {handles:>9L}fds",
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "sys",
+					"calls"_a = syscalls - last_syscalls,
+					"handles"_a = Procfs::open_handles.load()
+				);
+				last_syscalls = syscalls;
+
+				//? Voluntary and involuntary context switches per second since last frame
+				static uint64_t last_csw_time = time_micros();
+				static array<long, 2> last_csw{};
+				if (struct rusage usage; getrusage(RUSAGE_SELF, &usage) == 0) {
+					const uint64_t now = time_micros();
+					const double elapsed = std::max<uint64_t>(1, now - last_csw_time) / 1000000.0;
+					fmt::format_to(std::back_inserter(output), loc, "{mvLD}{name:5.5} {vol:12L} {invol:12L}",
+						"mvLD"_a = Mv::l(31) + Mv::d(1),
+						"name"_a = "csw/s",
+						"vol"_a = std::lround((usage.ru_nvcsw - last_csw[0]) / elapsed),
+						"invol"_a = std::lround((usage.ru_nivcsw - last_csw[1]) / elapsed)
+					);
+					last_csw = {usage.ru_nvcsw, usage.ru_nivcsw};
+					last_csw_time = now;
+				}
 			}
 
+			//? Output is dropped if stop() asked for the cycle to end or this thread has been replaced
+			if (not set_state(State::drawing, owner)) continue;
+
 			//? If overlay isn't empty, print output without color and then print overlay on top
-			cout << Term::sync_start << (conf.overlay.empty()
+			Screen::write(conf.overlay.empty()
 					? output
-					: (output.empty() ? "" : Fx::ub + Theme::c("inactive_fg") + Fx::uncolor(output)) + conf.overlay)
-				<< Term::sync_end << flush;
+					: (output.empty() ? "" : Fx::ub + Theme::c(Color::inactive_fg) + Fx::uncolor(output)) + conf.overlay,
+				g_CfgMgr.get<CfgB>("diff_output").v());
 		}
 		//* ----------------------------------------------- THREAD LOOP -----------------------------------------------
 		return {};
 	}
 	//? ------------------------------------------ Secondary thread end -----------------------------------------------
 
+	bool start() {
+		alive = true;
+		return pthread_create(&runner_id, nullptr, &_runner, nullptr) == 0;
+	}
+
 	//* Runs collect and draw in a secondary thread, unlocks and locks config to update cached values
 	void run(const string& box, bool no_update, bool force_redraw) {
-		atomic_wait_for(active, true, 5000);
-		if (active) {
+		if (not wait_idle(5000)) {
 			Logger::error("Stall in Runner thread, restarting!");
-			active = false;
-			// exit(1);
+			//? Cancellation is deferred, the old thread is detached and its generation retired so it can't touch
+			//? the state of the new thread when it finally unwinds
 			pthread_cancel(Runner::runner_id);
-			if (pthread_create(&Runner::runner_id, nullptr, &Runner::_runner, nullptr) != 0) {
+			pthread_detach(Runner::runner_id);
+			generation++;
+			set_state(State::idle);
+			if (not start()) {
 				Global::exit_error_msg = "Failed to re-create _runner thread!";
 				clean_quit(1);
 			}
 		}
 		if (stopping or Global::resized) return;
 
+		const bool collect_only = (not focused and g_CfgMgr.get<CfgB>("pause_unfocused").v());
+
 		if (box == "overlay") {
-			cout << Term::sync_start << Global::overlay << Term::sync_end << flush;
+			Screen::write(Global::overlay, g_CfgMgr.get<CfgB>("diff_output").v());
 		}
 		else if (box == "clock") {
-			cout << Term::sync_start << Global::clock << Term::sync_end << flush;
+			if (collect_only) return;
+			Screen::write(Global::clock, g_CfgMgr.get<CfgB>("diff_output").v());
 		}
 		else {
 			Config::unlock();
@@ -875,32 +1007,34 @@ namespace Runner {
 				no_update, force_redraw,
 				(!g_CfgMgr.get<CfgB>("tty_mode").v()
              && g_CfgMgr.get<CfgB>("background_update").v()),
+				collect_only,
 				Global::overlay,
 				Global::clock
 			};
 
 			if (Menu::active and not current_conf.background_update) Global::overlay.clear();
 
-			thread_trigger();
-			atomic_wait_for(active, false, 10);
+			//? Handing over work is the state change itself, Runner::active is true when this returns
+			set_state(State::collecting);
 		}
-
-
 	}
 
 	//* Stops any work being done in runner thread and checks for thread errors
 	void stop() {
 		stopping = true;
-		int ret = pthread_mutex_trylock(&mtx);
-		if (ret != EBUSY and not Global::quitting) {
-			if (active) active = false;
+		if (not alive and not Global::quitting) {
+			set_state(State::idle);
 			Global::exit_error_msg = "Runner thread died unexpectedly!";
 			clean_quit(1);
 		}
-		else if (ret == EBUSY) {
-			atomic_wait_for(active, true, 5000);
-			if (active) {
-				active = false;
+		else if (alive) {
+			{
+				std::lock_guard lck(state_mtx);
+				if (state != State::idle) state = State::stopping;
+			}
+			state_cv.notify_all();
+			if (not wait_idle(5000)) {
+				set_state(State::idle);
 				if (Global::quitting) {
 					return;
 				}
@@ -909,10 +1043,9 @@ namespace Runner {
 					clean_quit(1);
 				}
 			}
-			thread_trigger();
-			atomic_wait_for(active, false, 100);
-			atomic_wait_for(active, true, 100);
 		}
+		//? Wake the runner if it's waiting for work so it can see Global::quitting
+		state_cv.notify_all();
 		stopping = false;
 	}
 
@@ -920,12 +1053,13 @@ namespace Runner {
 
 
 //* --------------------------------------------- Main starts here! ---------------------------------------------------
-int main(int argc, char **argv) {
+int btop_main(int argc, char **argv) {
    if (!g_CfgMgr.init()) {
       std::cout << "Failed to load default configuration" << std::endl;
       return 1;
    }
    g_CfgMgr.load();
+   update_units();
 
    g_CfgMgr.set<CfgI>("update_ms", 300);
 	//? ------------------------------------------------ INIT ---------------------------------------------------------
@@ -1073,6 +1207,17 @@ int main(int argc, char **argv) {
 		clean_quit(1);
 	}
 
+#ifdef __linux__
+	//? Signals are read from a signalfd by Input::poll and handled on the main thread
+	if (not Input::init(_signal_handler)) {
+		Global::exit_error_msg = "Failed to setup input event loop!";
+		clean_quit(1);
+	}
+#endif
+
+	//? Frames are written from a separate thread so a slow terminal doesn't hold up collection
+	Screen::start();
+
 	if (Term::current_tty != "unknown") Logger::info("Running on " + Term::current_tty);
 	if (not Global::arg_tty && g_CfgMgr.get<CfgB>("force_tty").v()) {
 		Config::set("tty_mode", true);
@@ -1118,6 +1263,8 @@ int main(int argc, char **argv) {
 
 	//? Setup signal handlers for CTRL-C, CTRL-Z, resume and terminal resize
 	std::atexit(_exit_handler);
+	sigset_t mask;
+#ifndef __linux__
 	std::signal(SIGINT, _signal_handler);
 	std::signal(SIGTSTP, _signal_handler);
 	std::signal(SIGCONT, _signal_handler);
@@ -1125,14 +1272,13 @@ int main(int argc, char **argv) {
 	std::signal(SIGUSR1, _signal_handler);
 	std::signal(SIGUSR2, _signal_handler);
 
-	sigset_t mask;
 	sigemptyset(&mask);
 	sigaddset(&mask, SIGUSR1);
 	pthread_sigmask(SIG_BLOCK, &mask, &Input::signal_mask);
+#endif
 
 	//? Start runner thread
-	Runner::thread_sem_init();
-	if (pthread_create(&Runner::runner_id, nullptr, &Runner::_runner, nullptr) != 0) {
+	if (not Runner::start()) {
 		Global::exit_error_msg = "Failed to create _runner thread!";
 		clean_quit(1);
 	}
@@ -1161,7 +1307,7 @@ int main(int argc, char **argv) {
 	Draw::calcSizes();
 
 	//? Print out box outlines
-	cout << Term::sync_start << Cpu::box << Mem::box << Net::box << Proc::box << Term::sync_end << flush;
+	Screen::write(Cpu::box + Mem::box + Net::box + Proc::box, g_CfgMgr.get<CfgB>("diff_output").v());
 
 
 	//? ------------------------------------------------ MAIN LOOP ----------------------------------------------------
@@ -1170,6 +1316,7 @@ int main(int argc, char **argv) {
 		Config::set("update_ms", Global::arg_update);
 	}
 	uint64_t update_ms = g_CfgMgr.get<CfgI>("update_ms").v();
+	Adaptive::interval = update_ms;
 	auto future_time = time_ms();
 
 	try {
@@ -1207,7 +1354,7 @@ int main(int argc, char **argv) {
 				Global::resized = false;
 				if (Menu::active) Menu::process();
 				else Runner::run("all", true, true);
-				atomic_wait_for(Runner::active, true, 1000);
+				Runner::wait_idle(1000);
 			}
 
 			//? Update clock if needed
@@ -1217,32 +1364,43 @@ int main(int argc, char **argv) {
 
 			//? Start secondary collect & draw thread at the interval set by <update_ms> config value
 			if (time_ms() >= future_time and not Global::resized) {
+				Runner::tick_jitter(time_micros() - future_time * 1000);
 				Runner::run("all");
 				update_ms = g_CfgMgr.get<CfgI>("update_ms").v();
-				future_time = time_ms() + update_ms;
+
+				//? Schedule against the previous deadline so intervals don't drift, resync if ticks were missed
+				const uint64_t interval = Adaptive::next(update_ms);
+				future_time += interval;
+				if (future_time <= time_ms()) future_time = time_ms() + interval;
 			}
 
 			//? Loop over input polling and input action processing
 			for (auto current_time = time_ms(); current_time < future_time; current_time = time_ms()) {
+				Adaptive::wakeup();
 
 				//? Check for external clock changes and for changes to the update timer
             auto tmp = g_CfgMgr.get<CfgI>("update_ms").v();
 				if (std::cmp_not_equal(update_ms, tmp)) {
 					update_ms = tmp;
+					Adaptive::interval = update_ms;
 					future_time = time_ms() + update_ms;
 				}
-				else if (future_time - current_time > update_ms) {
+				else if (future_time - current_time > Adaptive::interval) {
 					future_time = current_time;
 				}
-				//? Poll for input and process any input detected
-				else if (Input::poll(min((uint64_t)1000, future_time - current_time))) {
+				//? Poll for input and process any input detected, a stretched interval also sleeps past the 1000ms checks
+				//? unless the clock needs updating before the next collection
+				else if (Input::poll(min((Adaptive::interval > update_ms ? Draw::clock_wait() : (uint64_t)1000), future_time - current_time))) {
 					if (not Runner::active) Config::unlock();
 
+					//? Snap back to update_ms if the interval was stretched while idle
+					if (Adaptive::input()) future_time = min(future_time, time_ms() + update_ms);
+
 					if (Menu::active) Menu::process(Input::get());
 					else Input::process(Input::get());
 				}
 
-				//? Break the loop at 1000ms intervals or if input polling was interrupted
+				//? Break the loop when polling timed out or was interrupted
 				else break;
 
 			}
@@ -1253,5 +1411,5 @@ int main(int argc, char **argv) {
 		Global::exit_error_msg = "Exception in main loop -> " + string{e.what()};
 		clean_quit(1);
 	}
-
+	return 0;
 }
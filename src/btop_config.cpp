@@ -209,6 +209,17 @@ namespace Config {
 
 		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
 
+		{"adaptive_update",		"#* Stretch the update time up to \"adaptive_update_max\" while cpu, disk and network activity is low and no keys are pressed.\n"
+								"#* Snaps back to \"update_ms\" on input or when activity picks up. Effective update time is shown in the cpu box."},
+
+		{"adaptive_update_max",	"#* Max update time in milliseconds when \"adaptive_update\" is enabled."},
+
+		{"pause_unfocused",		"#* Only collect data while the terminal is unfocused, graphs keep their history and are redrawn on focus.\n"
+								"#* Needs a terminal with focus reporting, for tmux set \"focus-events on\"."},
+
+		{"diff_output",			"#* Only write the screen cells that changed since the last frame, lowers the amount of data sent to the terminal.\n"
+								"#* Disable if parts of the screen aren't updated, can happen with fonts that draw some glyphs wider than standard."},
+
 		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
 								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
 
@@ -267,6 +278,20 @@ namespace Config {
 
 		{"show_cpu_freq", 		"#* Show CPU frequency."},
 
+		{"cpu_core_freq", 		"#* Collect the frequency of every core, colors the core labels and the cells of the \"heatmap\" core view in the\n"
+								"#* cpu box from lowest to highest frequency and shows min, avg and max frequency over the cores on the bottom of the box."},
+
+		{"cpu_pmu", 			"#* (Linux) Count cycles, instructions, cache and branch misses on every core with perf_event_open and show instructions\n"
+								"#* per cycle next to each core, colored by cache miss ratio. Falls back to context switches per second from software\n"
+								"#* counters when the cpu has no usable PMU. Needs CAP_PERFMON or kernel.perf_event_paranoid set to 0 or lower."},
+
+		{"cpu_sched_stats", 	"#* Show context switches and forks per second and the runnable and blocked tasks below the load average in the cpu box,\n"
+								"#* with the average and worst per core run queue wait when the kernel has /proc/schedstat (CONFIG_SCHEDSTATS)."},
+
+		{"cpu_core_view", 		"#* What the core area of the cpu box shows, available values: \"cores\", \"socket\", \"node\", \"llc\" and \"heatmap\".\n"
+								"#* \"socket\", \"node\" and \"llc\" show one row per socket, NUMA node or last level cache with the average of its cores,\n"
+								"#* \"heatmap\" shows one cell per core. Cycle with \"v\" and drill into a group with \"[\" and \"]\"."},
+
 		{"clock_format", 		"#* Draw a clock at top of screen, formatting according to strftime, empty string to disable.\n"
 								"#* Special formatting: /host = hostname | /user = username | /uptime = system uptime"},
 
@@ -287,6 +312,11 @@ namespace Config {
 
 		{"swap_disk", 			"#* Show swap as a disk, ignores show_swap value above, inserts itself after first disk."},
 
+		{"show_pressure", 		"#* (Linux) Show memory and io pressure stall information in the mem box, \"pressure\" can also be picked as a cpu graph."},
+
+		{"pressure_high_res", 	"#* (Linux) Compute pressure from the stall time counters between updates instead of the kernel's 10 second average,\n"
+								"#* follows changes that are shorter than a second with a low update_ms."},
+
 		{"show_disks", 			"#* If mem box should be split to also show disks info."},
 
 		{"only_physical", 		"#* Filter out non physical disks. Set this to False to include network disks, RAM disks and similar."},
@@ -354,6 +384,7 @@ namespace Config {
 		{"cpu_graph_upper", "Auto"},
 		{"cpu_graph_lower", "Auto"},
 		{"cpu_sensor", "Auto"},
+		{"cpu_core_view", "cores"},
 		{"selected_battery", "Auto"},
 		{"cpu_core_map", ""},
 		{"temp_scale", "celsius"},
@@ -399,12 +430,20 @@ namespace Config {
 		{"check_temp", true},
 		{"show_coretemp", true},
 		{"show_cpu_freq", true},
+		{"cpu_core_freq", false},
+		{"cpu_pmu", false},
+		{"cpu_sched_stats", false},
 		{"background_update", true},
+		{"adaptive_update", false},
+		{"pause_unfocused", true},
+		{"diff_output", true},
 		{"mem_graphs", true},
 		{"mem_below_net", false},
 		{"zfs_arc_cached", true},
 		{"show_swap", true},
 		{"swap_disk", true},
+		{"show_pressure", true},
+		{"pressure_high_res", false},
 		{"show_disks", true},
 		{"only_physical", true},
 		{"use_fstab", true},
@@ -435,6 +474,7 @@ namespace Config {
 
 	std::unordered_map<std::string_view, int> ints = {
 		{"update_ms", 2000},
+		{"adaptive_update_max", 10000},
 		{"net_download", 100},
 		{"net_upload", 100},
 		{"detailed_pid", 0},
@@ -620,6 +660,12 @@ namespace Config {
 		else if (name == "update_ms" and i_value > ONE_DAY_MILLIS)
 			validError = fmt::format("Config value update_ms set too high (>{}).", ONE_DAY_MILLIS);
 
+		else if (name == "adaptive_update_max" and i_value < 100)
+			validError = "Config value adaptive_update_max set too low (<100).";
+
+		else if (name == "adaptive_update_max" and i_value > ONE_DAY_MILLIS)
+			validError = fmt::format("Config value adaptive_update_max set too high (>{}).", ONE_DAY_MILLIS);
+
 		else
 			return true;
 
@@ -652,6 +698,9 @@ namespace Config {
 				return true;
 		}
 
+		else if (name == "cpu_core_view" and not v_contains(cpu_core_views, value))
+			validError = "Invalid cpu_core_view: " + value;
+
 	#ifdef GPU_SUPPORT
 		else if (name == "show_gpu_info" and not v_contains(show_gpu_values, value))
 			validError = "Invalid value for show_gpu_info: " + value;
@@ -132,6 +132,7 @@ private:
       {"cpu_graph_upper",     {CString, "Auto"}},
       {"cpu_graph_lower",     {CString, "Auto"}},
       {"cpu_sensor",          {CString, "Auto"}},
+      {"cpu_core_view",       {CString, "cores"}},
       {"selected_battery",    {CString, "Auto"}},
       {"cpu_core_map",        {CString, ""}},
       {"temp_scale",          {CString, "celsius"}},
@@ -173,12 +174,20 @@ private:
       {"check_temp",          {CBool, true}},
       {"show_coretemp",       {CBool, true}},
       {"show_cpu_freq",       {CBool, true}},
+      {"cpu_core_freq",       {CBool, false}},
+      {"cpu_pmu",             {CBool, false}},
+      {"cpu_sched_stats",     {CBool, false}},
       {"background_update",   {CBool, true}},
+      {"adaptive_update",     {CBool, false}},
+      {"pause_unfocused",     {CBool, true}},
+      {"diff_output",         {CBool, true}},
       {"mem_graphs",          {CBool, true}},
       {"mem_below_net",       {CBool, false}},
       {"zfs_arc_cached",      {CBool, true}},
       {"show_swap",           {CBool, true}},
       {"swap_disk",           {CBool, true}},
+      {"show_pressure",       {CBool, true}},
+      {"pressure_high_res",   {CBool, false}},
       {"show_disks",          {CBool, true}},
       {"only_physical",       {CBool, true}},
       {"use_fstab",           {CBool, true}},
@@ -205,6 +214,7 @@ private:
       {"gpu_mirror_graph",          {CBool, true}},
 #endif
       {"update_ms",           {CInt, 2000}},
+      {"adaptive_update_max", {CInt, 10000}},
       {"net_download",        {CInt, 100}},
       {"net_upload",          {CInt, 100}},
       {"detailed_pid",        {CInt, 0}},
@@ -219,9 +229,15 @@ private:
       string_store.add_validator("graph_symbol", [this](const std::string& val) {
          return std::ranges::find(valid_graph_symbols, val) != valid_graph_symbols.end();
       });
+      string_store.add_validator("cpu_core_view", [this](const std::string& val) {
+         return std::ranges::find(cpu_core_views, val) != cpu_core_views.end();
+      });
       int_store.add_validator("update_ms", [this](const int val) {
          return val >= 100 && val <= 2000;
       });
+      int_store.add_validator("adaptive_update_max", [this](const int val) {
+         return val >= 100 && val <= ONE_DAY_MILLIS;
+      });
    }
 
    DynResult<bool> try_parse_bool(const std::string& val) {
@@ -284,6 +300,9 @@ private:
    const std::vector<std::string> temp_scales{
       "celsius", "fahrenheit", "kelvin", "rankine"
    };
+   const std::vector<std::string> cpu_core_views{
+      "cores", "socket", "node", "llc", "heatmap"
+   };
 #ifdef GPU_SUPPORT
    const std::vector<std::string> show_gpu_values{
       "Auto", "On", "Off"
@@ -374,6 +393,7 @@ namespace Config {
 #endif
 		};
 	const vector<string> temp_scales = { "celsius", "fahrenheit", "kelvin", "rankine" };
+	const vector<string> cpu_core_views = { "cores", "socket", "node", "llc", "heatmap" };
 #ifdef GPU_SUPPORT
 	const vector<string> show_gpu_values = { "Auto", "On", "Off" };
 #endif
@@ -18,7 +18,11 @@ tab-size = 4
 
 #include <array>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <ranges>
 #include <stdexcept>
 #include <string>
@@ -31,6 +35,13 @@ tab-size = 4
 #include "btop_tools.hpp"
 #include "btop_input.hpp"
 #include "btop_menu.hpp"
+#include "fmt/compile.h"
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#elif defined(__aarch64__)
+	#include <arm_neon.h>
+#endif
 
 
 using std::array;
@@ -45,6 +56,8 @@ using std::min;
 using std::round;
 using std::to_string;
 using std::views::iota;
+using Theme::Color;
+using Theme::Gradient;
 
 using namespace Tools;
 using namespace std::literals; // for operator""s
@@ -156,7 +169,7 @@ namespace Draw {
 				if (++z < Global::Banner_src.size()) banner += Mv::l(ulen(line[1])) + Mv::d(1);
 			}
 			banner += Mv::r(18 - Global::Version.size())
-					+ Theme::c("main_fg") + Fx::b + Fx::i + "v" + Global::Version + Fx::reset;
+					+ Theme::c(Color::main_fg) + Fx::b + Fx::i + "v" + Global::Version + Fx::reset;
 		}
 		if (redraw) return "";
 		return (centered ? Mv::to(y, Term::width / 2 - width / 2) : Mv::to(y, x)) + banner;
@@ -268,11 +281,11 @@ namespace Draw {
 		string out;
 
 		if (line_color.empty())
-			line_color = Theme::c("div_line");
+			line_color = Theme::c(Color::div_line);
 
 		auto tty_mode = Config::getB("tty_mode");
 		auto rounded = Config::getB("rounded_corners");
-		const string numbering = (num == 0) ? "" : Theme::c("hi_fg") + (tty_mode ? std::to_string(num) : Symbols::superscript.at(clamp(num, 0, 9)));
+		const string numbering = (num == 0) ? "" : Theme::c(Color::hi_fg) + (tty_mode ? std::to_string(num) : Symbols::superscript.at(clamp(num, 0, 9)));
 		const auto& right_up = (tty_mode or not rounded ? Symbols::right_up : Symbols::round_right_up);
 		const auto& left_up = (tty_mode or not rounded ? Symbols::left_up : Symbols::round_left_up);
 		const auto& right_down = (tty_mode or not rounded ? Symbols::right_down : Symbols::round_right_down);
@@ -300,11 +313,11 @@ namespace Draw {
 
 		//? Draw titles if defined
 		if (not title.empty()) {
-			out += Mv::to(y, x + 2) + Symbols::title_left + Fx::b + numbering + Theme::c("title") + title
+			out += Mv::to(y, x + 2) + Symbols::title_left + Fx::b + numbering + Theme::c(Color::title) + title
 				+  Fx::ub + line_color + Symbols::title_right;
 		}
 		if (not title2.empty()) {
-			out += Mv::to(y + height - 1, x + 2) + Symbols::title_left_down + Fx::b + numbering + Theme::c("title") + title2
+			out += Mv::to(y + height - 1, x + 2) + Symbols::title_left_down + Fx::b + numbering + Theme::c(Color::title) + title2
 				+  Fx::ub + line_color + Symbols::title_right_down;
 		}
 
@@ -365,20 +378,31 @@ namespace Draw {
 
 		if (clock_str.size() != clock_len) {
 			if (not Global::resized and clock_len > 0)
-				out = Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * clock_len;
+				out = Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c(Color::cpu_box) + Symbols::h_line * clock_len;
 			clock_len = clock_str.size();
 		}
 
-		out += Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c("cpu_box") + title_left
-			+ Theme::c("title") + Fx::b + clock_str + Theme::c("cpu_box") + Fx::ub + title_right;
+		out += Mv::to(y, x+(width / 2)-(clock_len / 2)) + Fx::ub + Theme::c(Color::cpu_box) + title_left
+			+ Theme::c(Color::title) + Fx::b + clock_str + Theme::c(Color::cpu_box) + Fx::ub + title_right;
 
 		return true;
 	}
 
+	uint64_t clock_wait() {
+		const auto& clock_format = Config::getS("clock_format");
+		if (not Cpu::shown or clock_format.empty()) return std::numeric_limits<uint64_t>::max();
+		//? The clock shows wall clock time, time_ms() is steady and its second and minute boundaries don't line up with it
+		const uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		for (const auto& spec : {"%S", "%T", "%X", "%r", "%c", "%s", "%+", "/uptime"}) {
+			if (s_contains(clock_format, spec)) return 1000 - now % 1000;
+		}
+		return 60000 - now % 60000;
+	}
+
 	//* Meter class ------------------------------------------------------------------------------------------------------------>
 	Meter::Meter() {}
 
-	Meter::Meter(const int width, const string& color_gradient, bool invert)
+	Meter::Meter(const int width, Gradient color_gradient, bool invert)
 		: width(width), color_gradient(color_gradient), invert(invert) {}
 
 	string Meter::operator()(int value) {
@@ -386,12 +410,14 @@ namespace Draw {
 		value = clamp(value, 0, 100);
 		if (not cache.at(value).empty()) return cache.at(value);
 		auto& out = cache.at(value);
+		//? Meters without a gradient are drawn in the main foreground color
+		const auto* gradient = (color_gradient == Gradient::none ? nullptr : &Theme::g(color_gradient));
 		for (const int& i : iota(1, width + 1)) {
 			int y = round((double)i * 100.0 / width);
 			if (value >= y)
-				out += Theme::g(color_gradient).at(invert ? 100 - y : y) + Symbols::meter;
+				out += (gradient != nullptr ? gradient->at(invert ? 100 - y : y) : Theme::c(Color::main_fg)) + Symbols::meter;
 			else {
-				out += Theme::c("meter_bg") + Symbols::meter * (width + 1 - i);
+				out += Theme::c(Color::meter_bg) + Symbols::meter * (width + 1 - i);
 				break;
 			}
 		}
@@ -400,79 +426,162 @@ namespace Draw {
 	}
 
 	//* Graph class ------------------------------------------------------------------------------------------------------------>
-	void Graph::_create(const deque<long long>& data, int data_offset) {
-		bool mult = (data.size() - data_offset > 1);
-		const auto& graph_symbol = Symbols::graph_symbols.at(symbol + '_' + (invert ? "down" : "up"));
-		array<int, 2> result;
+	uint8_t graph_level(int value, int low, int high, float mod) {
+		if (value >= high) return 4;
+		if (value <= low) return 0;
+		return clamp((int)round((float)(value - low) * 4 / (high - low) + mod), 0, 4);
+	}
+
+	void graph_levels(const int32_t* values, size_t count, int low, int high, float mod, uint8_t* out) {
+		size_t i = 0;
+	#if defined(__SSE2__)
+		const __m128i lo = _mm_set1_epi32(low), hi = _mm_set1_epi32(high - 1), four_i = _mm_set1_epi32(4);
+		const __m128 span = _mm_set1_ps((float)(high - low)), four = _mm_set1_ps(4.0f), md = _mm_set1_ps(mod), half = _mm_set1_ps(0.5f);
+		auto level_4 = [&](const int32_t* v_ptr) {
+			const __m128i v = _mm_loadu_si128((const __m128i*)v_ptr);
+			const __m128 f = _mm_add_ps(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(v, lo)), four), span), md);
+			//? Same as round() for the positive lanes that are kept, truncate and add one if the fraction is at least a half
+			const __m128i t = _mm_cvttps_epi32(f);
+			__m128i r = _mm_sub_epi32(t, _mm_castps_si128(_mm_cmpge_ps(_mm_sub_ps(f, _mm_cvtepi32_ps(t)), half)));
+			r = _mm_and_si128(r, _mm_cmpgt_epi32(v, lo));
+			const __m128i above = _mm_cmpgt_epi32(v, hi);
+			return _mm_or_si128(_mm_andnot_si128(above, r), _mm_and_si128(above, four_i));
+		};
+		for (; i + 8 <= count; i += 8) {
+			const __m128i r = _mm_max_epi16(_mm_min_epi16(_mm_packs_epi32(level_4(values + i), level_4(values + i + 4)), _mm_set1_epi16(4)), _mm_setzero_si128());
+			_mm_storel_epi64((__m128i*)(out + i), _mm_packus_epi16(r, r));
+		}
+	#elif defined(__aarch64__)
+		const int32x4_t lo = vdupq_n_s32(low), hi = vdupq_n_s32(high), four_i = vdupq_n_s32(4);
+		const float32x4_t span = vdupq_n_f32((float)(high - low)), md = vdupq_n_f32(mod);
+		auto level_4 = [&](const int32_t* v_ptr) {
+			const int32x4_t v = vld1q_s32(v_ptr);
+			//? vcvtaq rounds to nearest with ties away from zero, same as round()
+			const int32x4_t r = vcvtaq_s32_f32(vaddq_f32(vdivq_f32(vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(v, lo)), 4.0f), span), md));
+			return vbslq_s32(vcgeq_s32(v, hi), four_i, vandq_s32(r, vreinterpretq_s32_u32(vcgtq_s32(v, lo))));
+		};
+		for (; i + 8 <= count; i += 8) {
+			const int16x8_t r = vcombine_s16(vmovn_s32(level_4(values + i)), vmovn_s32(level_4(values + i + 4)));
+			vst1_u8(out + i, vqmovun_s16(vmaxq_s16(vminq_s16(r, vdupq_n_s16(4)), vdupq_n_s16(0))));
+		}
+	#endif
+		for (; i < count; i++) out[i] = graph_level(values[i], low, high, mod);
+	}
+
+	void Graph::_create(int data_size, int data_offset) {
+		const bool mult = (data_size - data_offset > 1);
+		const int cols = data_size - data_offset;
+		const auto* gradient = (height == 1 and color_gradient != Gradient::none ? &Theme::g(color_gradient) : nullptr);
 		const float mod = (height == 1) ? 0.3 : 0.1;
 		long long data_value = 0;
 		if (mult and data_offset > 0) {
-			last = data.at(data_offset - 1);
+			last = input.at(data_offset - 1 - input_start);
 			if (max_value > 0) last = clamp((last + offset) * 100 / max_value, 0ll, 100ll);
 		}
 
-		//? Horizontal iteration over values in <data>
-		for (const int& i : iota(data_offset, (int)data.size())) {
-			// if (tty_mode and mult and i % 2 != 0) continue;
-			if (not tty_mode and mult) current = not current;
-			if (i < 0) {
+		//? Values clamped to 0-100 for the level kernel, values[0] is the left half of the first new cell
+		values.resize(cols + 1);
+		values[0] = (data_offset < 0 ? 0 : clamp(last, 0ll, 100ll));
+		for (const int& i : iota(data_offset, data_size)) {
+			if (i < 0)
 				data_value = 0;
-				last = 0;
-			}
 			else {
-				data_value = data.at(i);
+				data_value = input.at(i - input_start);
 				if (max_value > 0) data_value = clamp((data_value + offset) * 100 / max_value, 0ll, 100ll);
 			}
+			values[i - data_offset + 1] = clamp(data_value, 0ll, 100ll);
+		}
+		last = data_value;
+
+		//? Levels of all values for each row, two neighbouring values are represented in each braille character
+		levels.resize(height * (cols + 1));
+		for (const int& horizon : iota(0, height)) {
+			const int cur_high = (height > 1) ? round(100.0 * (height - horizon) / height) : 100;
+			const int cur_low = (height > 1) ? round(100.0 * (height - (horizon + 1)) / height) : 0;
+			graph_levels(values.data(), cols + 1, cur_low, cur_high, mod, &levels[horizon * (cols + 1)]);
+		}
+
+		//? Horizontal iteration over new cells
+		for (const int& col : iota(0, cols)) {
+			if (not tty_mode and mult) current = not current;
+
+			//? The oldest cell at head is replaced and head moves on to the next oldest
+			int& pos = head[current];
 
 			//? Vertical iteration over height of graph
 			for (const int& horizon : iota(0, height)) {
-				const int cur_high = (height > 1) ? round(100.0 * (height - horizon) / height) : 100;
-				const int cur_low = (height > 1) ? round(100.0 * (height - (horizon + 1)) / height) : 0;
-				//? Calculate previous + current value to fit two values in 1 braille character
-				for (int ai = 0; const auto& value : {last, data_value}) {
-					const int clamp_min = (no_zero and horizon == height - 1 and not (mult and i == data_offset and ai == 0)) ? 1 : 0;
-					if (value >= cur_high)
-						result[ai++] = 4;
-					else if (value <= cur_low)
-						result[ai++] = clamp_min;
-					else {
-						result[ai++] = clamp((int)round((float)(value - cur_low) * 4 / (cur_high - cur_low) + mod), clamp_min, 4);
-					}
+				const uint8_t* level = &levels[horizon * (cols + 1) + col];
+				int left = level[0], right = level[1];
+				if (no_zero and horizon == height - 1) {
+					right = max(right, 1);
+					if (not (mult and col == 0)) left = max(left, 1);
 				}
+
+				//? Drop the bytes of the replaced cell from the front of the row and append the new cell,
+				//? the dead prefix is only compacted once it's as large as the live part
+				auto& row = rows[current][horizon];
+				auto& row_start = row_offset[current][horizon];
+				auto& cell_size = sizes[current][horizon * width + pos];
+				row_start += cell_size;
+				const size_t row_end = row.size();
+
 				//? Generate graph symbol from 5x5 2D vector
-				if (height == 1) {
-					if (result.at(0) + result.at(1) == 0) graphs.at(current).at(horizon) += Mv::r(1);
-					else {
-						if (not color_gradient.empty()) graphs.at(current).at(horizon) += Theme::g(color_gradient).at(clamp(max(last, data_value), 0ll, 100ll));
-						graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
-					}
+				const int glyph = left * 5 + right;
+				if (height == 1 and glyph == 0) row += Mv::r(1);
+				else {
+					if (gradient != nullptr) row += (*gradient)[max(values[col], values[col + 1])];
+					row.append(glyphs->bytes[glyph].data(), glyphs->len[glyph]);
+				}
+				cell_size = row.size() - row_end;
+
+				if (row_start * 2 >= row.size()) {
+					row.erase(0, row_start);
+					row_start = 0;
 				}
-				else graphs.at(current).at(horizon) += graph_symbol.at((result.at(0) * 5 + result.at(1)));
 			}
-			if (mult and i >= 0) last = data_value;
+			pos = (pos + 1) % width;
 		}
-		last = data_value;
+		dirty = true;
+	}
+
+	void Graph::_serialize() {
+		dirty = false;
 		out.clear();
 		if (height == 1) {
-			//if (not color_gradient.empty())
-			//	out += (last < 1 ? Theme::c("inactive_fg") : Theme::g(color_gradient).at(clamp(last, 0ll, 100ll)));
-			out += graphs.at(current).at(0);
+			out.append(rows[current][0], row_offset[current][0]);
 		}
 		else {
+			const auto* gradient = (color_gradient == Gradient::none ? nullptr : &Theme::g(color_gradient));
 			for (const int& i : iota(1, height + 1)) {
 				if (i > 1) out += Mv::d(1) + Mv::l(width);
-				if (not color_gradient.empty())
-					out += (invert) ? Theme::g(color_gradient).at(i * 100 / height) : Theme::g(color_gradient).at(100 - ((i - 1) * 100 / height));
-				out += (invert) ? graphs.at(current).at(height - i) : graphs.at(current).at(i-1);
+				if (gradient != nullptr)
+					out += (invert) ? gradient->at(i * 100 / height) : gradient->at(100 - ((i - 1) * 100 / height));
+				const int row = (invert) ? height - i : i - 1;
+				out.append(rows[current][row], row_offset[current][row]);
 			}
 		}
-		if (not color_gradient.empty()) out += Fx::reset;
+		if (color_gradient != Gradient::none) out += Fx::reset;
+	}
+
+	const Graph::Glyphs& Graph::_glyphs(const string& name) {
+		static const auto tables = [] {
+			std::unordered_map<string, Glyphs> packed;
+			for (const auto& [key, symbols] : Symbols::graph_symbols) {
+				Glyphs& table = packed[key];
+				for (size_t i = 0; i < table.bytes.size(); i++) {
+					table.bytes[i] = {};
+					table.len[i] = std::min(symbols.at(i).size(), table.bytes[i].size());
+					std::memcpy(table.bytes[i].data(), symbols.at(i).data(), table.len[i]);
+				}
+			}
+			return packed;
+		}();
+		return tables.at(name);
 	}
 
 	Graph::Graph() {}
 
-	Graph::Graph(int width, int height, const string& color_gradient,
-				 const deque<long long>& data, const string& symbol,
+	Graph::Graph(int width, int height, Gradient color_gradient, const string& symbol,
 				 bool invert, bool no_zero, long long max_value, long long offset)
 	: width(width), height(height), color_gradient(color_gradient),
 	  invert(invert), no_zero(no_zero), offset(offset) {
@@ -480,43 +589,50 @@ namespace Draw {
 		else if (symbol != "default") this->symbol = symbol;
 		else this->symbol = Config::getS("graph_symbol");
 		if (this->symbol == "tty") tty_mode = true;
+		glyphs = &_glyphs(this->symbol + '_' + (invert ? "down" : "up"));
 
 		if (max_value == 0 and offset > 0) max_value = 100;
 		this->max_value = max_value;
-		const int value_width = (tty_mode ? data.size() : ceil((double)data.size() / 2));
-		int data_offset = (value_width > width) ? data.size() - width * (tty_mode ? 1 : 2) : 0;
-
-		if (not tty_mode and (data.size() - data_offset) % 2 != 0) {
-			data_offset--;
+		if (this->width <= 0 or this->height <= 0) {
+			this->width = this->height = 0;
+			return;
 		}
 
-		//? Populate the two switching graph vectors and fill empty space if data size < width
-		for (const int& i : iota(0, height * 2)) {
-			if (tty_mode and i % 2 != current) continue;
-			graphs[(i % 2 != 0)].push_back((value_width < width) ? ((height == 1) ? Mv::r(1) : " "s) * (width - value_width) : "");
+		//? Start with both representations empty, new cells push the empty ones out from the left
+		const string empty = (height == 1 ? Mv::r(1) : string(glyphs->bytes[0].data(), glyphs->len[0]));
+		for (int rep : {0, 1}) {
+			rows[rep].assign(height, empty * width);
+			row_offset[rep].assign(height, 0);
+			sizes[rep].assign(width * height, empty.size());
 		}
-		if (data.size() == 0) return;
-		this->_create(data, data_offset);
 	}
 
-	string& Graph::operator()(const deque<long long>& data, bool data_same) {
-		if (data_same) return out;
+	int Graph::_data_offset(int data_size) const {
+		const int value_width = (tty_mode ? data_size : ceil((double)data_size / 2));
+		int data_offset = (value_width > width) ? data_size - width * (tty_mode ? 1 : 2) : 0;
 
-		//? Make room for new characters on graph
-		if (not tty_mode) current = not current;
-		for (const int& i : iota(0, height)) {
-			if (height == 1 and graphs.at(current).at(i).at(1) == '[') {
-				if (graphs.at(current).at(i).at(3) == 'C') graphs.at(current).at(i).erase(0, 4);
-				else graphs.at(current).at(i).erase(0, graphs.at(current).at(i).find_first_of('m') + 4);
-			}
-			else if (graphs.at(current).at(i).at(0) == ' ') graphs.at(current).at(i).erase(0, 1);
-			else graphs.at(current).at(i).erase(0, 3);
+		if (not tty_mode and (data_size - data_offset) % 2 != 0) {
+			data_offset--;
 		}
-		this->_create(data, (int)data.size() - 1);
-		return out;
+		return data_offset;
+	}
+
+	string& Graph::_update(int data_size) {
+		//? Switch representation, _create replaces its oldest cell
+		if (not tty_mode) current = not current;
+		this->_create(data_size, data_size - 1);
+		return (*this)();
+	}
+
+	string& Graph::operator()(long long value, bool data_same) {
+		if (data_same or width == 0) return (*this)();
+		input.assign(1, value);
+		input_start = 0;
+		return _update(1);
 	}
 
 	string& Graph::operator()() {
+		if (dirty) _serialize();
 		return out;
 	}
 	//*------------------------------------------------------------------------------------------------------------------------->
@@ -543,6 +659,26 @@ namespace Cpu {
 	vector<Draw::Graph> temp_graphs;
 	vector<Draw::Graph> gpu_temp_graphs;
 	vector<Draw::Graph> gpu_mem_graphs;
+	vector<Draw::Graph> group_graphs;
+	vector<Draw::Graph> group_temp_graphs;
+	EnumArray<Level, vector<int>, level_names> group_sizes;
+	int drill_group = -1;
+	bool has_counters = false;
+
+	//* Layouts of the core area
+	enum class CoreView { cores, grouped, heatmap };
+
+	//* Layout for the cpu_core_view value <view>, the grouped views show cores until the collector has read the topology
+	CoreView get_core_view(const string& view) {
+		if (view == "heatmap") return CoreView::heatmap;
+		if (decltype(group_sizes)::contains(view) and not group_sizes.at(view).empty()) return CoreView::grouped;
+		return CoreView::cores;
+	}
+
+	//* <value> in at most 4 characters, shortened with a k or M suffix
+	string short_count(long long value) {
+		return (value < 10'000 ? to_string(value) : value < 1'000'000 ? to_string(value / 1000) + 'k' : to_string(value / 1'000'000) + 'M');
+	}
 
     string draw(const cpu_info& cpu, const vector<Gpu::gpu_info>& gpus, bool force_redraw, bool data_same) {
 		if (Runner::stopping) return "";
@@ -551,6 +687,12 @@ namespace Cpu {
 		auto single_graph = Config::getB("cpu_single_graph");
 		bool hide_cores = show_temps and (cpu_temp_only or not Config::getB("show_coretemp"));
 		const int extra_width = (hide_cores ? max(6, 6 * b_column_size) : 0);
+		const bool core_freq = (g_CfgMgr.get<CfgB>("cpu_core_freq").v() and not cpu.core_freq.empty() and cpu.freq_top > 0);
+		const int sched_line = g_CfgMgr.get<CfgB>("cpu_sched_stats").v();
+		const string core_view = g_CfgMgr.get<CfgS>("cpu_core_view").v();
+		auto cpu_view = get_core_view(core_view);
+		if (cpu_view == CoreView::grouped and (cpu.groups.at(core_view).empty() or cpu.groups.at(core_view).front().percent.empty()))
+			cpu_view = CoreView::cores;
 	#ifdef GPU_SUPPORT
 		const auto& show_gpu_info = Config::getS("show_gpu_info");
 		const bool gpu_always = show_gpu_info == "On";
@@ -570,19 +712,23 @@ namespace Cpu {
 			graph_lo_field = graph_up_field;
 		#endif
 		}
+		//? "pressure" graphs the share of time tasks were stalled waiting for cpu, the other fields are cpu time fields
+		auto cpu_history = [&](const string& field) -> const PercentHistory& {
+			return (field == "pressure" ? cpu.pressure.some.percent : cpu.cpu_percent.at(field));
+		};
 		auto tty_mode = Config::getB("tty_mode");
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_cpu"));
 		auto& graph_bg = Symbols::graph_symbols.at((graph_symbol == "default" ? Config::getS("graph_symbol") + "_up" : graph_symbol + "_up")).at(6);
 		auto& temp_scale = Config::getS("temp_scale");
 		auto cpu_bottom = Config::getB("cpu_bottom");
 
-		const string& title_left = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
-		const string& title_right = Theme::c("cpu_box") + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
+		const string& title_left = Theme::c(Color::cpu_box) + (cpu_bottom ? Symbols::title_left_down : Symbols::title_left);
+		const string& title_right = Theme::c(Color::cpu_box) + (cpu_bottom ? Symbols::title_right_down : Symbols::title_right);
 		static int bat_pos = 0, bat_len = 0;
-		if (safeVal(cpu.cpu_percent, "total"s).empty()
+		if (cpu.cpu_percent[Cpu::Field::total].empty()
 			or safeVal(cpu.core_percent, 0).empty()
 			or (show_temps and safeVal(cpu.temp, 0).empty())) return "";
-		if (safeVal(cpu.cpu_percent, "total"s).empty()
+		if (cpu.cpu_percent[Cpu::Field::total].empty()
 			or safeVal(cpu.core_percent, 0).empty()
 			or (show_temps and safeVal(cpu.temp, 0).empty())) return "";
 		string out;
@@ -598,17 +744,11 @@ namespace Cpu {
 			out += box;
 
 			//? Buttons on title
-			out += Mv::to(button_y, x + 10) + title_left + Theme::c("hi_fg") + Fx::b + 'm' + Theme::c("title") + "enu" + Fx::ub + title_right;
+			out += Mv::to(button_y, x + 10) + title_left + Theme::c(Color::hi_fg) + Fx::b + 'm' + Theme::c(Color::title) + "enu" + Fx::ub + title_right;
 			Input::mouse_mappings["m"] = {button_y, x + 11, 1, 4};
-			out += Mv::to(button_y, x + 16) + title_left + Theme::c("hi_fg") + Fx::b + 'p' + Theme::c("title") + "reset "
+			out += Mv::to(button_y, x + 16) + title_left + Theme::c(Color::hi_fg) + Fx::b + 'p' + Theme::c(Color::title) + "reset "
 				+ (Config::current_preset < 0 ? "*" : to_string(Config::current_preset)) + Fx::ub + title_right;
 			Input::mouse_mappings["p"] = {button_y, x + 17, 1, 8};
-			const string update = to_string(g_CfgMgr.get<CfgI>("update_ms").v()) + "ms";
-			out += Mv::to(button_y, x + width - update.size() - 8) + title_left + Fx::b + Theme::c("hi_fg") + "- " + Theme::c("title") + update
-				+ Theme::c("hi_fg") + " +" + Fx::ub + title_right;
-			Input::mouse_mappings["-"] = {button_y, x + width - (int)update.size() - 7, 1, 2};
-			Input::mouse_mappings["+"] = {button_y, x + width - 5, 1, 2};
-
 			//? Graphs & meters
 			const int graph_default_width = x + width - b_width - 3;
 
@@ -630,12 +770,12 @@ namespace Cpu {
 							//? GPU graphs
 							if (gpu.supported_functions.gpu_utilization) {
 								if (i + 1 < gpus.size()) {
-									graph = Draw::Graph{graph_width, graph_height, "cpu", safeVal(gpu.gpu_percent, graph_field), graph_symbol, invert, true};
+									graph = Draw::Graph{graph_width, graph_height, Gradient::cpu, safeVal(gpu.gpu_percent, graph_field), graph_symbol, invert, true};
 								}
 								else {
 									graph = Draw::Graph{
 										graph_width + graph_default_width%graph_width - (int)gpus.size() + 1,
-										graph_height, "cpu", safeVal(gpu.gpu_percent, graph_field), graph_symbol, invert, true
+										graph_height, Gradient::cpu, safeVal(gpu.gpu_percent, graph_field), graph_symbol, invert, true
 									};
 								}
 							}
@@ -643,14 +783,14 @@ namespace Cpu {
 					} else {
 						graphs.resize(1);
 						graph_width = graph_default_width;
-						graphs[0] = Draw::Graph{ graph_width, graph_height, "cpu", safeVal(Gpu::shared_gpu_percent, graph_field), graph_symbol, invert, true };
+						graphs[0] = Draw::Graph{ graph_width, graph_height, Gradient::cpu, safeVal(Gpu::shared_gpu_percent, graph_field), graph_symbol, invert, true };
 					}
 				}
 				else {
 			#endif
 					graphs.resize(1);
 					graph_width = graph_default_width;
-					graphs[0] = Draw::Graph{ graph_width, graph_height, "cpu", safeVal(cpu.cpu_percent, graph_field), graph_symbol, invert, true };
+					graphs[0] = Draw::Graph{ graph_width, graph_height, Gradient::cpu, cpu_history(graph_field), graph_symbol, invert, true };
 			#ifdef GPU_SUPPORT
 				}
 			#endif
@@ -674,57 +814,76 @@ namespace Cpu {
 					//? GPU graphs/meters
 					auto width_left = b_width - 10 - (gpus.size() > 9 ? 2 : gpus.size() > 1 ? 1 : 0);
 					if (gpu.supported_functions.temp_info and show_temps) {
-						gpu_temp_graphs[i] = Draw::Graph{ 5, 1, "temp", gpu.temp, graph_symbol, false, false, gpu.temp_max, -23 };
+						gpu_temp_graphs[i] = Draw::Graph{ 5, 1, Gradient::temp, gpu.temp, graph_symbol, false, false, gpu.temp_max, -23 };
 						width_left -= 11;
 					}
 					if (gpu.supported_functions.mem_used and gpu.supported_functions.mem_total and b_columns > 1) {
-						gpu_mem_graphs[i] = Draw::Graph{ 5, 1, "used", safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol };
+						gpu_mem_graphs[i] = Draw::Graph{ 5, 1, Gradient::used, safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol };
 						width_left -= 5;
 					}
 					width_left -= (gpu.supported_functions.mem_used ? 5 : 0);
 					width_left -= (gpu.supported_functions.mem_total ? 6 : 0);
 					width_left -= (gpu.supported_functions.pwr_usage ? 6 : 0);
 					if (gpu.supported_functions.gpu_utilization) {
-						gpu_meters[i] = Draw::Meter{width_left, "cpu" };
+						gpu_meters[i] = Draw::Meter{width_left, Gradient::cpu };
 					}
 				}
 			}
 			#endif
 
-			cpu_meter = Draw::Meter{b_width - (show_temps ? 23 - (b_column_size <= 1 and b_columns == 1 ? 6 : 0) : 11), "cpu"};
+			cpu_meter = Draw::Meter{b_width - (show_temps ? 23 - (b_column_size <= 1 and b_columns == 1 ? 6 : 0) : 11), Gradient::cpu};
 
 			if (mid_line) {
-				out += Mv::to(y + graph_up_height + 1, x) + Fx::ub + Theme::c("cpu_box") + Symbols::div_left + Theme::c("div_line")
+				out += Mv::to(y + graph_up_height + 1, x) + Fx::ub + Theme::c(Color::cpu_box) + Symbols::div_left + Theme::c(Color::div_line)
 					+ Symbols::h_line * (width - b_width - 2) + Symbols::div_right
 					+ Mv::to(y + graph_up_height + 1, x + ((width - b_width) / 2) - ((graph_up_field.size() + graph_lo_field.size()) / 2) - 4)
-					+ Theme::c("main_fg") + graph_up_field + Mv::r(1) + "▲▼" + Mv::r(1) + graph_lo_field;
+					+ Theme::c(Color::main_fg) + graph_up_field + Mv::r(1) + "▲▼" + Mv::r(1) + graph_lo_field;
 			}
 
 			if (b_column_size > 0 or extra_width > 0) {
 				core_graphs.clear();
 				for (const auto& core_data : cpu.core_percent) {
-					core_graphs.emplace_back(5 * b_column_size + extra_width, 1, "cpu", core_data, graph_symbol);
+					core_graphs.emplace_back(5 * b_column_size + extra_width, 1, Gradient::cpu, core_data, graph_symbol);
+				}
+			}
+
+			group_graphs.clear();
+			group_temp_graphs.clear();
+			if (cpu_view == CoreView::grouped) {
+				const auto& groups = cpu.groups.at(core_view);
+				const bool group_temps = (show_temps and not hide_cores and b_column_size > 1
+					and rng::none_of(groups, [](const auto& group) { return group.temp.empty(); }));
+				for (const auto& group : groups) {
+					if (b_column_size > 0 or extra_width > 0)
+						group_graphs.emplace_back(5 * b_column_size + extra_width, 1, Gradient::cpu, group.percent, graph_symbol);
+					if (group_temps)
+						group_temp_graphs.emplace_back(5, 1, Gradient::temp, group.temp, graph_symbol, false, false, cpu.temp_max, -23);
 				}
 			}
 
 			if (show_temps) {
 				temp_graphs.clear();
-				temp_graphs.emplace_back(5, 1, "temp", safeVal(cpu.temp, 0), graph_symbol, false, false, cpu.temp_max, -23);
+				temp_graphs.emplace_back(5, 1, Gradient::temp, safeVal(cpu.temp, 0), graph_symbol, false, false, cpu.temp_max, -23);
 				if (not hide_cores and b_column_size > 1) {
 					for (const auto& i : iota((size_t)1, cpu.temp.size())) {
-						temp_graphs.emplace_back(5, 1, "temp", safeVal(cpu.temp, i), graph_symbol, false, false, cpu.temp_max, -23);
+						temp_graphs.emplace_back(5, 1, Gradient::temp, safeVal(cpu.temp, i), graph_symbol, false, false, cpu.temp_max, -23);
 					}
 				}
 			}
 		}
 
+		//? Update interval in title, shows the effective interval when stretched by adaptive_update
+		static string old_update;
+		const string update = to_string(Adaptive::interval) + "ms";
+		const bool update_resized = (not redraw and update.size() != old_update.size());
+
 		//? Draw battery if enabled and present
 		if (Config::getB("show_battery") and has_battery) {
 			static int old_percent{};   // defaults to = 0
 			static long old_seconds{};  // defaults to = 0
 			static float old_watts{};	// defaults to = 0
 			static string old_status;
-			static Draw::Meter bat_meter {10, "cpu", true};
+			static Draw::Meter bat_meter {10, Gradient::cpu, true};
 			static const std::unordered_map<string, string> bat_symbols = {
 				{"charging", "▲"},
 				{"discharging", "▼"},
@@ -734,33 +893,45 @@ namespace Cpu {
 
 			const auto& [percent, watts, seconds, status] = current_bat;
 
-			if (redraw or percent != old_percent or (watts != old_watts and Config::getB("show_battery_watts")) or seconds != old_seconds or status != old_status) {
+			if (redraw or update_resized or percent != old_percent or (watts != old_watts and Config::getB("show_battery_watts")) or seconds != old_seconds or status != old_status) {
 				old_percent = percent;
 				old_watts = watts;
 				old_seconds = seconds;
 				old_status = status;
 				const string str_time = (seconds > 0 ? sec_to_dhms(seconds, false, true) : "");
 				const string str_percent = to_string(percent) + '%';
-				const string str_watts = (watts != -1 and Config::getB("show_battery_watts") ? fmt::format("{:.2f}", watts) + 'W' : "");
+				const string str_watts = (watts != -1 and Config::getB("show_battery_watts") ? fmt::format(FMT_COMPILE("{:.2f}"), watts) + 'W' : "");
 				const auto& bat_symbol = bat_symbols.at((bat_symbols.contains(status) ? status : "unknown"));
-				const int current_len = (Term::width >= 100 ? 11 : 0) + str_time.size() + str_percent.size() + str_watts.size() + to_string(g_CfgMgr.get<CfgI>("update_ms").v()).size();
+				const int current_len = (Term::width >= 100 ? 11 : 0) + str_time.size() + str_percent.size() + str_watts.size() + update.size() - 2;
 				const int current_pos = Term::width - current_len - 17;
 
 				if ((bat_pos != current_pos or bat_len != current_len) and bat_pos > 0 and not redraw)
-					out += Mv::to(y, bat_pos) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * (bat_len + 4);
+					out += Mv::to(y, bat_pos) + Fx::ub + Theme::c(Color::cpu_box) + Symbols::h_line * (bat_len + 4);
 				bat_pos = current_pos;
 				bat_len = current_len;
 
-				out += Mv::to(y, bat_pos) + title_left + Theme::c("title") + Fx::b + "BAT" + bat_symbol + ' ' + str_percent
+				out += Mv::to(y, bat_pos) + title_left + Theme::c(Color::title) + Fx::b + "BAT" + bat_symbol + ' ' + str_percent
 					+ (Term::width >= 100 ? Fx::ub + ' ' + bat_meter(percent) + Fx::b : "")
-					+ (not str_time.empty() ? ' ' + Theme::c("title") + str_time : "") + (not str_watts.empty() ? " " + Theme::c("title") + Fx::b + str_watts : "") + Fx::ub + title_right;
+					+ (not str_time.empty() ? ' ' + Theme::c(Color::title) + str_time : "") + (not str_watts.empty() ? " " + Theme::c(Color::title) + Fx::b + str_watts : "") + Fx::ub + title_right;
 			}
 		}
 		else if (bat_pos > 0) {
-			out += Mv::to(y, bat_pos) + Fx::ub + Theme::c("cpu_box") + Symbols::h_line * (bat_len + 4);
+			out += Mv::to(y, bat_pos) + Fx::ub + Theme::c(Color::cpu_box) + Symbols::h_line * (bat_len + 4);
 			bat_pos = bat_len = 0;
 		}
 
+		//? Drawn after the battery so a moved battery title can't overwrite it
+		if (redraw or update != old_update) {
+			const int button_y = cpu_bottom ? y + height - 1 : y;
+			if (update_resized)
+				out += Mv::to(button_y, x + width - old_update.size() - 8) + Fx::ub + Theme::c(Color::cpu_box) + Symbols::h_line * (old_update.size() + 6);
+			out += Mv::to(button_y, x + width - update.size() - 8) + title_left + Fx::b + Theme::c(Color::hi_fg) + "- " + Theme::c(Color::title) + update
+				+ Theme::c(Color::hi_fg) + " +" + Fx::ub + title_right;
+			Input::mouse_mappings["-"] = {button_y, x + width - (int)update.size() - 7, 1, 2};
+			Input::mouse_mappings["+"] = {button_y, x + width - 5, 1, 2};
+			old_update = update;
+		}
+
 		try {
 		//? Cpu/Gpu graphs
 		out += Fx::ub + Mv::to(y + 1, x + 1);
@@ -780,7 +951,7 @@ namespace Cpu {
 						}
 
 						if (++gpu_drawn < Gpu::count - (gpu_auto ? Gpu::shown : 0))
-							out += Theme::c("div_line") + (Symbols::v_line + Mv::l(1) + Mv::u(1))*graph_height + Mv::r(1) + Mv::d(1);
+							out += Theme::c(Color::div_line) + (Symbols::v_line + Mv::l(1) + Mv::u(1))*graph_height + Mv::r(1) + Mv::d(1);
 					}
 				}
 				else
@@ -790,7 +961,7 @@ namespace Cpu {
 			(void)graph_height;
 			(void)graph_width;
 		#endif
-				out += graphs[0](safeVal(cpu.cpu_percent, graph_field), (data_same or redraw));
+				out += graphs[0](cpu_history(graph_field), (data_same or redraw));
 		};
 
 		draw_graphs(graphs_upper, graph_up_height, graph_up_width, graph_up_field);
@@ -807,57 +978,157 @@ namespace Cpu {
 				upstr = trans(upstr);
 			}
 			out += Mv::to(y + (single_graph or not Config::getB("cpu_invert_lower") ? 1 : height - 2), x + 2)
-				+ Theme::c("graph_text") + "up" + Mv::r(1) + upstr;
+				+ Theme::c(Color::graph_text) + "up" + Mv::r(1) + upstr;
 		}
 
 		//? Cpu clock and cpu meter
 		if (Config::getB("show_cpu_freq") and not cpuHz.empty())
-			out += Mv::to(b_y, b_x + b_width - 10) + Fx::ub + Theme::c("div_line") + Symbols::h_line * (7 - cpuHz.size())
-				+ Symbols::title_left + Fx::b + Theme::c("title") + cpuHz + Fx::ub + Theme::c("div_line") + Symbols::title_right;
+			out += Mv::to(b_y, b_x + b_width - 10) + Fx::ub + Theme::c(Color::div_line) + Symbols::h_line * (7 - cpuHz.size())
+				+ Symbols::title_left + Fx::b + Theme::c(Color::title) + cpuHz + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right;
 
-		out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "CPU " + cpu_meter(safeVal(cpu.cpu_percent, "total"s).back())
-			+ Theme::g("cpu").at(clamp(safeVal(cpu.cpu_percent, "total"s).back(), 0ll, 100ll)) + rjust(to_string(safeVal(cpu.cpu_percent, "total"s).back()), 4) + Theme::c("main_fg") + '%';
+		out += Mv::to(b_y + 1, b_x + 1) + Theme::c(Color::main_fg) + Fx::b + "CPU " + cpu_meter(cpu.cpu_percent[Cpu::Field::total].back())
+			+ Theme::g(Gradient::cpu).at(clamp(cpu.cpu_percent[Cpu::Field::total].back(), 0ll, 100ll)) + rjust(to_string(cpu.cpu_percent[Cpu::Field::total].back()), 4) + Theme::c(Color::main_fg) + '%';
 		if (show_temps) {
 			const auto [temp, unit] = celsius_to(safeVal(cpu.temp, 0).back(), temp_scale);
-			const auto& temp_color = Theme::g("temp").at(clamp(safeVal(cpu.temp, 0).back() * 100 / cpu.temp_max, 0ll, 100ll));
+			const auto& temp_color = Theme::g(Gradient::temp).at(clamp(safeVal(cpu.temp, 0).back() * 100 / cpu.temp_max, 0ll, 100ll));
 			if ((b_column_size > 1 or b_columns > 1) and temp_graphs.size() >= 1ll)
-				out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + temp_color
+				out += ' ' + Theme::c(Color::inactive_fg) + graph_bg * 5 + Mv::l(5) + temp_color
 					+ temp_graphs.at(0)(safeVal(cpu.temp, 0), data_same or redraw);
-			out += rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+			out += rjust(to_string(temp), 4) + Theme::c(Color::main_fg) + unit;
 		}
-		out += Theme::c("div_line") + Symbols::v_line;
+		out += Theme::c(Color::div_line) + Symbols::v_line;
 
 		} catch (const std::exception& e) { throw std::runtime_error("graphs, clock, meter : " + string{e.what()}); }
 
-		//? Core text and graphs
+		//? Core area, one row per core, per group of the topology level picked by cpu_core_view or per core of the group
+		//? drilled into, or one heatmap cell per core colored by frequency when per core frequencies are collected, else usage
+		const vector<core_group>* groups = (cpu_view == CoreView::grouped ? &cpu.groups.at(core_view) : nullptr);
+		const bool drilled = (groups != nullptr and drill_group >= 0 and cmp_less(drill_group, groups->size()));
+		const bool grouped = (groups != nullptr and not drilled);
+		const char label_prefix = (grouped ? (char)toupper(core_view.front()) : 'C');
+		static vector<int> rows;
+		//? Named fallbacks for cores missing from the collected data, bound to references below so they can't be temporaries
+		static const PercentHistory no_percent{0};
+		static const RingBuffer<int16_t> no_temps;
+		const bool counters = (has_counters and not cpu.counters.empty() and cpu_view != CoreView::heatmap);
+
+		//? Performance counters of a core, or the averages over the counted cores of a group
+		auto row_counters = [&](int n) {
+			if (not grouped) return (cmp_less(n, cpu.counters.size()) ? cpu.counters[n] : core_counters{});
+			core_counters average;
+			for (const auto field : {&core_counters::ipc, &core_counters::cache_miss, &core_counters::branch_miss, &core_counters::switches}) {
+				long long total = 0, counted = 0;
+				for (const int core : groups->at(n).cores) {
+					if (cmp_less(core, cpu.counters.size()) and cpu.counters[core].*field >= 0) {
+						total += cpu.counters[core].*field;
+						counted++;
+					}
+				}
+				if (counted > 0) average.*field = total / counted;
+			}
+			return average;
+		};
+		rows.clear();
+		if (drilled) rows = groups->at(drill_group).cores;
+		else for (const auto& n : iota(0, (grouped ? (int)groups->size() : Shared::coreCount))) rows.push_back(n);
+
 		int cx = 0, cy = 1, cc = 0, core_width = (b_column_size == 0 ? 2 : 3);
 		if (Shared::coreCount >= 100) core_width++;
-		for (const auto& n : iota(0, Shared::coreCount)) {
-			out += Mv::to(b_y + cy + 1, b_x + cx + 1) + Theme::c("main_fg") + (Shared::coreCount < 100 ? Fx::b + 'C' + Fx::ub : "")
-				+ ljust(to_string(n), core_width);
-			if ((b_column_size > 0 or extra_width > 0) and cmp_less(n, core_graphs.size()))
-				out += Theme::c("inactive_fg") + graph_bg * (5 * b_column_size + extra_width) + Mv::l(5 * b_column_size + extra_width)
-					+ core_graphs.at(n)(safeVal(cpu.core_percent, n), data_same or redraw);
-
-			out += Theme::g("cpu").at(clamp(safeVal(cpu.core_percent, n).back(), 0ll, 100ll));
-			out += rjust(to_string(safeVal(cpu.core_percent, n).back()), (b_column_size < 2 ? 3 : 4)) + Theme::c("main_fg") + '%';
-
-			if (show_temps and not hide_cores) {
-				const auto [temp, unit] = celsius_to(safeVal(cpu.temp, n+1).back(), temp_scale);
-				const auto& temp_color = Theme::g("temp").at(clamp(safeVal(cpu.temp, n+1).back() * 100 / cpu.temp_max, 0ll, 100ll));
-				if (b_column_size > 1 and std::cmp_greater_equal(temp_graphs.size(), n))
-					out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5)
-						+ temp_graphs.at(n+1)(safeVal(cpu.temp, n+1), data_same or redraw);
-				out += temp_color + rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+		if (cpu_view == CoreView::heatmap) {
+			const int cells = max(1, b_width - 2);
+			for (const auto& n : iota(0, Shared::coreCount)) {
+				if (n / cells >= b_height - 4 - sched_line) break;
+				if (n % cells == 0) out += Mv::to(b_y + n / cells + 2, b_x + 1);
+				const long long level = (core_freq and cmp_less(n, cpu.core_freq.size()) and not cpu.core_freq[n].empty()
+					? cpu.core_freq[n].back() * 100 / cpu.freq_top : safeVal(cpu.core_percent, n, no_percent).back());
+				out += Theme::g(Gradient::cpu).at(clamp(level, 0ll, 100ll)) + Symbols::meter;
+			}
+			cy = (Shared::coreCount + cells - 1) / cells + 1;
+		}
+		else for (size_t i = 0; i < rows.size(); i++) {
+			const int n = rows[i];
+			const auto& percent = (grouped ? groups->at(n).percent : safeVal(cpu.core_percent, n, no_percent));
+			const auto& temps = (grouped ? groups->at(n).temp : safeVal(cpu.temp, n + 1, no_temps));
+			auto& percent_graphs = (grouped ? group_graphs : core_graphs);
+			const int temp_graph = (grouped ? n : n + 1);
+			auto& row_temp_graphs = (grouped ? group_temp_graphs : temp_graphs);
+
+			//? Core labels are colored by frequency relative to the highest seen when per core frequencies are collected
+			const auto& label_color = (not grouped and core_freq and cmp_less(n, cpu.core_freq.size()) and not cpu.core_freq[n].empty()
+				? Theme::g(Gradient::cpu).at(clamp(cpu.core_freq[n].back() * 100 / cpu.freq_top, 0ll, 100ll)) : Theme::c(Color::main_fg));
+			out += Mv::to(b_y + cy + 1, b_x + cx + 1) + label_color + (Shared::coreCount < 100 ? Fx::b + label_prefix + Fx::ub : "")
+				+ ljust(to_string(grouped ? groups->at(n).id : n), core_width);
+			if ((b_column_size > 0 or extra_width > 0) and cmp_less(n, percent_graphs.size()))
+				out += Theme::c(Color::inactive_fg) + graph_bg * (5 * b_column_size + extra_width) + Mv::l(5 * b_column_size + extra_width)
+					+ percent_graphs.at(n)(percent, data_same or redraw);
+
+			out += Theme::g(Gradient::cpu).at(clamp(percent.back(), 0ll, 100ll));
+			out += rjust(to_string(percent.back()), (b_column_size < 2 ? 3 : 4)) + Theme::c(Color::main_fg) + '%';
+
+			//? Instructions per cycle colored by cache miss ratio, or context switches per second from the software counters
+			if (counters) {
+				const auto value = row_counters(n);
+				string text = "-";
+				if (cpu.counters_hardware and value.ipc >= 0)
+					text = fmt::format(FMT_COMPILE("{:.{}f}"), value.ipc / 100.0, (value.ipc < 1000 ? 2 : 1));
+				else if (not cpu.counters_hardware and value.switches >= 0)
+					text = short_count(value.switches);
+				out += (value.cache_miss >= 0 ? Theme::g(Gradient::temp).at(clamp(value.cache_miss, 0ll, 100ll))
+					: Theme::c(text == "-" ? Color::inactive_fg : Color::main_fg)) + rjust(text, 5) + Theme::c(Color::main_fg);
+			}
+
+			if (show_temps and not hide_cores and not temps.empty()) {
+				const auto [temp, unit] = celsius_to(temps.back(), temp_scale);
+				const auto& temp_color = Theme::g(Gradient::temp).at(clamp(temps.back() * 100 / cpu.temp_max, 0ll, 100ll));
+				if (b_column_size > 1 and cmp_less(temp_graph, row_temp_graphs.size()))
+					out += ' ' + Theme::c(Color::inactive_fg) + graph_bg * 5 + Mv::l(5)
+						+ row_temp_graphs.at(temp_graph)(temps, data_same or redraw);
+				out += temp_color + rjust(to_string(temp), 4) + Theme::c(Color::main_fg) + unit;
+			}
+
+			out += Theme::c(Color::div_line) + Symbols::v_line;
+
+			if ((++cy > ceil((double)rows.size() / b_columns) or cy == b_height - 2 - sched_line) and i != rows.size() - 1) {
+				if (++cc >= b_columns) break;
+				cy = 1; cx = (b_width / b_columns) * cc;
 			}
+		}
 
-			out += Theme::c("div_line") + Symbols::v_line;
+		//? Min, avg and max core frequency on the bottom border, shortened to just the values in narrow boxes
+		size_t bottom_used = 0;
+		if (core_freq and b_width >= 21) {
+			const auto ghz = [](long long mhz) { return fmt::format(FMT_COMPILE("{:.1f}"), mhz / 1000.0); };
+			const string freq_summary = (b_width >= 33
+				? "min " + ghz(cpu.freq_min) + " avg " + ghz(cpu.freq_avg) + " max " + ghz(cpu.freq_max) + " GHz"
+				: ghz(cpu.freq_min) + '/' + ghz(cpu.freq_avg) + '/' + ghz(cpu.freq_max) + " GHz");
+			out += Mv::to(b_y + b_height - 1, b_x + 2) + Theme::c(Color::div_line) + Symbols::title_left_down + Theme::c(Color::title)
+				+ freq_summary + Theme::c(Color::div_line) + Symbols::title_right_down;
+			bottom_used = freq_summary.size() + 3;
+		}
 
-			if ((++cy > ceil((double)Shared::coreCount / b_columns) or cy == b_height - 2) and n != Shared::coreCount - 1) {
-				if (++cc >= b_columns) break;
-				cy = 1; cx = (b_width / b_columns) * cc;
+		//? Current core view on the right of the bottom border
+		string view_title = (drilled ? core_view + ' ' + to_string(groups->at(drill_group).id)
+			: grouped ? "by " + core_view : cpu_view == CoreView::heatmap ? core_view + (core_freq ? " freq" : "") : "");
+
+		//? Followed by what the counter column shows, with the average miss ratios over the cores when there is room
+		if (counters) {
+			string counters_title = (cpu.counters_hardware ? "ipc" : "cs/s");
+			long long cache_miss = 0, branch_miss = 0, counted = 0;
+			for (const auto& core : cpu.counters) {
+				if (core.cache_miss < 0 or core.branch_miss < 0) continue;
+				cache_miss += core.cache_miss;
+				branch_miss += core.branch_miss;
+				counted++;
+			}
+			if (counted > 0) {
+				const string misses = fmt::format(" miss cache {}% branch {}%", cache_miss / counted, branch_miss / counted);
+				if (bottom_used + view_title.size() + counters_title.size() + misses.size() + 6 <= (size_t)b_width) counters_title += misses;
 			}
+			view_title += (view_title.empty() ? "" : " ") + counters_title;
 		}
+		if (not view_title.empty() and bottom_used + view_title.size() + 5 <= (size_t)b_width)
+			out += Mv::to(b_y + b_height - 1, b_x + b_width - view_title.size() - 3) + Theme::c(Color::div_line) + Symbols::title_left_down
+				+ Theme::c(Color::title) + view_title + Theme::c(Color::div_line) + Symbols::title_right_down;
 
 		//? Load average
 		if (cy < b_height - 1 and cc <= b_columns) {
@@ -878,11 +1149,39 @@ namespace Cpu {
 				lavg_str_len = lavg_str.length();
 			}
 		#ifdef GPU_SUPPORT
-			cy = b_height - 2 - (show_gpu ? (gpus.size() - (gpu_always ? 0 : Gpu::shown)) : 0);
+			cy = b_height - 2 - sched_line - (show_gpu ? (gpus.size() - (gpu_always ? 0 : Gpu::shown)) : 0);
 		#else
-			cy = b_height - 2;
+			cy = b_height - 2 - sched_line;
 		#endif
-			out += Mv::to(b_y + cy, b_x + cx + 1) + Theme::c("main_fg") + lavg_str;
+			out += Mv::to(b_y + cy, b_x + cx + 1) + Theme::c(Color::main_fg) + lavg_str;
+
+			//? Scheduler activity below the load average, labels are shortened and the last values dropped until the line fits
+			if (sched_line) {
+				vector<array<string, 3>> values = {
+					{"Ctx/s", "cs", short_count(cpu.ctxt_rate)},
+					{"Fork/s", "fk", short_count(cpu.fork_rate)},
+					{"Run", "r", to_string(cpu.procs_running)},
+					{"Blk", "b", to_string(cpu.procs_blocked)},
+				};
+				if (not cpu.core_run_wait.empty()) {
+					const auto worst = std::ranges::max_element(cpu.core_run_wait);
+					long long total = 0;
+					for (const auto wait : cpu.core_run_wait) total += wait;
+					values.push_back({"Wait", "w", short_count(total / (long long)cpu.core_run_wait.size()) + "µs"});
+					values.push_back({"Max", "m", "C" + to_string(worst - cpu.core_run_wait.begin()) + ' ' + short_count(*worst) + "µs"});
+				}
+				const size_t room = max(0, b_width - cx - 2);
+				auto line = [&](size_t label, size_t count) {
+					string joined;
+					for (size_t i = 0; i < count; i++)
+						joined += (i == 0 ? "" : " ") + values[i][label] + ' ' + values[i][2];
+					return joined;
+				};
+				size_t count = values.size(), label = 0;
+				if (ulen(line(label, count)) > room) label = 1;
+				while (count > 0 and ulen(line(label, count)) > room) count--;
+				out += Mv::to(b_y + ++cy, b_x + cx + 1) + Theme::c(Color::main_fg) + ljust(line(label, count), room);
+			}
 		}
 
 	#ifdef GPU_SUPPORT
@@ -891,41 +1190,41 @@ namespace Cpu {
 			for (unsigned long i = 0; i < gpus.size(); ++i) {
 				if (gpu_auto and v_contains(Gpu::shown_panels, i))
 					continue;
-				out += Mv::to(b_y + ++cy, b_x + 1) + Theme::c("main_fg") + Fx::b + "GPU";
+				out += Mv::to(b_y + ++cy, b_x + 1) + Theme::c(Color::main_fg) + Fx::b + "GPU";
 				if (gpus.size() > 1) out += rjust(to_string(i), 1 + (gpus.size() > 9));
 				if (gpus[i].supported_functions.gpu_utilization) {
 					out += ' ';
 					if (b_columns > 1) {
 					out += gpu_meters[i](safeVal(gpus[i].gpu_percent, "gpu-totals"s).back())
-						+ Theme::g("cpu").at(clamp(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back(), 0ll, 100ll));
+						+ Theme::g(Gradient::cpu).at(clamp(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back(), 0ll, 100ll));
 					}
-					out += rjust(to_string(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back()), 3) + Theme::c("main_fg") + '%';
+					out += rjust(to_string(safeVal(gpus[i].gpu_percent, "gpu-totals"s).back()), 3) + Theme::c(Color::main_fg) + '%';
 					if (b_columns == 1)
 						out += ' ';
 				}
 				if (gpus[i].supported_functions.mem_used and gpus[i].supported_functions.mem_total and b_columns > 1) {
-					out += ' ' + Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + Theme::g("used").at(safeVal(gpus[i].gpu_percent, "gpu-vram-totals"s).back())
+					out += ' ' + Theme::c(Color::inactive_fg) + graph_bg * 5 + Mv::l(5) + Theme::g(Gradient::used).at(safeVal(gpus[i].gpu_percent, "gpu-vram-totals"s).back())
 						+ gpu_mem_graphs[i](safeVal(gpus[i].gpu_percent, "gpu-vram-totals"s), data_same or redraw);
 				}
 				if (gpus[i].supported_functions.mem_used) {
-						out += Theme::c("main_fg")
+						out += Theme::c(Color::main_fg)
 						+ rjust(floating_humanizer(gpus[i].mem_used, true), 5);
 				}
 				if (gpus[i].supported_functions.mem_total) {
-						out += Theme::c("inactive_fg") + '/' + Theme::c("main_fg") + ljust(floating_humanizer(gpus[i].mem_total, true), 4);
+						out += Theme::c(Color::inactive_fg) + '/' + Theme::c(Color::main_fg) + ljust(floating_humanizer(gpus[i].mem_total, true), 4);
 				}
 				if (show_temps and gpus[i].supported_functions.temp_info) {
 					const auto [temp, unit] = celsius_to(gpus[i].temp.back(), temp_scale);
 					out += ' ';
 					if (b_columns > 1)
-						out += Theme::c("inactive_fg") + graph_bg * 5 + Mv::l(5) + Theme::g("temp").at(clamp(gpus[i].temp.back() * 100 / gpus[i].temp_max, 0ll, 100ll))
+						out += Theme::c(Color::inactive_fg) + graph_bg * 5 + Mv::l(5) + Theme::g(Gradient::temp).at(clamp(gpus[i].temp.back() * 100 / gpus[i].temp_max, 0ll, 100ll))
 							+ gpu_temp_graphs[i](gpus[i].temp, data_same or redraw);
-					else out += Theme::g("temp").at(clamp(gpus[i].temp.back() * 100 / gpus[i].temp_max, 0ll, 100ll));
-					out += rjust(to_string(temp), 3) + Theme::c("main_fg") + unit;
+					else out += Theme::g(Gradient::temp).at(clamp(gpus[i].temp.back() * 100 / gpus[i].temp_max, 0ll, 100ll));
+					out += rjust(to_string(temp), 3) + Theme::c(Color::main_fg) + unit;
 				}
 				if (gpus[i].supported_functions.pwr_usage) {
-					out += ' ' + Theme::g("cached").at(clamp(safeVal(gpus[i].gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
-						+ fmt::format("{:>4.{}f}", gpus[i].pwr_usage / 1000.0, gpus[i].pwr_usage < 10'000 ? 2 : gpus[i].pwr_usage < 100'000 ? 1 : 0) + Theme::c("main_fg") + 'W';
+					out += ' ' + Theme::g(Gradient::cached).at(clamp(safeVal(gpus[i].gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
+						+ fmt::format(FMT_COMPILE("{:>4.{}f}"), gpus[i].pwr_usage / 1000.0, gpus[i].pwr_usage < 10'000 ? 2 : gpus[i].pwr_usage < 100'000 ? 1 : 0) + Theme::c(Color::main_fg) + 'W';
 				}
 
 				if (cy > b_height - 1) break;
@@ -992,26 +1291,26 @@ namespace Gpu {
 			out += box[index];
 
 			if (gpu.supported_functions.gpu_utilization) {
-				graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, "cpu", safeVal(gpu.gpu_percent, "gpu-totals"s), graph_symbol, false, true}; // TODO cpu -> gpu
+				graph_upper = Draw::Graph{x + width - b_width - 3, graph_up_height, Gradient::cpu, safeVal(gpu.gpu_percent, "gpu-totals"s), graph_symbol, false, true}; // TODO cpu -> gpu
             	if (not single_graph) {
                 	graph_lower = Draw::Graph{
                     	x + width - b_width - 3,
-                    	graph_low_height, "cpu",
+                    	graph_low_height, Gradient::cpu,
                     	safeVal(gpu.gpu_percent, "gpu-totals"s),
                     	graph_symbol,
                     	Config::getB("cpu_invert_lower"), true
                 	};
             	}
-				gpu_meter = Draw::Meter{b_width - (show_temps ? 25 : 12), "cpu"};
+				gpu_meter = Draw::Meter{b_width - (show_temps ? 25 : 12), Gradient::cpu};
 			}
 			if (gpu.supported_functions.temp_info)
-				temp_graph = Draw::Graph{6, 1, "temp", gpu.temp, graph_symbol, false, false, gpu.temp_max, -23};
+				temp_graph = Draw::Graph{6, 1, Gradient::temp, gpu.temp, graph_symbol, false, false, gpu.temp_max, -23};
 			if (gpu.supported_functions.pwr_usage)
-				pwr_meter = Draw::Meter{b_width - (gpu.supported_functions.pwr_state and gpu.pwr_state != 32 ? 25 : 12), "cached"};
+				pwr_meter = Draw::Meter{b_width - (gpu.supported_functions.pwr_state and gpu.pwr_state != 32 ? 25 : 12), Gradient::cached};
 			if (gpu.supported_functions.mem_utilization)
-				mem_util_graph = Draw::Graph{b_width/2 - 1, 2, "free", gpu.mem_utilization_percent, graph_symbol, 0, 0, 100, 4}; // offset so the graph isn't empty at 0-5% utilization
+				mem_util_graph = Draw::Graph{b_width/2 - 1, 2, Gradient::free, gpu.mem_utilization_percent, graph_symbol, 0, 0, 100, 4}; // offset so the graph isn't empty at 0-5% utilization
 			if (gpu.supported_functions.mem_used and gpu.supported_functions.mem_total)
-				mem_used_graph = Draw::Graph{b_width/2 - 2, 2 + 2*(gpu.supported_functions.mem_utilization), "used", safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol};
+				mem_used_graph = Draw::Graph{b_width/2 - 2, 2 + 2*(gpu.supported_functions.mem_utilization), Gradient::used, safeVal(gpu.gpu_percent, "gpu-vram-totals"s), graph_symbol};
 		}
 
 
@@ -1023,32 +1322,32 @@ namespace Gpu {
 			if (not single_graph)
 				out += Mv::to(y + graph_up_height + 1, x + 1) + graph_lower(safeVal(gpu.gpu_percent, "gpu-totals"s), (data_same or redraw[index]));
 
-			out += Mv::to(b_y + 1, b_x + 1) + Theme::c("main_fg") + Fx::b + "GPU " + gpu_meter(safeVal(gpu.gpu_percent, "gpu-totals"s).back())
-				+ Theme::g("cpu").at(clamp(safeVal(gpu.gpu_percent, "gpu-totals"s).back(), 0ll, 100ll)) + rjust(to_string(safeVal(gpu.gpu_percent, "gpu-totals"s).back()), 5) + Theme::c("main_fg") + '%';
+			out += Mv::to(b_y + 1, b_x + 1) + Theme::c(Color::main_fg) + Fx::b + "GPU " + gpu_meter(safeVal(gpu.gpu_percent, "gpu-totals"s).back())
+				+ Theme::g(Gradient::cpu).at(clamp(safeVal(gpu.gpu_percent, "gpu-totals"s).back(), 0ll, 100ll)) + rjust(to_string(safeVal(gpu.gpu_percent, "gpu-totals"s).back()), 5) + Theme::c(Color::main_fg) + '%';
 
 			//? Temperature graph, I assume the device supports utilization if it supports temperature
 			if (show_temps) {
 				const auto [temp, unit] = celsius_to(gpu.temp.back(), temp_scale);
-				out += ' ' + Theme::c("inactive_fg") + graph_bg * 6 + Mv::l(6) + Theme::g("temp").at(clamp(gpu.temp.back() * 100 / gpu.temp_max, 0ll, 100ll))
+				out += ' ' + Theme::c(Color::inactive_fg) + graph_bg * 6 + Mv::l(6) + Theme::g(Gradient::temp).at(clamp(gpu.temp.back() * 100 / gpu.temp_max, 0ll, 100ll))
 					+ temp_graph(gpu.temp, data_same or redraw[index]);
-				out += rjust(to_string(temp), 4) + Theme::c("main_fg") + unit;
+				out += rjust(to_string(temp), 4) + Theme::c(Color::main_fg) + unit;
 			}
-			out += Theme::c("div_line") + Symbols::v_line;
+			out += Theme::c(Color::div_line) + Symbols::v_line;
 		}
 
 		if (gpu.supported_functions.gpu_clock) {
 			string clock_speed_string = to_string(gpu.gpu_clock_speed);
-			out += Mv::to(b_y, b_x + b_width - 12) + Theme::c("div_line") + Symbols::h_line*(5-clock_speed_string.size())
-				+ Symbols::title_left + Fx::b + Theme::c("title") + clock_speed_string + " Mhz" + Fx::ub + Theme::c("div_line") + Symbols::title_right;
+			out += Mv::to(b_y, b_x + b_width - 12) + Theme::c(Color::div_line) + Symbols::h_line*(5-clock_speed_string.size())
+				+ Symbols::title_left + Fx::b + Theme::c(Color::title) + clock_speed_string + " Mhz" + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right;
 		}
 
 		//? Power usage meter, power state
 		if (gpu.supported_functions.pwr_usage) {
-			out += Mv::to(b_y + 2, b_x + 1) + Theme::c("main_fg") + Fx::b + "PWR " + pwr_meter(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back())
-				+ Theme::g("cached").at(clamp(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
-				+ fmt::format("{:>5.{}f}", gpu.pwr_usage / 1000.0, gpu.pwr_usage < 10'000 ? 2 : gpu.pwr_usage < 100'000 ? 1 : 0) + Theme::c("main_fg") + 'W';
+			out += Mv::to(b_y + 2, b_x + 1) + Theme::c(Color::main_fg) + Fx::b + "PWR " + pwr_meter(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back())
+				+ Theme::g(Gradient::cached).at(clamp(safeVal(gpu.gpu_percent, "gpu-pwr-totals"s).back(), 0ll, 100ll))
+				+ fmt::format(FMT_COMPILE("{:>5.{}f}"), gpu.pwr_usage / 1000.0, gpu.pwr_usage < 10'000 ? 2 : gpu.pwr_usage < 100'000 ? 1 : 0) + Theme::c(Color::main_fg) + 'W';
 			if (gpu.supported_functions.pwr_state and gpu.pwr_state != 32) // NVML_PSTATE_UNKNOWN; unsupported or non-nvidia card
-				out += std::string(" P-state: ") + (gpu.pwr_state > 9 ? "" : " ") + 'P' + Theme::g("cached").at(clamp(gpu.pwr_state, 0ll, 100ll)) + to_string(gpu.pwr_state);
+				out += std::string(" P-state: ") + (gpu.pwr_state > 9 ? "" : " ") + 'P' + Theme::g(Gradient::cached).at(clamp(gpu.pwr_state, 0ll, 100ll)) + to_string(gpu.pwr_state);
 		}
 
 		if (gpu.supported_functions.mem_total or gpu.supported_functions.mem_used) {
@@ -1060,28 +1359,28 @@ namespace Gpu {
 					* (1 + 2*(gpu.supported_functions.mem_total and gpu.supported_functions.mem_used) + 2*gpu.supported_functions.mem_utilization);
 
 				//? Used graph, memory section header, total vram
-				out += Theme::c("div_line") + Symbols::div_left + Symbols::h_line + Symbols::title_left + Fx::b + Theme::c("title") + "vram" + Theme::c("div_line") + Fx::ub + Symbols::title_right
+				out += Theme::c(Color::div_line) + Symbols::div_left + Symbols::h_line + Symbols::title_left + Fx::b + Theme::c(Color::title) + "vram" + Theme::c(Color::div_line) + Fx::ub + Symbols::title_right
 					+  Symbols::h_line*(b_width/2-8) + Symbols::div_up + Mv::d(offset)+Mv::l(1) + Symbols::div_down + Mv::l(1)+Mv::u(1) + (Symbols::v_line + Mv::l(1)+Mv::u(1))*(offset-1) + Symbols::div_up
-					+  Symbols::h_line + Theme::c("title") + "Used:" + Theme::c("div_line")
-					+  Symbols::h_line*(b_width/2+b_width%2-9-used_memory_string.size()) + Theme::c("title") + used_memory_string + Theme::c("div_line") + Symbols::h_line + Symbols::div_right
+					+  Symbols::h_line + Theme::c(Color::title) + "Used:" + Theme::c(Color::div_line)
+					+  Symbols::h_line*(b_width/2+b_width%2-9-used_memory_string.size()) + Theme::c(Color::title) + used_memory_string + Theme::c(Color::div_line) + Symbols::h_line + Symbols::div_right
 					+  Mv::d(1) + Mv::l(b_width/2-1) + mem_used_graph(safeVal(gpu.gpu_percent, "gpu-vram-totals"s), (data_same or redraw[index]))
-					+  Mv::l(b_width-3) + Mv::u(1+2*gpu.supported_functions.mem_utilization) + Theme::c("main_fg") + Fx::b + "Total:" + rjust(floating_humanizer(gpu.mem_total), b_width/2-9) + Fx::ub
+					+  Mv::l(b_width-3) + Mv::u(1+2*gpu.supported_functions.mem_utilization) + Theme::c(Color::main_fg) + Fx::b + "Total:" + rjust(floating_humanizer(gpu.mem_total), b_width/2-9) + Fx::ub
 					+  Mv::r(3) + rjust(to_string(safeVal(gpu.gpu_percent, "gpu-vram-totals"s).back()), 3) + '%';
 
 				//? Memory utilization
 				if (gpu.supported_functions.mem_utilization)
-					out += Mv::l(b_width/2+6) + Mv::d(1) + Theme::c("div_line") + Symbols::div_left+Symbols::h_line + Theme::c("title") + "Utilization:" + Theme::c("div_line") + Symbols::h_line*(b_width/2-14) + Symbols::div_right
+					out += Mv::l(b_width/2+6) + Mv::d(1) + Theme::c(Color::div_line) + Symbols::div_left+Symbols::h_line + Theme::c(Color::title) + "Utilization:" + Theme::c(Color::div_line) + Symbols::h_line*(b_width/2-14) + Symbols::div_right
 						+  Mv::l(b_width/2)   + Mv::d(1) + mem_util_graph(gpu.mem_utilization_percent, (data_same or redraw[index]))
 						+  Mv::l(b_width/2-1) + Mv::u(1) + rjust(to_string(gpu.mem_utilization_percent.back()), 3) + '%';
 
 				//? Memory clock speed
 				if (gpu.supported_functions.mem_clock) {
 					string clock_speed_string = to_string(gpu.mem_clock_speed);
-					out += Mv::to(b_y + 3, b_x + b_width/2 - 11) + Theme::c("div_line") + Symbols::h_line*(5-clock_speed_string.size())
-						+ Symbols::title_left + Fx::b + Theme::c("title") + clock_speed_string + " Mhz" + Fx::ub + Theme::c("div_line") + Symbols::title_right;
+					out += Mv::to(b_y + 3, b_x + b_width/2 - 11) + Theme::c(Color::div_line) + Symbols::h_line*(5-clock_speed_string.size())
+						+ Symbols::title_left + Fx::b + Theme::c(Color::title) + clock_speed_string + " Mhz" + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right;
 				}
 			} else {
-				out += Theme::c("main_fg") + Mv::r(1);
+				out += Theme::c(Color::main_fg) + Mv::r(1);
 				if (gpu.supported_functions.mem_total)
 					out += "VRAM total:" + rjust(floating_humanizer(gpu.mem_total), b_width/(1 + gpu.supported_functions.mem_clock)-14);
 				else out += "VRAM usage:" + rjust(floating_humanizer(gpu.mem_used), b_width/(1 + gpu.supported_functions.mem_clock)-14);
@@ -1092,18 +1391,18 @@ namespace Gpu {
 		}
 
 		//? Processes section header
-		//out += Mv::to(b_y+8, b_x) + Theme::c("div_line") + Symbols::div_left + Symbols::h_line + Symbols::title_left + Theme::c("main_fg") + Fx::b + "gpu-proc" + Fx::ub + Theme::c("div_line")
+		//out += Mv::to(b_y+8, b_x) + Theme::c(Color::div_line) + Symbols::div_left + Symbols::h_line + Symbols::title_left + Theme::c(Color::main_fg) + Fx::b + "gpu-proc" + Fx::ub + Theme::c(Color::div_line)
 		//	+ Symbols::title_right + Symbols::h_line*(b_width/2-12) + Symbols::div_down + Symbols::h_line*(b_width/2-2) + Symbols::div_right;
 
 		//? PCIe link throughput
 		if (gpu.supported_functions.pcie_txrx and Config::getB("nvml_measure_pcie_speeds")) {
 			string tx_string = floating_humanizer(gpu.pcie_tx, 0, 1, 0, 1);
 			string rx_string = floating_humanizer(gpu.pcie_rx, 0, 1, 0, 1);
-			out += Mv::to(b_y + b_height_vec[index] - 1, b_x+2) + Theme::c("div_line")
-				+ Symbols::title_left_down + Theme::c("title") + Fx::b + "TX:" + Fx::ub + Theme::c("div_line") + Symbols::title_right_down + Symbols::h_line*(b_width/2-9-tx_string.size())
-				+ Symbols::title_left_down + Theme::c("title") + Fx::b + tx_string + Fx::ub + Theme::c("div_line") + Symbols::title_right_down + (gpu.supported_functions.mem_total and gpu.supported_functions.mem_used ? Symbols::div_down : Symbols::h_line)
-				+ Symbols::title_left_down + Theme::c("title") + Fx::b + "RX:" + Fx::ub + Theme::c("div_line") + Symbols::title_right_down + Symbols::h_line*(b_width/2+b_width%2-9-rx_string.size())
-				+ Symbols::title_left_down + Theme::c("title") + Fx::b + rx_string + Fx::ub + Theme::c("div_line") + Symbols::title_right_down + Symbols::round_right_down;
+			out += Mv::to(b_y + b_height_vec[index] - 1, b_x+2) + Theme::c(Color::div_line)
+				+ Symbols::title_left_down + Theme::c(Color::title) + Fx::b + "TX:" + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right_down + Symbols::h_line*(b_width/2-9-tx_string.size())
+				+ Symbols::title_left_down + Theme::c(Color::title) + Fx::b + tx_string + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right_down + (gpu.supported_functions.mem_total and gpu.supported_functions.mem_used ? Symbols::div_down : Symbols::h_line)
+				+ Symbols::title_left_down + Theme::c(Color::title) + Fx::b + "RX:" + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right_down + Symbols::h_line*(b_width/2+b_width%2-9-rx_string.size())
+				+ Symbols::title_left_down + Theme::c(Color::title) + Fx::b + rx_string + Fx::ub + Theme::c(Color::div_line) + Symbols::title_right_down + Symbols::round_right_down;
 		}
 
 		redraw[index] = false;
@@ -1120,10 +1419,13 @@ namespace Mem {
 	int mem_width, disks_width, divider, item_height, mem_size, mem_meter, graph_height, disk_meter;
 	int disks_io_h = 0;
 	int disks_io_half = 0;
-	bool shown = true, redraw = true;
+	bool shown = true, redraw = true, has_pressure = false;
 	string box;
-	std::unordered_map<string, Draw::Meter> mem_meters;
-	std::unordered_map<string, Draw::Graph> mem_graphs;
+	std::unordered_map<Field, Draw::Meter> mem_meters;
+	std::unordered_map<Field, Draw::Graph> mem_graphs;
+	std::unordered_map<Pressure::Resource, Draw::Meter> pressure_meters;
+	std::unordered_map<Pressure::Resource, Draw::Graph> pressure_graphs;
+	constexpr array pressure_resources { Pressure::Resource::memory, Pressure::Resource::io };
 	std::unordered_map<string, Draw::Meter> disk_meters_used;
 	std::unordered_map<string, Draw::Meter> disk_meters_free;
 	std::unordered_map<string, Draw::Graph> io_graphs;
@@ -1150,24 +1452,34 @@ namespace Mem {
 			out += box;
 			mem_meters.clear();
 			mem_graphs.clear();
+			pressure_meters.clear();
+			pressure_graphs.clear();
 			disk_meters_free.clear();
 			disk_meters_used.clear();
 			io_graphs.clear();
 
 			//? Mem graphs and meters
-			for (const auto& name : mem_names) {
+			for (const auto name : mem_fields) {
 
 				if (use_graphs)
-					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name, safeVal(mem.percent, name), graph_symbol};
+					mem_graphs[name] = Draw::Graph{mem_meter, graph_height, Theme::gradient_id(mem.percent.name(name)), mem.percent[name], graph_symbol};
 				else
-					mem_meters[name] = Draw::Meter{mem_meter, name};
+					mem_meters[name] = Draw::Meter{mem_meter, Theme::gradient_id(mem.percent.name(name))};
 			}
 			if (show_swap and has_swap) {
-				for (const auto& name : swap_names) {
+				for (const auto name : swap_fields) {
+					if (use_graphs)
+						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, Theme::gradient_id(mem.percent.name(name).substr(5)), mem.percent[name], graph_symbol};
+					else
+						mem_meters[name] = Draw::Meter{mem_meter, Theme::gradient_id(mem.percent.name(name).substr(5))};
+				}
+			}
+			if (has_pressure) {
+				for (const auto resource : pressure_resources) {
 					if (use_graphs)
-						mem_graphs[name] = Draw::Graph{mem_meter, graph_height, name.substr(5), safeVal(mem.percent, name), graph_symbol};
+						pressure_graphs[resource] = Draw::Graph{mem_meter, graph_height, Gradient::used, mem.pressure[resource].some.percent, graph_symbol};
 					else
-						mem_meters[name] = Draw::Meter{mem_meter, name.substr(5)};
+						pressure_meters[resource] = Draw::Meter{mem_meter, Gradient::used};
 				}
 			}
 
@@ -1196,26 +1508,27 @@ namespace Mem {
 					for (const auto& [name, disk] : mem.disks) {
 						if (disk.io_read.empty()) continue;
 
-						io_graphs[name + "_activity"] = Draw::Graph{disks_width - 6, 1, "available", disk.io_activity, graph_symbol};
+						io_graphs[name + "_activity"] = Draw::Graph{disks_width - 6, 1, Gradient::available, disk.io_activity, graph_symbol};
 
 						if (io_mode) {
 							//? Create one combined graph for IO read/write if enabled
 							long long speed = (custom_speeds.contains(name) ? custom_speeds.at(name) : 100) << 20;
 							if (io_graph_combined) {
-								deque<long long> combined(disk.io_read.size(), 0);
-								rng::transform(disk.io_read, disk.io_write, combined.begin(), std::plus<long long>());
+								RingBuffer<uint64_t> combined;
+								for (size_t i = 0; i < disk.io_read.size(); i++)
+									combined.push_back(i < disk.io_write.size() ? disk.io_read[i] + disk.io_write[i] : 0);
 								io_graphs[name] = Draw::Graph{
-									disks_width, disks_io_h, "available", combined,
+									disks_width, disks_io_h, Gradient::available, combined,
 									graph_symbol, false, true, speed};
 							}
 							else {
 								io_graphs[name + "_read"] = Draw::Graph{
-									disks_width, half_height, "free",
+									disks_width, half_height, Gradient::free,
 									disk.io_read, graph_symbol, false,
 									true, speed};
 								io_graphs[name + "_write"] = Draw::Graph{
 									disks_width, disks_io_h - half_height,
-									"used", disk.io_write, graph_symbol,
+									Gradient::used, disk.io_write, graph_symbol,
 									true, true, speed};
 							}
 						}
@@ -1224,13 +1537,13 @@ namespace Mem {
 
 				for (int i = 0; const auto& [name, ignored] : mem.disks) {
 					if (i * 2 > height - 2) break;
-					disk_meters_used[name] = Draw::Meter{disk_meter, "used"};
+					disk_meters_used[name] = Draw::Meter{disk_meter, Gradient::used};
 					if (cmp_less_equal(mem.disks.size() * 3, height - 1))
-						disk_meters_free[name] = Draw::Meter{disk_meter, "free"};
+						disk_meters_free[name] = Draw::Meter{disk_meter, Gradient::free};
 				}
 
-				out += Mv::to(y, x + width - 6) + Fx::ub + Theme::c("mem_box") + Symbols::title_left + (io_mode ? Fx::b : "") + Theme::c("hi_fg")
-				+ 'i' + Theme::c("title") + 'o' + Fx::ub + Theme::c("mem_box") + Symbols::title_right;
+				out += Mv::to(y, x + width - 6) + Fx::ub + Theme::c(Color::mem_box) + Symbols::title_left + (io_mode ? Fx::b : "") + Theme::c(Color::hi_fg)
+				+ 'i' + Theme::c(Color::title) + 'o' + Fx::ub + Theme::c(Color::mem_box) + Symbols::title_right;
 				Input::mouse_mappings["i"] = {y, x + width - 5, 1, 2};
 			}
 
@@ -1238,48 +1551,72 @@ namespace Mem {
 
 		//? Mem and swap
 		int cx = 1, cy = 1;
-		string divider = (graph_height > 0 ? Mv::l(2) + Theme::c("mem_box") + Symbols::div_left + Theme::c("div_line") + Symbols::h_line * (mem_width - 1)
-						+ (show_disks ? "" : Theme::c("mem_box")) + Symbols::div_right + Mv::l(mem_width - 1) + Theme::c("main_fg") : "");
+		string divider = (graph_height > 0 ? Mv::l(2) + Theme::c(Color::mem_box) + Symbols::div_left + Theme::c(Color::div_line) + Symbols::h_line * (mem_width - 1)
+						+ (show_disks ? "" : Theme::c(Color::mem_box)) + Symbols::div_right + Mv::l(mem_width - 1) + Theme::c(Color::main_fg) : "");
 		string up = (graph_height >= 2 ? Mv::l(mem_width - 2) + Mv::u(graph_height - 1) : "");
 		bool big_mem = mem_width > 21;
 
-		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
-		vector<string> comb_names (mem_names.begin(), mem_names.end());
-		if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_names.begin(), swap_names.end());
-		for (auto name : comb_names) {
+		out += Mv::to(y + 1, x + 2) + Theme::c(Color::title) + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c(Color::main_fg);
+		vector<Field> comb_names (mem_fields.begin(), mem_fields.end());
+		if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_fields.begin(), swap_fields.end());
+		//? A title and value with the graph or meter and percentage below, or all on one line when there is no room
+		auto draw_item = [&](const string& title, const string& value, const string& graphics, long long percent) {
+			const int offset = max(0, divider.empty() ? 9 - (int)value.size() : 0);
+			if (mem_size > 2) {
+				out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
+					+ Mv::to(y+1+cy, x+cx + mem_width - 2 - value.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + value : trans(value))
+					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(percent) + "%", 4);
+				cy += (graph_height == 0 ? 2 : graph_height + 1);
+			}
+			else {
+				out += Mv::to(y+1+cy, x+1+cx) + ljust(title, (mem_size > 1 ? 5 : 1)) + (graph_height >= 2 ? "" : " ")
+					+ graphics + Theme::c(Color::title) + rjust(value, (mem_size > 1 ? 9 : 7));
+				cy += (graph_height == 0 ? 1 : graph_height);
+			}
+		};
+
+		for (const auto name : comb_names) {
 			if (cy > height - 4) break;
 			string title;
-			if (name == "swap_used") {
+			if (name == Field::swap_used) {
 				if (cy > height - 5) break;
 				if (height - cy > 6) {
 					if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
 					cy += 1;
 				}
-				out += Mv::to(y+1+cy, x+1+cx) + Theme::c("title") + Fx::b + "Swap:" + rjust(floating_humanizer(safeVal(mem.stats, "swap_total"s)), mem_width - 8)
-					+ Theme::c("main_fg") + Fx::ub;
+				out += Mv::to(y+1+cy, x+1+cx) + Theme::c(Color::title) + Fx::b + "Swap:" + rjust(floating_humanizer(mem.stats[Field::swap_total]), mem_width - 8)
+					+ Theme::c(Color::main_fg) + Fx::ub;
 				cy += 1;
 				title = "Used";
 			}
-			else if (name == "swap_free")
+			else if (name == Field::swap_free)
 				title = "Free";
 
-			if (title.empty()) title = capitalize(name);
-			const string humanized = floating_humanizer(safeVal(mem.stats, name));
-			const int offset = max(0, divider.empty() ? 9 - (int)humanized.size() : 0);
+			if (title.empty()) title = capitalize(string(mem.stats.name(name)));
 			const string graphics = (
-				use_graphs and mem_graphs.contains(name) ? mem_graphs.at(name)(safeVal(mem.percent, name), redraw or data_same)
-				: mem_meters.contains(name) ? mem_meters.at(name)(safeVal(mem.percent, name).back())
+				use_graphs and mem_graphs.contains(name) ? mem_graphs.at(name)(mem.percent[name], redraw or data_same)
+				: mem_meters.contains(name) ? mem_meters.at(name)(mem.percent[name].back())
 				: "");
-			if (mem_size > 2) {
-				out += Mv::to(y+1+cy, x+1+cx) + divider + title.substr(0, big_mem ? 10 : 5) + ":"
-					+ Mv::to(y+1+cy, x+cx + mem_width - 2 - humanized.size()) + (divider.empty() ? Mv::l(offset) + string(" ") * offset + humanized : trans(humanized))
-					+ Mv::to(y+2+cy, x+cx + (graph_height >= 2 ? 0 : 1)) + graphics + up + rjust(to_string(safeVal(mem.percent, name).back()) + "%", 4);
-				cy += (graph_height == 0 ? 2 : graph_height + 1);
+			draw_item(title, floating_humanizer(mem.stats[name]), graphics, mem.percent[name].back());
+		}
+
+		//? Memory and io pressure, graphed by the time some tasks were stalled with the time all were stalled as the value
+		if (has_pressure and cy <= height - 5) {
+			if (height - cy > 6) {
+				if (graph_height > 0) out += Mv::to(y+1+cy, x+1+cx) + divider;
+				cy += 1;
 			}
-			else {
-				out += Mv::to(y+1+cy, x+1+cx) + ljust(title, (mem_size > 1 ? 5 : 1)) + (graph_height >= 2 ? "" : " ")
-					+ graphics + Theme::c("title") + rjust(humanized, (mem_size > 1 ? 9 : 7));
-				cy += (graph_height == 0 ? 1 : graph_height);
+			out += Mv::to(y+1+cy, x+1+cx) + Theme::c(Color::title) + Fx::b + "Pressure:" + rjust("full", mem_width - 12)
+				+ Theme::c(Color::main_fg) + Fx::ub;
+			cy += 1;
+			for (const auto resource : pressure_resources) {
+				if (cy > height - 4) break;
+				const auto& stalls = mem.pressure[resource];
+				const string graphics = (
+					use_graphs and pressure_graphs.contains(resource) ? pressure_graphs.at(resource)(stalls.some.percent, redraw or data_same)
+					: pressure_meters.contains(resource) ? pressure_meters.at(resource)(stalls.some.percent.back())
+					: "");
+				draw_item((resource == Pressure::Resource::io ? "IO" : "Memory"), to_string(stalls.full.percent.back()) + '%', graphics, stalls.some.percent.back());
 			}
 		}
 		if (graph_height > 0 and cy < height - 2)
@@ -1290,8 +1627,8 @@ namespace Mem {
 			const auto& disks = mem.disks;
 			cx = mem_width; cy = 0;
 			bool big_disk = disks_width >= 25;
-			divider = Mv::l(1) + Theme::c("div_line") + Symbols::div_left + Symbols::h_line * disks_width + Theme::c("mem_box") + Fx::ub + Symbols::div_right + Mv::l(disks_width);
-			const string hu_div = Theme::c("div_line") + Symbols::h_line + Theme::c("main_fg");
+			divider = Mv::l(1) + Theme::c(Color::div_line) + Symbols::div_left + Symbols::h_line * disks_width + Theme::c(Color::mem_box) + Fx::ub + Symbols::div_right + Mv::l(disks_width);
+			const string hu_div = Theme::c(Color::div_line) + Symbols::h_line + Theme::c(Color::main_fg);
 			if (io_mode) {
 				for (const auto& mount : mem.disks_order) {
 					if (not disks.contains(mount)) continue;
@@ -1299,15 +1636,15 @@ namespace Mem {
 					const auto& disk = safeVal(disks, mount);
 					if (disk.io_read.empty()) continue;
 					const string total = floating_humanizer(disk.total, not big_disk);
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - total.size())
+					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c(Color::title) + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - total.size())
 						+ trans(total) + Fx::ub;
 					if (big_disk) {
 						const string used_percent = to_string(disk.used_percent);
 						out += Mv::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)used_percent.size() / 2) - 1) + hu_div + used_percent + '%' + hu_div;
 					}
 					if (io_graphs.contains(mount + "_activity")) {
-					out += Mv::to(y+2+cy++, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6)
-						+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
+					out += Mv::to(y+2+cy++, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c(Color::inactive_fg) + graph_bg * (disks_width - 6)
+						+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c(Color::main_fg);
 					}
 					if (++cy > height - 3) break;
 					if (io_graph_combined) {
@@ -1317,7 +1654,7 @@ namespace Mem {
 												+ (comb_val > 0 ? Mv::r(1) + floating_humanizer(comb_val, true) : "RW");
 						if (disks_io_h == 1) out += Mv::to(y+1+cy, x+1+cx) + string(5, ' ');
 						out += Mv::to(y+1+cy, x+1+cx) + io_graphs.at(mount)({comb_val}, redraw or data_same)
-							+ Mv::to(y+1+cy, x+1+cx) + Theme::c("main_fg") + humanized;
+							+ Mv::to(y+1+cy, x+1+cx) + Theme::c(Color::main_fg) + humanized;
 						cy += disks_io_h;
 					}
 					else {
@@ -1345,15 +1682,15 @@ namespace Mem {
 					const string human_used = floating_humanizer(disk.used, not big_disk);
 					const string human_free = floating_humanizer(disk.free, not big_disk);
 
-					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c("title") + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - human_total.size())
-						+ trans(human_total) + Fx::ub + Theme::c("main_fg");
+					out += Mv::to(y+1+cy, x+1+cx) + divider + Theme::c(Color::title) + Fx::b + uresize(disk.name, disks_width - 8) + Mv::to(y+1+cy, x+cx + disks_width - human_total.size())
+						+ trans(human_total) + Fx::ub + Theme::c(Color::main_fg);
 					if (big_disk and not human_io.empty())
 						out += Mv::to(y+1+cy, x+1+cx + round((double)disks_width / 2) - round((double)human_io.size() / 2) - 1) + hu_div + human_io + hu_div;
 					if (++cy > height - 3) break;
 					if (show_io_stat and io_graphs.contains(mount + "_activity")) {
-						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c("inactive_fg") + graph_bg * (disks_width - 6) + Theme::g("available").at(clamp(disk.io_activity.back(), 50ll, 100ll))
-							+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c("main_fg");
-						if (not big_disk) out += Mv::to(y+1+cy, x+cx+1) + Theme::c("main_fg") + human_io;
+						out += Mv::to(y+1+cy, x+1+cx) + (big_disk ? " IO% " : " IO   " + Mv::l(2)) + Theme::c(Color::inactive_fg) + graph_bg * (disks_width - 6) + Theme::g(Gradient::available).at(clamp(disk.io_activity.back(), 50ll, 100ll))
+							+ Mv::l(disks_width - 6) + io_graphs.at(mount + "_activity")(disk.io_activity, redraw or data_same) + Theme::c(Color::main_fg);
+						if (not big_disk) out += Mv::to(y+1+cy, x+cx+1) + Theme::c(Color::main_fg) + human_io;
 						if (++cy > height - 3) break;
 					}
 
@@ -1387,7 +1724,7 @@ namespace Net {
 	bool shown = true, redraw = true;
 	const int MAX_IFNAMSIZ = 15;
 	string old_ip;
-	std::unordered_map<string, Draw::Graph> graphs;
+	EnumArray<Direction, Draw::Graph, direction_names> graphs;
 	string box;
 
 	string draw(const net_info& net, bool force_redraw, bool data_same) {
@@ -1404,64 +1741,65 @@ namespace Net {
 		}
 		string out;
 		out.reserve(width * height);
-		const string title_left = Theme::c("net_box") + Fx::ub + Symbols::title_left;
-		const string title_right = Theme::c("net_box") + Fx::ub + Symbols::title_right;
+		const string title_left = Theme::c(Color::net_box) + Fx::ub + Symbols::title_left;
+		const string title_right = Theme::c(Color::net_box) + Fx::ub + Symbols::title_right;
 		const int i_size = min((int)selected_iface.size(), MAX_IFNAMSIZ);
-		const long long down_max = (net_auto ? safeVal(graph_max, "download"s) : ((long long)(Config::getI("net_download")) << 20) / 8);
-		const long long up_max = (net_auto ? safeVal(graph_max, "upload"s) : ((long long)(Config::getI("net_upload")) << 20) / 8);
+		const long long down_max = (net_auto ? graph_max[Direction::download] : ((long long)(Config::getI("net_download")) << 20) / 8);
+		const long long up_max = (net_auto ? graph_max[Direction::upload] : ((long long)(Config::getI("net_upload")) << 20) / 8);
 
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out = box;
 			//? Graphs
-			graphs.clear();
-			if (safeVal(net.bandwidth, "download"s).empty() or safeVal(net.bandwidth, "upload"s).empty())
+			graphs = {};
+			if (net.bandwidth[Direction::download].empty() or net.bandwidth[Direction::upload].empty())
 				return out + Fx::reset;
-			graphs["download"] = Draw::Graph{
-				width - b_width - 2, u_graph_height, "download",
-				net.bandwidth.at("download"), graph_symbol,
+			graphs[Direction::download] = Draw::Graph{
+				width - b_width - 2, u_graph_height, Gradient::download,
+				net.bandwidth[Direction::download], graph_symbol,
 				false, true, down_max};
-			graphs["upload"] = Draw::Graph{
-				width - b_width - 2, d_graph_height, "upload",
-				net.bandwidth.at("upload"), graph_symbol, true, true, up_max};
+			graphs[Direction::upload] = Draw::Graph{
+				width - b_width - 2, d_graph_height, Gradient::upload,
+				net.bandwidth[Direction::upload], graph_symbol, true, true, up_max};
 
 			//? Interface selector and buttons
 
-			out += Mv::to(y, x+width - i_size - 9) + title_left + Fx::b + Theme::c("hi_fg") + "<b " + Theme::c("title")
-				+ uresize(selected_iface, MAX_IFNAMSIZ) + Theme::c("hi_fg") + " n>" + title_right
-				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c("hi_fg") + (safeVal(net.stat, "download"s).offset + safeVal(net.stat, "upload"s).offset > 0 ? Fx::b : "") + 'z'
-				+ Theme::c("title") + "ero" + title_right;
+			out += Mv::to(y, x+width - i_size - 9) + title_left + Fx::b + Theme::c(Color::hi_fg) + "<b " + Theme::c(Color::title)
+				+ uresize(selected_iface, MAX_IFNAMSIZ) + Theme::c(Color::hi_fg) + " n>" + title_right
+				+ Mv::to(y, x+width - i_size - 15) + title_left + Theme::c(Color::hi_fg) + (net.stat[Direction::download].offset + net.stat[Direction::upload].offset > 0 ? Fx::b : "") + 'z'
+				+ Theme::c(Color::title) + "ero" + title_right;
 			Input::mouse_mappings["b"] = {y, x+width - i_size - 8, 1, 3};
 			Input::mouse_mappings["n"] = {y, x+width - 6, 1, 3};
 			Input::mouse_mappings["z"] = {y, x+width - i_size - 14, 1, 4};
 			if (width - i_size - 20 > 6) {
-				out += Mv::to(y, x+width - i_size - 21) + title_left + Theme::c("hi_fg") + (net_auto ? Fx::b : "") + 'a' + Theme::c("title") + "uto" + title_right;
+				out += Mv::to(y, x+width - i_size - 21) + title_left + Theme::c(Color::hi_fg) + (net_auto ? Fx::b : "") + 'a' + Theme::c(Color::title) + "uto" + title_right;
 				Input::mouse_mappings["a"] = {y, x+width - i_size - 20, 1, 4};
 			}
 			if (width - i_size - 20 > 13) {
-				out += Mv::to(y, x+width - i_size - 27) + title_left + Theme::c("title") + (net_sync ? Fx::b : "") + 's' + Theme::c("hi_fg")
-					+ 'y' + Theme::c("title") + "nc" + title_right;
+				out += Mv::to(y, x+width - i_size - 27) + title_left + Theme::c(Color::title) + (net_sync ? Fx::b : "") + 's' + Theme::c(Color::hi_fg)
+					+ 'y' + Theme::c(Color::title) + "nc" + title_right;
 				Input::mouse_mappings["y"] = {y, x+width - i_size - 26, 1, 4};
 			}
 		}
 
 		//? IP or device address
 		if (not ip_addr.empty() and cmp_greater(width - i_size - 36, ip_addr.size())) {
-			out += Mv::to(y, x + 8) + title_left + Theme::c("title") + Fx::b + ip_addr + title_right;
+			out += Mv::to(y, x + 8) + title_left + Theme::c(Color::title) + Fx::b + ip_addr + title_right;
 		}
 
 		//? Graphs and stats
 		int cy = 0;
-		for (const string dir : {"download", "upload"}) {
-			out += Mv::to(y+1 + (dir == "upload" ? u_graph_height : 0), x + 1) + graphs.at(dir)(safeVal(net.bandwidth, dir), redraw or data_same or not net.connected)
-				+ Mv::to(y+1 + (dir == "upload" ? height - 3: 0), x + 1) + Fx::ub + Theme::c("graph_text")
-				+ floating_humanizer((dir == "upload" ? up_max : down_max), true);
-			const string speed = floating_humanizer(safeVal(net.stat, dir).speed, false, 0, false, true);
-			const string speed_bits = (b_width >= 20 ? floating_humanizer(safeVal(net.stat, dir).speed, false, 0, true, true) : "");
-			const string top = floating_humanizer(safeVal(net.stat, dir).top, false, 0, true, true);
-			const string total = floating_humanizer(safeVal(net.stat, dir).total);
-			const string symbol = (dir == "upload" ? "▲" : "▼");
-			out += Mv::to(b_y+1+cy, b_x+1) + Fx::ub + Theme::c("main_fg") + symbol + ' ' + ljust(speed, 10) + (b_width >= 20 ? rjust('(' + speed_bits + ')', 13) : "");
+		for (const auto dir : directions) {
+			const bool upload = (dir == Direction::upload);
+			out += Mv::to(y+1 + (upload ? u_graph_height : 0), x + 1) + graphs[dir](net.bandwidth[dir], redraw or data_same or not net.connected)
+				+ Mv::to(y+1 + (upload ? height - 3: 0), x + 1) + Fx::ub + Theme::c(Color::graph_text)
+				+ floating_humanizer((upload ? up_max : down_max), true);
+			const string speed = floating_humanizer(net.stat[dir].speed, false, 0, false, true);
+			const string speed_bits = (b_width >= 20 ? floating_humanizer(net.stat[dir].speed, false, 0, true, true) : "");
+			const string top = floating_humanizer(net.stat[dir].top, false, 0, true, true);
+			const string total = floating_humanizer(net.stat[dir].total);
+			const string symbol = (upload ? "▲" : "▼");
+			out += Mv::to(b_y+1+cy, b_x+1) + Fx::ub + Theme::c(Color::main_fg) + symbol + ' ' + ljust(speed, 10) + (b_width >= 20 ? rjust('(' + speed_bits + ')', 13) : "");
 			cy += (b_height == 5 ? 2 : 1);
 			if (b_height >= 8) {
 				out += Mv::to(b_y+1+cy, b_x+1) + symbol + ' ' + "Top: " + rjust('(' + top, (b_width >= 20 ? 17 : 9)) + ')';
@@ -1488,8 +1826,17 @@ namespace Proc {
 	int selected_pid = 0, selected_depth = 0;
 	string selected_name;
 	std::unordered_map<size_t, Draw::Graph> p_graphs;
-	std::unordered_map<size_t, bool> p_wide_cmd;
 	std::unordered_map<size_t, int> p_counters;
+
+	//* Uncolored text of the columns that only change with the process itself or the column sizes,
+	//* <name>, <cmd>, <user> and <prefix> are the values the columns were made from
+	struct RowText {
+		string name, cmd, user, prefix;
+		bool tree = false, tree_name = false;
+		string pid_col, name_col, cmd_col, user_col;
+		int tree_pad = 0;
+	};
+	std::unordered_map<size_t, RowText> p_rows;
 	int counter = 0;
 	Draw::TextEdit filter;
 	Draw::Graph detailed_cpu_graph;
@@ -1563,7 +1910,7 @@ namespace Proc {
 		if (Runner::stopping) return "";
 		auto proc_tree = Config::getB("proc_tree");
 		bool show_detailed = (Config::getB("show_detailed") and cmp_equal(Proc::detailed.last_pid, Config::getI("detailed_pid")));
-		bool proc_gradient = (Config::getB("proc_gradient") and not g_CfgMgr.get<CfgB>("lowcolor").v() and Theme::gradients.contains("proc"));
+		bool proc_gradient = (Config::getB("proc_gradient") and not g_CfgMgr.get<CfgB>("lowcolor").v() and Theme::has_gradient(Gradient::proc));
 		auto proc_colors = Config::getB("proc_colors");
 		auto tty_mode = Config::getB("tty_mode");
 		auto& graph_symbol = (tty_mode ? "tty" : Config::getS("graph_symbol_proc"));
@@ -1585,14 +1932,15 @@ namespace Proc {
 		//* Redraw elements not needed to be updated every cycle
 		if (redraw) {
 			out = box;
-			const string title_left = Theme::c("proc_box") + Symbols::title_left;
-			const string title_right = Theme::c("proc_box") + Symbols::title_right;
-			const string title_left_down = Theme::c("proc_box") + Symbols::title_left_down;
-			const string title_right_down = Theme::c("proc_box") + Symbols::title_right_down;
+			const string title_left = Theme::c(Color::proc_box) + Symbols::title_left;
+			const string title_right = Theme::c(Color::proc_box) + Symbols::title_right;
+			const string title_left_down = Theme::c(Color::proc_box) + Symbols::title_left_down;
+			const string title_right_down = Theme::c(Color::proc_box) + Symbols::title_right_down;
 			for (const auto& key : {"T", "K", "S", "enter"})
 				if (Input::mouse_mappings.contains(key)) Input::mouse_mappings.erase(key);
 
 			//? Adapt sizes of text fields
+			p_rows.clear();
 			user_size = (width < 75 ? 5 : 10);
 			thread_size = (width < 75 ? - 1 : 4);
 			prog_size = (width > 70 ? 16 : ( width > 55 ? 8 : width - user_size - thread_size - 33));
@@ -1614,24 +1962,24 @@ namespace Proc {
 
 				//? Create cpu and mem graphs if process is alive
 				if (alive) {
-					detailed_cpu_graph = Draw::Graph{dgraph_width - 1, 7, "cpu", detailed.cpu_percent, graph_symbol, false, true};
-					detailed_mem_graph = Draw::Graph{d_width / 3, 1, "", detailed.mem_bytes, graph_symbol, false, false, detailed.first_mem};
+					detailed_cpu_graph = Draw::Graph{dgraph_width - 1, 7, Gradient::cpu, detailed.cpu_percent, graph_symbol, false, true};
+					detailed_mem_graph = Draw::Graph{d_width / 3, 1, Gradient::none, detailed.mem_bytes, graph_symbol, false, false, detailed.first_mem};
 				}
 
 				//? Draw structure of details box
 				const string pid_str = to_string(detailed.entry.pid);
-				out += Mv::to(y, x) + Theme::c("proc_box") + Symbols::div_left + Symbols::h_line + title_left + Theme::c("hi_fg") + Fx::b
-				+ (tty_mode ? "4" : Symbols::superscript.at(4)) + Theme::c("title") + "proc"
+				out += Mv::to(y, x) + Theme::c(Color::proc_box) + Symbols::div_left + Symbols::h_line + title_left + Theme::c(Color::hi_fg) + Fx::b
+				+ (tty_mode ? "4" : Symbols::superscript.at(4)) + Theme::c(Color::title) + "proc"
 					+ Fx::ub + title_right + Symbols::h_line * (width - 10) + Symbols::div_right
-					+ Mv::to(d_y, dgraph_x + 2) + title_left + Fx::b + Theme::c("title") + pid_str + Fx::ub + title_right
-					+ title_left + Fx::b + Theme::c("title") + uresize(detailed.entry.name, dgraph_width - pid_str.size() - 7, true) + Fx::ub + title_right;
+					+ Mv::to(d_y, dgraph_x + 2) + title_left + Fx::b + Theme::c(Color::title) + pid_str + Fx::ub + title_right
+					+ title_left + Fx::b + Theme::c(Color::title) + uresize(detailed.entry.name, dgraph_width - pid_str.size() - 7, true) + Fx::ub + title_right;
 
-				out += Mv::to(d_y, d_x - 1) + Theme::c("proc_box") + Symbols::div_up + Mv::to(y, d_x - 1) + Symbols::div_down + Theme::c("div_line");
+				out += Mv::to(d_y, d_x - 1) + Theme::c(Color::proc_box) + Symbols::div_up + Mv::to(y, d_x - 1) + Symbols::div_down + Theme::c(Color::div_line);
 				for (const int& i : iota(1, 8)) out += Mv::to(d_y + i, d_x - 1) + Symbols::v_line;
 
-				const string& t_color = (not alive or selected > 0 ? Theme::c("inactive_fg") : Theme::c("title"));
-				const string& hi_color = (not alive or selected > 0 ? t_color : Theme::c("hi_fg"));
-				const string hide = (selected > 0 ? t_color + "hide " : Theme::c("title") + "hide " + Theme::c("hi_fg"));
+				const string& t_color = (not alive or selected > 0 ? Theme::c(Color::inactive_fg) : Theme::c(Color::title));
+				const string& hi_color = (not alive or selected > 0 ? t_color : Theme::c(Color::hi_fg));
+				const string hide = (selected > 0 ? t_color + "hide " : Theme::c(Color::title) + "hide " + Theme::c(Color::hi_fg));
 				int mouse_x = d_x + 2;
 				out += Mv::to(d_y, d_x + 1);
 				if (width > 55) {
@@ -1652,7 +2000,7 @@ namespace Proc {
 				//? Labels
 				const int item_fit = floor((double)(d_width - 2) / 10);
 				const int item_width = floor((double)(d_width - 2) / min(item_fit, 8));
-				out += Mv::to(d_y + 1, d_x + 1) + Fx::b + Theme::c("title")
+				out += Mv::to(d_y + 1, d_x + 1) + Fx::b + Theme::c(Color::title)
 										+ cjust("Status:", item_width)
 										+ cjust("Elapsed:", item_width);
 				if (item_fit >= 3) out += cjust("IO/R:", item_width);
@@ -1667,7 +2015,7 @@ namespace Proc {
 				for (int i = 0; const auto& l : {'C', 'M', 'D'})
 				out += Mv::to(d_y + 5 + i++, d_x + 1) + l;
 
-				out += Theme::c("main_fg") + Fx::ub;
+				out += Theme::c(Color::main_fg) + Fx::ub;
 				const int cmd_size = ulen(detailed.entry.cmd, true);
 				for (int num_lines = min(3, (int)ceil((double)cmd_size / (d_width - 5))), i = 0; i < num_lines; i++) {
 					out += Mv::to(d_y + 5 + (num_lines == 1 ? 1 : i), d_x + 3)
@@ -1679,10 +2027,10 @@ namespace Proc {
 			//? Filter
 			auto filtering = Config::getB("proc_filtering"); // ? filter(20) : Config::getS("proc_filter"))
 			const auto filter_text = (filtering) ? filter(max(6, width - 58)) : uresize(Config::getS("proc_filter"), max(6, width - 58));
-			out += Mv::to(y, x+9) + title_left + (not filter_text.empty() ? Fx::b : "") + Theme::c("hi_fg") + 'f'
-				+ Theme::c("title") + (not filter_text.empty() ? ' ' + filter_text : "ilter")
-				+ (not filtering and not filter_text.empty() ? Theme::c("hi_fg") + " del" : "")
-				+ (filtering ? Theme::c("hi_fg") + ' ' + Symbols::enter : "") + Fx::ub + title_right;
+			out += Mv::to(y, x+9) + title_left + (not filter_text.empty() ? Fx::b : "") + Theme::c(Color::hi_fg) + 'f'
+				+ Theme::c(Color::title) + (not filter_text.empty() ? ' ' + filter_text : "ilter")
+				+ (not filtering and not filter_text.empty() ? Theme::c(Color::hi_fg) + " del" : "")
+				+ (filtering ? Theme::c(Color::hi_fg) + ' ' + Symbols::enter : "") + Fx::ub + title_right;
 			if (not filtering) {
 				int f_len = (filter_text.empty() ? 6 : ulen(filter_text) + 2);
 				Input::mouse_mappings["f"] = {y, x + 10, 1, f_len};
@@ -1698,31 +2046,31 @@ namespace Proc {
 			const int sort_pos = x + width - sort_len - 8;
 
 			if (width > 55 + sort_len) {
-				out += Mv::to(y, sort_pos - 25) + title_left + (Config::getB("proc_per_core") ? Fx::b : "") + Theme::c("title")
-					+ "per-" + Theme::c("hi_fg") + 'c' + Theme::c("title") + "ore" + Fx::ub + title_right;
+				out += Mv::to(y, sort_pos - 25) + title_left + (Config::getB("proc_per_core") ? Fx::b : "") + Theme::c(Color::title)
+					+ "per-" + Theme::c(Color::hi_fg) + 'c' + Theme::c(Color::title) + "ore" + Fx::ub + title_right;
 				Input::mouse_mappings["c"] = {y, sort_pos - 24, 1, 8};
 			}
 			if (width > 45 + sort_len) {
-				out += Mv::to(y, sort_pos - 15) + title_left + (Config::getB("proc_reversed") ? Fx::b : "") + Theme::c("hi_fg")
-					+ 'r' + Theme::c("title") + "everse" + Fx::ub + title_right;
+				out += Mv::to(y, sort_pos - 15) + title_left + (Config::getB("proc_reversed") ? Fx::b : "") + Theme::c(Color::hi_fg)
+					+ 'r' + Theme::c(Color::title) + "everse" + Fx::ub + title_right;
 				Input::mouse_mappings["r"] = {y, sort_pos - 14, 1, 7};
 			}
 			if (width > 35 + sort_len) {
-				out += Mv::to(y, sort_pos - 6) + title_left + (Config::getB("proc_tree") ? Fx::b : "") + Theme::c("title") + "tre"
-					+ Theme::c("hi_fg") + 'e' + Fx::ub + title_right;
+				out += Mv::to(y, sort_pos - 6) + title_left + (Config::getB("proc_tree") ? Fx::b : "") + Theme::c(Color::title) + "tre"
+					+ Theme::c(Color::hi_fg) + 'e' + Fx::ub + title_right;
 				Input::mouse_mappings["e"] = {y, sort_pos - 5, 1, 4};
 			}
-			out += Mv::to(y, sort_pos) + title_left + Fx::b + Theme::c("hi_fg") + "< " + Theme::c("title") + sorting + Theme::c("hi_fg")
+			out += Mv::to(y, sort_pos) + title_left + Fx::b + Theme::c(Color::hi_fg) + "< " + Theme::c(Color::title) + sorting + Theme::c(Color::hi_fg)
 				+ " >" + Fx::ub + title_right;
 				Input::mouse_mappings["left"] = {y, sort_pos + 1, 1, 2};
 				Input::mouse_mappings["right"] = {y, sort_pos + sort_len + 3, 1, 2};
 
 			//? select, info and signal buttons
-			const string down_button = (selected == select_max and start == numpids - select_max ? Theme::c("inactive_fg") : Theme::c("hi_fg")) + Symbols::down;
-			const string t_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("title"));
-			const string hi_color = (selected == 0 ? Theme::c("inactive_fg") : Theme::c("hi_fg"));
+			const string down_button = (selected == select_max and start == numpids - select_max ? Theme::c(Color::inactive_fg) : Theme::c(Color::hi_fg)) + Symbols::down;
+			const string t_color = (selected == 0 ? Theme::c(Color::inactive_fg) : Theme::c(Color::title));
+			const string hi_color = (selected == 0 ? Theme::c(Color::inactive_fg) : Theme::c(Color::hi_fg));
 			int mouse_x = x + 14;
-			out += Mv::to(y + height - 1, x + 1) + title_left_down + Fx::b + hi_color + Symbols::up + Theme::c("title") + " select " + down_button + Fx::ub + title_right_down
+			out += Mv::to(y + height - 1, x + 1) + title_left_down + Fx::b + hi_color + Symbols::up + Theme::c(Color::title) + " select " + down_button + Fx::ub + title_right_down
 				+ title_left_down + Fx::b + t_color + "info " + hi_color + Symbols::enter + Fx::ub + title_right_down;
 				if (selected > 0) Input::mouse_mappings["enter"] = {y + height - 1, mouse_x, 1, 6};
 				mouse_x += 8;
@@ -1741,12 +2089,12 @@ namespace Proc {
 
 			//? Labels for fields in list
 			if (not proc_tree)
-				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
+				out += Mv::to(y+1, x+1) + Theme::c(Color::title) + Fx::b
 					+ rjust("Pid:", 8) + ' '
 					+ ljust("Program:", prog_size) + ' '
 					+ (cmd_size > 0 ? ljust("Command:", cmd_size) : "") + ' ';
 			else
-				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
+				out += Mv::to(y+1, x+1) + Theme::c(Color::title) + Fx::b
 					+ ljust("Tree:", tree_size) + ' ';
 
 			out += (thread_size > 0 ? Mv::l(4) + "Threads: " : "")
@@ -1769,14 +2117,14 @@ namespace Proc {
 				cpu_str += '%';
 			}
 			out += Mv::to(d_y + 1, dgraph_x + 1) + Fx::ub + detailed_cpu_graph(detailed.cpu_percent, (redraw or data_same or not alive))
-				+ Mv::to(d_y + 1, dgraph_x + 1) + Theme::c("title") + Fx::b + cpu_str;
+				+ Mv::to(d_y + 1, dgraph_x + 1) + Theme::c(Color::title) + Fx::b + cpu_str;
 			for (int i = 0; const auto& l : {'C', 'P', 'U'})
 					out += Mv::to(d_y + 3 + i++, dgraph_x + 1) + l;
 
 			//? Info part of box
-			const string stat_color = (not alive ? Theme::c("inactive_fg") : (detailed.status == "Running" ? Theme::c("proc_misc") : Theme::c("main_fg")));
+			const string stat_color = (not alive ? Theme::c(Color::inactive_fg) : (detailed.status == "Running" ? Theme::c(Color::proc_misc) : Theme::c(Color::main_fg)));
 			out += Mv::to(d_y + 2, d_x + 1) + stat_color + Fx::ub
-									+ cjust(detailed.status, item_width) + Theme::c("main_fg")
+									+ cjust(detailed.status, item_width) + Theme::c(Color::main_fg)
 									+ cjust(detailed.elapsed, item_width);
 			if (item_fit >= 3) out += cjust(detailed.io_read, item_width);
 			if (item_fit >= 4) out += cjust(detailed.io_write, item_width);
@@ -1789,10 +2137,10 @@ namespace Proc {
 			const double mem_p = (double)detailed.mem_bytes.back() * 100 / totalMem;
 			string mem_str = to_string(mem_p);
 			mem_str.resize((mem_p < 10 or mem_p >= 100 ? 3 : 4));
-			out += Mv::to(d_y + 4, d_x + 1) + Theme::c("title") + Fx::b + rjust((item_fit > 4 ? "Memory: " : "M:") + mem_str + "% ", (d_width / 3) - 2)
-				+ Theme::c("inactive_fg") + Fx::ub + graph_bg * (d_width / 3) + Mv::l(d_width / 3)
-				+ Theme::c("proc_misc") + detailed_mem_graph(detailed.mem_bytes, (redraw or data_same or not alive)) + ' '
-				+ Theme::c("title") + Fx::b + detailed.memory;
+			out += Mv::to(d_y + 4, d_x + 1) + Theme::c(Color::title) + Fx::b + rjust((item_fit > 4 ? "Memory: " : "M:") + mem_str + "% ", (d_width / 3) - 2)
+				+ Theme::c(Color::inactive_fg) + Fx::ub + graph_bg * (d_width / 3) + Mv::l(d_width / 3)
+				+ Theme::c(Color::proc_misc) + detailed_mem_graph(detailed.mem_bytes, (redraw or data_same or not alive)) + ' '
+				+ Theme::c(Color::title) + Fx::b + detailed.memory;
 		}
 
 		//? Check bounds of current selection and view
@@ -1820,7 +2168,7 @@ namespace Proc {
 			bool has_graph = show_graphs ? p_counters.contains(p.pid) : false;
 			if (show_graphs and ((p.cpu_p > 0 and not has_graph) or (not data_same and has_graph))) {
 				if (not has_graph) {
-					p_graphs[p.pid] = Draw::Graph{5, 1, "", {}, graph_symbol};
+					p_graphs[p.pid] = Draw::Graph{5, 1, Gradient::none, graph_symbol};
 					p_counters[p.pid] = 0;
 				}
 				else if (p.cpu_p < 0.1 and ++p_counters[p.pid] >= 10) {
@@ -1838,21 +2186,21 @@ namespace Proc {
 			if (is_selected) {
 				c_color = m_color = t_color = g_color = Fx::b;
 				end = Fx::ub;
-				out += Theme::c("selected_bg") + Theme::c("selected_fg") + Fx::b;
+				out += Theme::c(Color::selected_bg) + Theme::c(Color::selected_fg) + Fx::b;
 			}
 			else {
 				int calc = (selected > lc) ? selected - lc : lc - selected;
 				if (proc_colors) {
-					end = Theme::c("main_fg") + Fx::ub;
+					end = Theme::c(Color::main_fg) + Fx::ub;
 					array<string, 3> colors;
 					for (int i = 0; int v : {(int)round(p.cpu_p), (int)round(p.mem * 100 / totalMem), (int)p.threads / 3}) {
 						if (proc_gradient) {
 							int val = (min(v, 100) + 100) - calc * 100 / select_max;
-							if (val < 100) colors[i++] = Theme::g("proc_color").at(max(0, val));
-							else colors[i++] = Theme::g("process").at(clamp(val - 100, 0, 100));
+							if (val < 100) colors[i++] = Theme::g(Gradient::proc_color).at(max(0, val));
+							else colors[i++] = Theme::g(Gradient::process).at(clamp(val - 100, 0, 100));
 						}
 						else
-							colors[i++] = Theme::g("process").at(clamp(v, 0, 100));
+							colors[i++] = Theme::g(Gradient::process).at(clamp(v, 0, 100));
 					}
 					c_color = colors.at(0); m_color = colors.at(1); t_color = colors.at(2);
 				}
@@ -1861,56 +2209,98 @@ namespace Proc {
 					end = Fx::ub;
 				}
 				if (proc_gradient) {
-					g_color = Theme::g("proc").at(clamp(calc * 100 / select_max, 0, 100));
+					g_color = Theme::g(Gradient::proc).at(clamp(calc * 100 / select_max, 0, 100));
 				}
 			}
 
-			if (not p_wide_cmd.contains(p.pid)) p_wide_cmd[p.pid] = ulen(p.cmd) != ulen(p.cmd, true);
+			//? Rebuild the text columns only if the process, its tree prefix or the view changed since they were made
+			auto& row = p_rows[p.pid];
+			if (row.pid_col.empty() or row.tree != proc_tree or row.name != p.name or row.cmd != p.cmd or row.user != p.user
+			or (proc_tree and row.prefix != p.prefix)) {
+				row.name = p.name;
+				row.cmd = p.cmd;
+				row.user = p.user;
+				row.prefix = p.prefix;
+				row.tree = proc_tree;
+				const bool wide_cmd = ulen(p.cmd) != ulen(p.cmd, true);
+				if (not proc_tree) {
+					row.pid_col = rjust(to_string(p.pid), 8) + ' ';
+					row.name_col = ljust(p.name, prog_size, true) + ' ';
+					row.cmd_col = (cmd_size > 0 ? ljust(p.cmd, cmd_size, true, wide_cmd) : "");
+				}
+				else {
+					const string prefix_pid = p.prefix + to_string(p.pid);
+					int width_left = tree_size;
+					row.pid_col = uresize(prefix_pid, width_left) + ' ';
+					row.name_col.clear();
+					row.cmd_col.clear();
+					width_left -= ulen(prefix_pid);
+					row.tree_name = (width_left > 0);
+					if (row.tree_name) {
+						row.name_col = uresize(p.name, width_left - 1);
+						width_left -= (ulen(p.name) + 1);
+					}
+					if (width_left > 7) {
+						const string& cmd = width_left > 40 ? rtrim(p.cmd) : p.short_cmd;
+						if (not cmd.empty() and cmd != p.name) {
+							row.cmd_col = '(' + uresize(cmd, width_left - 3, wide_cmd) + ") ";
+							width_left -= (ulen(cmd, true) + 3);
+						}
+					}
+					row.tree_pad = max(0, width_left);
+				}
+				row.user_col = ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' ';
+			}
 
 			//? Normal view line
 			if (not proc_tree) {
 				out += Mv::to(y+2+lc, x+1)
-					+ g_color + rjust(to_string(p.pid), 8) + ' '
-					+ c_color + ljust(p.name, prog_size, true) + ' ' + end
-					+ (cmd_size > 0 ? g_color + ljust(p.cmd, cmd_size, true, p_wide_cmd[p.pid]) + Mv::to(y+2+lc, x+11+prog_size+cmd_size) + ' ' : "");
+					+ g_color + row.pid_col
+					+ c_color + row.name_col + end
+					+ (cmd_size > 0 ? g_color + row.cmd_col + Mv::to(y+2+lc, x+11+prog_size+cmd_size) + ' ' : "");
 			}
 			//? Tree view line
 			else {
-				const string prefix_pid = p.prefix + to_string(p.pid);
-				int width_left = tree_size;
-				out += Mv::to(y+2+lc, x+1) + g_color + uresize(prefix_pid, width_left) + ' ';
-				width_left -= ulen(prefix_pid);
-				if (width_left > 0) {
-					out += c_color + uresize(p.name, width_left - 1) + end + ' ';
-					width_left -= (ulen(p.name) + 1);
-				}
-				if (width_left > 7) {
-					const string& cmd = width_left > 40 ? rtrim(p.cmd) : p.short_cmd;
-					if (not cmd.empty() and cmd != p.name) {
-						out += g_color + '(' + uresize(cmd, width_left - 3, p_wide_cmd[p.pid]) + ") ";
-						width_left -= (ulen(cmd, true) + 3);
-					}
+				out += Mv::to(y+2+lc, x+1) + g_color + row.pid_col;
+				if (row.tree_name)
+					out += c_color + row.name_col + end + ' ';
+				if (not row.cmd_col.empty())
+					out += g_color + row.cmd_col;
+				out += string(row.tree_pad, ' ') + Mv::to(y+2+lc, x+2+tree_size);
+			}
+			//? Common end of line, cpu and mem columns are formatted into stack buffers
+			array<char, 32> cpu_buf;
+			size_t cpu_len;
+			if (p.cpu_p >= 10'000) {
+				cpu_len = std::min<size_t>(fmt::format_to_n(cpu_buf.data(), 3, FMT_COMPILE("{:f}"), p.cpu_p / 1000).size, 3);
+				if (cpu_buf[cpu_len - 1] == '.') cpu_len--;
+				cpu_buf[cpu_len++] = 'k';
+			}
+			else {
+				cpu_len = std::min(fmt::format_to_n(cpu_buf.data(), cpu_buf.size(), FMT_COMPILE("{:f}"), p.cpu_p).size, cpu_buf.size());
+				if (p.cpu_p < 10 or (p.cpu_p >= 100 and p.cpu_p < 1000)) cpu_len = std::min<size_t>(cpu_len, 3);
+			}
+
+			array<char, humanize_max> mem_buf;
+			size_t mem_len;
+			if (mem_bytes)
+				mem_len = humanize(mem_buf.data(), p.mem, true);
+			else {
+				const double mem_p = clamp((double)p.mem * 100 / totalMem, 0.0, 100.0);
+				if (fmt::format_to_n(mem_buf.data(), 4, FMT_COMPILE("{:f}"), mem_p).size < 4) {
+					mem_buf[0] = '0';
+					mem_len = 1;
 				}
-				out += string(max(0, width_left), ' ') + Mv::to(y+2+lc, x+2+tree_size);
-			}
-			//? Common end of line
-			string cpu_str = to_string(p.cpu_p);
-			if (p.cpu_p < 10 or (p.cpu_p >= 100 and p.cpu_p < 1000)) cpu_str.resize(3);
-			else if (p.cpu_p >= 10'000) {
-				cpu_str = to_string(p.cpu_p / 1000);
-				cpu_str.resize(3);
-				if (cpu_str.ends_with('.')) cpu_str.pop_back();
-				cpu_str += "k";
-			}
-			string mem_str = (mem_bytes ? floating_humanizer(p.mem, true) : "");
-			if (not mem_bytes) {
-				double mem_p = clamp((double)p.mem * 100 / totalMem, 0.0, 100.0);
-				mem_str = to_string(mem_p);
-				if (mem_str.size() < 4)	mem_str = "0";
-				else mem_str.resize((mem_p < 10 or mem_p >= 100 ? 3 : 4));
-				mem_str += '%';
+				else mem_len = (mem_p < 10 or mem_p >= 100 ? 3 : 4);
+				mem_buf[mem_len++] = '%';
 			}
 
+			//? Same as rjust() with limit, appended straight to out
+			const auto put_rjust = [&out](const char* str, size_t len, size_t x) {
+				len = std::min(len, x);
+				out.append(x - len, ' ').append(str, len);
+			};
+
 			// Shorten process thread representation when larger than 5 digits: 10000 -> 10K ...
 			const std::string proc_threads_string = [&] {
 				if (p.threads > 9999) {
@@ -1921,11 +2311,14 @@ namespace Proc {
 			}();
 
 			out += (thread_size > 0 ? t_color + rjust(proc_threads_string, thread_size) + ' ' + end : "" )
-				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
-				+ m_color + rjust(mem_str, 5) + end + ' '
-				+ (is_selected ? "" : Theme::c("inactive_fg")) + (show_graphs ? graph_bg * 5: "")
-				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
-				+ c_color + rjust(cpu_str, 4) + "  " + end;
+				+ g_color + row.user_col + m_color;
+			put_rjust(mem_buf.data(), mem_len, 5);
+			out += end + ' '
+				+ (is_selected ? "" : Theme::c(Color::inactive_fg)) + (show_graphs ? graph_bg * 5: "")
+				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)((p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p)), data_same) : "") + end + ' '
+				+ c_color;
+			put_rjust(cpu_buf.data(), cpu_len, 4);
+			out += "  " + end;
 			if (lc++ > height - 5) break;
 		}
 
@@ -1935,7 +2328,7 @@ namespace Proc {
 		//? Draw scrollbar if needed
 		if (numpids > select_max) {
 			const int scroll_pos = clamp((int)round((double)start * select_max / (numpids - select_max)), 0, height - 5);
-			out += Mv::to(y + 1, x + width - 2) + Fx::b + Theme::c("main_fg") + Symbols::up
+			out += Mv::to(y + 1, x + width - 2) + Fx::b + Theme::c(Color::main_fg) + Symbols::up
 				+ Mv::to(y + height - 2, x + width - 2) + Symbols::down;
 
 			for (int i = y + 2; i < y + height - 2; i++) {
@@ -1946,8 +2339,8 @@ namespace Proc {
 		//? Current selection and number of processes
 		string location = to_string(start + selected) + '/' + to_string(numpids);
 		string loc_clear = Symbols::h_line * max((size_t)0, 9 - location.size());
-		out += Mv::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) + Fx::ub + Theme::c("proc_box") + loc_clear
-			+ Symbols::title_left_down + Theme::c("title") + Fx::b + location + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
+		out += Mv::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) + Fx::ub + Theme::c(Color::proc_box) + loc_clear
+			+ Symbols::title_left_down + Theme::c(Color::title) + Fx::b + location + Fx::ub + Theme::c(Color::proc_box) + Symbols::title_right_down;
 
 		//? Clear out left over graphs from dead processes at a regular interval
 		if (not data_same and ++counter >= 100) {
@@ -1961,7 +2354,7 @@ namespace Proc {
 				return rng::find(plist, pair.first, &proc_info::pid) == plist.end();
 			});
 
-			std::erase_if(p_wide_cmd, [&](const auto& pair) {
+			std::erase_if(p_rows, [&](const auto& pair) {
 				return rng::find(plist, pair.first, &proc_info::pid) == plist.end();
 			});
 		}
@@ -1996,6 +2389,7 @@ namespace Draw {
 		Runner::redraw = true;
 		Proc::p_counters.clear();
 		Proc::p_graphs.clear();
+		Proc::p_rows.clear();
 		if (Menu::active) Menu::redraw = true;
 
 		Input::mouse_mappings.clear();
@@ -2050,39 +2444,54 @@ namespace Draw {
 			x = 1;
 			y = cpu_bottom ? Term::height - height + 1 : 1;
 
+			//? Rows in the core area, the groups of a grouped view or the cores of the group drilled into
+			const string core_view = g_CfgMgr.get<CfgS>("cpu_core_view").v();
+			const auto cpu_view = get_core_view(core_view);
+			int core_rows = Shared::coreCount;
+			//? Scheduler activity takes a line below the load average
+			const int sched_line = g_CfgMgr.get<CfgB>("cpu_sched_stats").v();
+			if (cpu_view == CoreView::grouped) {
+				const auto& sizes = group_sizes.at(core_view);
+				core_rows = (drill_group >= 0 and cmp_less(drill_group, sizes.size()) ? sizes.at(drill_group) : sizes.size());
+			}
 		#ifdef GPU_SUPPORT
-			b_columns = max(2, (int)ceil((double)(Shared::coreCount + 1) / (height - gpus_extra_height - 5)));
+			b_columns = max(2, (int)ceil((double)(core_rows + 1) / (height - gpus_extra_height - 5 - sched_line)));
 		#else
-			b_columns = max(1, (int)ceil((double)(Shared::coreCount + 1) / (height - 5)));
+			b_columns = max(1, (int)ceil((double)(core_rows + 1) / (height - 5 - sched_line)));
 		#endif
-			if (b_columns * (21 + 12 * show_temp) < width - (width / 3)) {
+			//? Performance counters take a value of 4 characters after the core percentage
+			const int counters_width = (has_counters ? 5 : 0);
+			if (b_columns * (21 + 12 * show_temp + counters_width) < width - (width / 3)) {
 				b_column_size = 2;
-				b_width = (21 + 12 * show_temp) * b_columns - (b_columns - 1);
+				b_width = (21 + 12 * show_temp + counters_width) * b_columns - (b_columns - 1);
 			}
-			else if (b_columns * (15 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (15 + 6 * show_temp + counters_width) < width - (width / 3)) {
 				b_column_size = 1;
-				b_width = (15 + 6 * show_temp) * b_columns - (b_columns - 1);
+				b_width = (15 + 6 * show_temp + counters_width) * b_columns - (b_columns - 1);
 			}
-			else if (b_columns * (8 + 6 * show_temp) < width - (width / 3)) {
+			else if (b_columns * (8 + 6 * show_temp + counters_width) < width - (width / 3)) {
 				b_column_size = 0;
 			}
 			else {
-				b_columns = (width - width / 3) / (8 + 6 * show_temp);
+				b_columns = (width - width / 3) / (8 + 6 * show_temp + counters_width);
 				b_column_size = 0;
 			}
 
-			if (b_column_size == 0) b_width = (8 + 6 * show_temp) * b_columns + 1;
+			if (b_column_size == 0) b_width = (8 + 6 * show_temp + counters_width) * b_columns + 1;
+			//? The heatmap has one cell per core across the width the core rows would have taken
+			const int area_rows = (cpu_view == CoreView::heatmap
+				? (Shared::coreCount + b_width - 3) / (b_width - 2) : (int)ceil((double)core_rows / b_columns));
 		#ifdef GPU_SUPPORT
 			//gpus_extra_height = max(0, gpus_extra_height - 1);
-			b_height = min(height - 2, (int)ceil((double)Shared::coreCount / b_columns) + 4 + gpus_extra_height);
+			b_height = min(height - 2, area_rows + 4 + sched_line + gpus_extra_height);
 		#else
-			b_height = min(height - 2, (int)ceil((double)Shared::coreCount / b_columns) + 4);
+			b_height = min(height - 2, area_rows + 4 + sched_line);
 		#endif
 
 			b_x = x + width - b_width - 1;
 			b_y = y + ceil((double)(height - 2) / 2) - ceil((double)b_height / 2) + 1;
 
-			box = createBox(x, y, width, height, Theme::c("cpu_box"), true, (cpu_bottom ? "" : "cpu"), (cpu_bottom ? "cpu" : ""), 1);
+			box = createBox(x, y, width, height, Theme::c(Color::cpu_box), true, (cpu_bottom ? "" : "cpu"), (cpu_bottom ? "cpu" : ""), 1);
 
 			auto& custom = Config::getS("custom_cpu_name");
 			static const bool hasCpuHz = not Cpu::get_cpuHz().empty();
@@ -2123,7 +2532,7 @@ namespace Draw {
 
 				height += (height+Cpu::height == Term::height-1);
 				x_vec[i] = 1; y_vec[i] = 1 + i*height + (not Config::getB("cpu_bottom"))*Cpu::shown*Cpu::height;
-				box[i] = createBox(x_vec[i], y_vec[i], width, height, Theme::c("cpu_box"), true, std::string("gpu") + (char)(shown_panels[i]+'0'), "", (shown_panels[i]+5)%10); // TODO gpu_box
+				box[i] = createBox(x_vec[i], y_vec[i], width, height, Theme::c(Color::cpu_box), true, std::string("gpu") + (char)(shown_panels[i]+'0'), "", (shown_panels[i]+5)%10); // TODO gpu_box
 
 				b_height_vec[i] = 2 + gpu_b_height_offsets[shown_panels[i]];
 				b_width = clamp(width/2, min_width, 64);
@@ -2174,8 +2583,10 @@ namespace Draw {
 			else
 				mem_width = width - 1;
 
-			item_height = has_swap and not swap_disk ? 6 : 4;
-			if (height - (has_swap and not swap_disk ? 3 : 2) > 2 * item_height)
+			//? Swap and pressure each add a title line and two items
+			const int sections = (has_swap and not swap_disk) + has_pressure;
+			item_height = 4 + 2 * sections;
+			if (height - 2 - sections > 2 * item_height)
 				mem_size = 3;
 			else if (mem_width > 25)
 				mem_size = 2;
@@ -2186,7 +2597,7 @@ namespace Draw {
 			if (mem_size == 1) mem_meter += 6;
 
 			if (mem_graphs) {
-				graph_height = max(1, (int)round((double)((height - (has_swap and not swap_disk ? 2 : 1)) - (mem_size == 3 ? 2 : 1) * item_height) / item_height));
+				graph_height = max(1, (int)round((double)((height - 1 - sections) - (mem_size == 3 ? 2 : 1) * item_height) / item_height));
 				if (graph_height > 1) mem_meter += 6;
 			}
 			else
@@ -2197,12 +2608,12 @@ namespace Draw {
 				if (disks_width < 25) disk_meter += 14;
 			}
 
-			box = createBox(x, y, width, height, Theme::c("mem_box"), true, "mem", "", 2);
-			box += Mv::to(y, (show_disks ? divider + 2 : x + width - 9)) + Theme::c("mem_box") + Symbols::title_left + (show_disks ? Fx::b : "")
-				+ Theme::c("hi_fg") + 'd' + Theme::c("title") + "isks" + Fx::ub + Theme::c("mem_box") + Symbols::title_right;
+			box = createBox(x, y, width, height, Theme::c(Color::mem_box), true, "mem", "", 2);
+			box += Mv::to(y, (show_disks ? divider + 2 : x + width - 9)) + Theme::c(Color::mem_box) + Symbols::title_left + (show_disks ? Fx::b : "")
+				+ Theme::c(Color::hi_fg) + 'd' + Theme::c(Color::title) + "isks" + Fx::ub + Theme::c(Color::mem_box) + Symbols::title_right;
 			Input::mouse_mappings["d"] = {y, (show_disks ? divider + 3 : x + width - 8), 1, 5};
 			if (show_disks) {
-				box += Mv::to(y, divider) + Symbols::div_up + Mv::to(y + height - 1, divider) + Symbols::div_down + Theme::c("div_line");
+				box += Mv::to(y, divider) + Symbols::div_up + Mv::to(y + height - 1, divider) + Symbols::div_down + Theme::c(Color::div_line);
 				for (auto i : iota(1, height - 1))
 					box += Mv::to(y + i, divider) + Symbols::v_line;
 			}
@@ -2234,7 +2645,7 @@ namespace Draw {
 			d_graph_height = round((double)(height - 2) / 2);
 			u_graph_height = height - 2 - d_graph_height;
 
-			box = createBox(x, y, width, height, Theme::c("net_box"), true, "net", "", 3);
+			box = createBox(x, y, width, height, Theme::c(Color::net_box), true, "net", "", 3);
 			box += createBox(b_x, b_y, b_width, b_height, "", false, "download", "upload");
 		}
 
@@ -2254,7 +2665,7 @@ namespace Draw {
 			y = (cpu_bottom and Cpu::shown) ? 1 : Cpu::height + 1;
 		#endif
 			select_max = height - 3;
-			box = createBox(x, y, width, height, Theme::c("proc_box"), true, "proc", "", 4);
+			box = createBox(x, y, width, height, Theme::c(Color::proc_box), true, "proc", "", 4);
 		}
 	}
 }
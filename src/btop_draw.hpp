@@ -18,14 +18,17 @@ tab-size = 4
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <array>
+#include <cstdint>
 #include <unordered_map>
-#include <deque>
+
+#include "btop_ringbuffer.hpp"
+#include "btop_theme.hpp"
 
 using std::array;
-using std::deque;
 using std::string;
 using std::vector;
 
@@ -84,45 +87,119 @@ namespace Draw {
 
 	bool update_clock(bool force = false);
 
+	//* Milliseconds until the clock can next change, until the next second if it shows seconds and the next minute otherwise
+	uint64_t clock_wait();
+
 	//* Class holding a percentage meter
 	class Meter {
 		int width;
-		string color_gradient;
+		Theme::Gradient color_gradient = Theme::Gradient::none;
 		bool invert;
 		array<string, 101> cache;
 	public:
 		Meter();
-		Meter(const int width, const string& color_gradient, bool invert = false);
+		Meter(const int width, Theme::Gradient color_gradient, bool invert = false);
 
 		//* Return a string representation of the meter with given value
 		string operator()(int value);
 	};
 
+	//* Braille level 0-4 of <value> in a graph row spanning <low> to <high>, without the no_zero minimum
+	uint8_t graph_level(int value, int low, int high, float mod);
+
+	//* graph_level() of <count> values in one graph row into <out>, 8 values at a time with SSE2 or NEON
+	void graph_levels(const int32_t* values, size_t count, int low, int high, float mod, uint8_t* out);
+
 	//* Class holding a percentage graph
 	class Graph {
 		int width, height;
-		string color_gradient;
+		Theme::Gradient color_gradient = Theme::Gradient::none;
 		string out, symbol = "default";
 		bool invert, no_zero;
 		long long offset;
 		long long last = 0, max_value = 0;
 		bool current = true, tty_mode = false;
-		std::unordered_map<bool, vector<string>> graphs = { {true, {}}, {false, {}}};
 
-		//* Create two representations of the graph to switch between to represent two values for each braille character
-		void _create(const deque<long long>& data, int data_offset);
+		//? Symbol table resolved from <symbol> and <invert>, packed in fixed size slots
+		struct Glyphs {
+			array<array<char, 4>, 25> bytes;
+			array<uint8_t, 25> len;
+		};
+		const Glyphs* glyphs = nullptr;
+		bool dirty = false;
+
+		//? Two representations to switch between, each <height> serialized rows of <width> cells used as ring buffers,
+		//? the live part of a row starts at <row_offset> and <sizes> holds the byte size of each cell from <head>
+		array<vector<string>, 2> rows;
+		array<vector<size_t>, 2> row_offset;
+		array<vector<uint8_t>, 2> sizes;
+		array<int, 2> head = {0, 0};
+
+		//? Scratch buffers for _create, values copied from the data from index <input_start>,
+		//? clamped input values and the braille level of each value for each row
+		vector<long long> input;
+		int input_start = 0;
+		vector<int32_t> values;
+		vector<uint8_t> levels;
+
+		//* Copy the values of <data> from index <from> into <input>
+		template <typename T, typename P>
+		void _gather(const RingBuffer<T, P>& data, int from) {
+			input_start = std::max(from, 0);
+			input.clear();
+			for (const auto& part : data.spans(input_start)) input.insert(input.end(), part.begin(), part.end());
+		}
+
+		//* Index of the first value to draw out of <data_size> values
+		int _data_offset(int data_size) const;
+
+		//* Add cells for values from <data_offset> out of <data_size> values, read from <input>,
+		//* two values are represented in each braille character
+		void _create(int data_size, int data_offset);
+
+		//* Add the newest of <data_size> values in <input> and return string representation of graph
+		string& _update(int data_size);
+
+		//* Rebuild <out> from the rows of the current representation
+		void _serialize();
+
+		//* Return packed symbol table for graph_symbols entry <name>
+		static const Glyphs& _glyphs(const string& name);
 
 	public:
 		Graph();
+
+		//* Graph without any values yet
 		Graph(int width, int height,
-			const string& color_gradient,
-			const deque<long long>& data,
+			Theme::Gradient color_gradient,
 			const string& symbol="default",
 			bool invert=false, bool no_zero=false,
 			long long max_value=0, long long offset=0);
 
+		template <typename T, typename P>
+		Graph(int width, int height,
+			Theme::Gradient color_gradient,
+			const RingBuffer<T, P>& data,
+			const string& symbol="default",
+			bool invert=false, bool no_zero=false,
+			long long max_value=0, long long offset=0)
+		: Graph(width, height, color_gradient, symbol, invert, no_zero, max_value, offset) {
+			if (this->width == 0 or data.empty()) return;
+			const int data_offset = _data_offset(data.size());
+			_gather(data, data_offset - 1);
+			_create(data.size(), data_offset);
+		}
+
 		//* Add last value from back of <data> and return string representation of graph
-		string& operator()(const deque<long long>& data, bool data_same=false);
+		template <typename T, typename P>
+		string& operator()(const RingBuffer<T, P>& data, bool data_same=false) {
+			if (data_same or width == 0) return (*this)();
+			_gather(data, (int)data.size() - 1);
+			return _update(data.size());
+		}
+
+		//* Add <value> and return string representation of graph
+		string& operator()(long long value, bool data_same=false);
 
 		//* Return string representation of graph
 		string& operator()();
@@ -16,6 +16,7 @@ indent = tab
 tab-size = 4
 */
 
+#include <cstring>
 #include <limits>
 #include <ranges>
 #include <vector>
@@ -23,6 +24,12 @@ tab-size = 4
 #include <mutex>
 #include <signal.h>
 #include <sys/select.h>
+#ifdef __linux__
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+	#include <sys/signalfd.h>
+	#include <sys/timerfd.h>
+#endif
 #include <utility>
 #include <iostream>
 #include <fstream>
@@ -129,6 +136,53 @@ namespace Input {
 	string old_filter;
 	string input;
 
+#ifdef __linux__
+	namespace {
+		int epoll_fd = -1, signal_fd = -1, timer_fd = -1, event_fd = -1;
+		void (*signal_callback)(int) = nullptr;
+
+		//* Read and discard the counter of an eventfd or timerfd
+		void drain(int fd) {
+			uint64_t count;
+			while (read(fd, &count, sizeof(count)) == sizeof(count));
+		}
+	}
+
+	bool init(void (*handler)(int)) {
+		signal_callback = handler;
+
+		//? Block signals handled through the signalfd, threads created after this inherit the mask
+		sigset_t mask;
+		sigemptyset(&mask);
+		for (const int sig : {SIGWINCH, SIGINT, SIGTSTP, SIGCONT, SIGUSR2}) sigaddset(&mask, sig);
+		if (pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+			Logger::error("Input::init() : Failed to block signals.");
+			return false;
+		}
+		pthread_sigmask(SIG_BLOCK, nullptr, &signal_mask);
+
+		signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+		timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (signal_fd < 0 or timer_fd < 0 or event_fd < 0 or epoll_fd < 0) {
+			Logger::error("Input::init() : Failed to create event descriptors: " + string{strerror(errno)});
+			return false;
+		}
+
+		for (const int fd : {STDIN_FILENO, signal_fd, timer_fd, event_fd}) {
+			struct epoll_event ev {};
+			ev.events = EPOLLIN;
+			ev.data.fd = fd;
+			if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+				Logger::error("Input::init() : epoll_ctl failed for fd " + to_string(fd) + ": " + string{strerror(errno)});
+				return false;
+			}
+		}
+		return true;
+	}
+#endif
+
    std::optional<KeyEvent> try_get(const uint64_t timeout) {
       if (!poll(timeout)) {
          return std::nullopt;
@@ -138,6 +192,45 @@ namespace Input {
 
 	bool poll(const uint64_t timeout) {
 		atomic_lock lck(polling);
+	#ifdef __linux__
+		if (epoll_fd >= 0) {
+			//? Arm the tick timer at an absolute monotonic deadline on the same millisecond grid as Tools::time_ms(),
+			//? so a caller waiting for a deadline wakes up at that deadline and not up to 1ms after.
+			//? A zeroed itimerspec disarms it when waiting indefinitely
+			struct itimerspec wait {};
+			if (timeout != std::numeric_limits<uint64_t>::max()) {
+				const uint64_t deadline = time_ms() + timeout;
+				wait.it_value.tv_sec = deadline / 1000;
+				wait.it_value.tv_nsec = (deadline % 1000) * 1000000;
+			}
+			timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &wait, nullptr);
+
+			array<struct epoll_event, 4> events;
+			const int count = epoll_wait(epoll_fd, events.data(), events.size(), (timeout == 0 ? 0 : -1));
+			bool has_input{};
+			for (int i = 0; i < count; i++) {
+				const int fd = events[i].data.fd;
+				if (fd == STDIN_FILENO)
+					has_input = true;
+				else if (fd == signal_fd) {
+					struct signalfd_siginfo info;
+					while (read(signal_fd, &info, sizeof(info)) == sizeof(info)) {
+						if (signal_callback != nullptr) signal_callback(info.ssi_signo);
+					}
+				}
+				else drain(fd);
+			}
+			if (not has_input) return false;
+
+			input.clear();
+			char buf[1024];
+			ssize_t read_count = 0;
+			while((read_count = read(STDIN_FILENO, buf, sizeof(buf))) > 0) {
+				input.append(std::string_view(buf, read_count));
+			}
+			return not input.empty();
+		}
+	#endif
 		fd_set fds;
 		FD_ZERO(&fds);
 		FD_SET(STDIN_FILENO, &fds);
@@ -221,6 +314,15 @@ namespace Input {
                return std::nullopt;
             }
          }
+         //? Terminal focus reporting, enabled with Term::focus_on
+         if (key == "[I" || key == "[O") {
+            return KeyEvent {
+               .type = EventType::Focus,
+               .ch = 0x00,
+               .escape = key == "[I" ? EscapeCodes::FOCUS_IN : EscapeCodes::FOCUS_OUT,
+               .mouse = {}
+            };
+         }
          if (escape_chars.find(std::string(key)) != escape_chars.end()) {
             return KeyEvent {
                .type = EventType::Spec,
@@ -253,6 +355,13 @@ namespace Input {
 	}
 
 	void interrupt() {
+	#ifdef __linux__
+		if (event_fd >= 0) {
+			const uint64_t one = 1;
+			[[maybe_unused]] const auto ret = write(event_fd, &one, sizeof(one));
+			return;
+		}
+	#endif
 		kill(getpid(), SIGUSR1);
 	}
 
@@ -272,6 +381,34 @@ namespace Input {
       case 'q':
          clean_quit(0);
          break;
+
+      //? Cycle the core area of the cpu box through the views in cpu_core_view
+      case 'v': {
+         const auto& views = Config::cpu_core_views;
+         const auto current = rng::find(views, g_CfgMgr.get<CfgS>("cpu_core_view").v());
+         const auto& next = (current == views.end() or std::next(current) == views.end() ? views.front() : *std::next(current));
+         atomic_wait(Runner::active);
+         (void)g_CfgMgr.set<CfgS>("cpu_core_view", next);
+         Cpu::drill_group = -1;
+         Draw::calcSizes();
+         Runner::run("cpu", true, true);
+         break;
+      }
+
+      //? Step through the groups of a grouped view, stepping past either end shows all groups again
+      case '[':
+      case ']': {
+         const string view = g_CfgMgr.get<CfgS>("cpu_core_view").v();
+         //? The runner rebuilds the groups when cores are hotplugged
+         atomic_wait(Runner::active);
+         if (not decltype(Cpu::group_sizes)::contains(view) or Cpu::group_sizes.at(view).empty()) break;
+         const int count = Cpu::group_sizes.at(view).size();
+         if (ev.ch == ']') Cpu::drill_group = (Cpu::drill_group + 1 >= count ? -1 : Cpu::drill_group + 1);
+         else Cpu::drill_group = (Cpu::drill_group < 0 ? count - 1 : Cpu::drill_group - 1);
+         Draw::calcSizes();
+         Runner::run("cpu", true, true);
+         break;
+      }
       }
    }
 
@@ -291,6 +428,16 @@ namespace Input {
       outfile.close();
    }
 
+   void process_focus(KeyEvent ev) {
+      const bool focus_in = ev.escape == EscapeCodes::FOCUS_IN;
+      if (Runner::focused.exchange(focus_in) == focus_in) return;
+
+      //? Frames are skipped while unfocused, redraw everything from the collected history
+      if (focus_in and g_CfgMgr.get<CfgB>("pause_unfocused").v()) {
+         Runner::run("all", true, true);
+      }
+   }
+
 	void process(std::optional<KeyEvent> ev_opt) {
       if (!ev_opt) return;
       auto ev = *ev_opt;
@@ -305,6 +452,9 @@ namespace Input {
          case EventType::Mouse:
             process_mouse(ev);
             break;
+         case EventType::Focus:
+            process_focus(ev);
+            break;
          default:
             break;
       }
@@ -64,6 +64,8 @@ enum EscapeCodes {
    RETURN,
    SPACE,
    BACKSPACE,
+   FOCUS_IN,
+   FOCUS_OUT,
 };
 
 enum EventType {
@@ -71,6 +73,7 @@ enum EventType {
    Char,
    Spec,
    Mouse,
+   Focus,
 };
 
 struct MouseEvent {
@@ -117,6 +120,12 @@ namespace Input {
 
 	extern atomic<bool> polling;
 
+#ifdef __linux__
+	//* Setup the epoll loop over stdin, a signalfd, a tick timerfd and an eventfd used for interrupts.
+	//* Signals in the signalfd are blocked and passed to <handler> from Input::poll on the main thread
+	bool init(void (*handler)(int));
+#endif
+
 	//* Mouse column and line position
 	extern array<int, 2> mouse_pos;
 
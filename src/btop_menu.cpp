@@ -42,6 +42,8 @@ using std::max;
 using std::min;
 using std::ref;
 using std::views::iota;
+using Theme::Color;
+using Theme::Gradient;
 
 using namespace Tools;
 
@@ -291,6 +293,49 @@ namespace Menu {
 				"",
 				"Min value: 100 ms",
 				"Max value: 86400000 ms = 24 hours."},
+			{"adaptive_update",
+				"Stretch update time while idle.",
+				"",
+				"Doubles the update time, up to",
+				"\"adaptive_update_max\", while cpu, disk and",
+				"network activity is low and no keys",
+				"have been pressed for 10 seconds.",
+				"",
+				"Snaps back to \"update_ms\" on input or",
+				"when activity picks up.",
+				"",
+				"True or False."},
+			{"adaptive_update_max",
+				"Max update time with adaptive_update.",
+				"",
+				"Upper limit in milliseconds for the",
+				"stretched update time.",
+				"",
+				"Min value: 100 ms",
+				"Max value: 86400000 ms = 24 hours."},
+			{"pause_unfocused",
+				"Stop drawing while unfocused.",
+				"",
+				"Only collects data while the terminal",
+				"window is unfocused, graphs keep their",
+				"history and are redrawn on focus.",
+				"",
+				"Needs a terminal with focus reporting,",
+				"for tmux set \"focus-events on\".",
+				"",
+				"True or False."},
+			{"diff_output",
+				"Only write changed cells.",
+				"",
+				"Keeps a copy of the screen and only",
+				"sends the cells that changed since the",
+				"last frame to the terminal.",
+				"",
+				"Disable if parts of the screen aren't",
+				"updated, can happen with fonts that draw",
+				"some glyphs wider than standard.",
+				"",
+				"True or False."},
 			{"rounded_corners",
 				"Rounded corners on boxes.",
 				"",
@@ -394,6 +439,7 @@ namespace Menu {
 				"\"total\" = Total cpu usage. (Auto)",
 				"\"user\" = User mode cpu usage.",
 				"\"system\" = Kernel mode cpu usage.",
+				"\"pressure\" = Time tasks waited for cpu.",
 				"+ more depending on kernel.",
 		#ifdef GPU_SUPPORT
 				"",
@@ -417,6 +463,7 @@ namespace Menu {
 				"\"total\" = Total cpu usage.",
 				"\"user\" = User mode cpu usage.",
 				"\"system\" = Kernel mode cpu usage.",
+				"\"pressure\" = Time tasks waited for cpu.",
 				"+ more depending on kernel.",
 		#ifdef GPU_SUPPORT
 				"",
@@ -502,6 +549,57 @@ namespace Menu {
 				"",
 				"Can cause slowdowns on systems with many",
 				"cores and certain kernel versions."},
+			{"cpu_core_view",
+				"What the core area of the cpu box shows.",
+				"",
+				"\"cores\" shows a row for every core.",
+				"",
+				"\"socket\", \"node\" and \"llc\" show a row",
+				"per socket, NUMA node or last level cache",
+				"with the average usage of its cores.",
+				"Drill into a group with \"[\" and \"]\".",
+				"",
+				"\"heatmap\" shows one cell per core.",
+				"",
+				"Cycle through the views with \"v\"."},
+			{"cpu_core_freq",
+				"Collect the frequency of every core.",
+				"",
+				"Colors the core labels in the cpu box and",
+				"the cells of the \"heatmap\" core view by",
+				"frequency, from lowest to highest seen,",
+				"to spot throttled or parked cores.",
+				"",
+				"Shows min, avg and max frequency over",
+				"the cores on the bottom of the cpu box.",
+				"",
+				"True or False."},
+			{"cpu_pmu",
+				"(Linux) Per core performance counters.",
+				"",
+				"Shows instructions per cycle next to each",
+				"core, colored by cache miss ratio, to tell",
+				"memory bound from compute bound load.",
+				"",
+				"Shows context switches per second instead",
+				"when the cpu has no usable PMU.",
+				"",
+				"Needs CAP_PERFMON or perf_event_paranoid",
+				"set to 0 or lower.",
+				"",
+				"True or False."},
+			{"cpu_sched_stats",
+				"Scheduler activity in the cpu box.",
+				"",
+				"Shows context switches and forks per",
+				"second and the runnable and blocked tasks",
+				"on a line below the load average.",
+				"",
+				"(Linux) Adds the average and worst core",
+				"run queue wait when the kernel has",
+				"/proc/schedstat.",
+				"",
+				"True or False."},
 			{"custom_cpu_name",
 				"Custom cpu model name in cpu percentage box.",
 				"",
@@ -623,6 +721,27 @@ namespace Menu {
 				"",
 				"Ignores show_swap value above.",
 				"Inserts itself after first disk."},
+			{"show_pressure",
+				"(Linux) Show pressure stall information.",
+				"",
+				"Share of the time tasks were stalled",
+				"waiting for memory and io, graphed in",
+				"the mem box. \"pressure\" can also be",
+				"picked as a cpu graph for cpu stalls.",
+				"",
+				"Hidden on kernels without PSI.",
+				"",
+				"True or False."},
+			{"pressure_high_res",
+				"(Linux) High resolution pressure.",
+				"",
+				"Compute pressure from the stall time",
+				"counters between updates instead of the",
+				"kernel's 10 second average.",
+				"",
+				"Follows short stalls with a low update_ms.",
+				"",
+				"True or False."},
 			{"only_physical",
 				"Filter out non physical disks.",
 				"",
@@ -809,7 +928,7 @@ namespace Menu {
 		button_left = left_up + Symbols::h_line * 6 + Mv::l(7) + Mv::d(2) + left_down + Symbols::h_line * 6 + Mv::l(7) + Mv::u(1) + Symbols::v_line;
 		button_right = Symbols::v_line + Mv::l(7) + Mv::u(1) + Symbols::h_line * 6 + right_up + Mv::l(7) + Mv::d(2) + Symbols::h_line * 6 + right_down + Mv::u(2);
 
-		box_contents = Draw::createBox(x, y, width, height, Theme::c("hi_fg"), true, title) + Mv::d(1);
+		box_contents = Draw::createBox(x, y, width, height, Theme::c(Color::hi_fg), true, title) + Mv::d(1);
 		for (const auto& line : content) {
 			box_contents += Mv::save + Mv::r(max((size_t)0, (width / 2) - (Fx::uncolor(line).size() / 2) - 1)) + line + Mv::restore + Mv::d(1);
 		}
@@ -818,13 +937,13 @@ namespace Menu {
 	string msgBox::operator()() {
 		string out;
 		int pos = width / 2 - (boxtype == 0 ? 6 : 14);
-		auto& first_color = (selected == 0 ? Theme::c("hi_fg") : Theme::c("div_line"));
-		out = Mv::d(1) + Mv::r(pos) + Fx::b + first_color + button_left + (selected == 0 ? Theme::c("title") : Theme::c("main_fg") + Fx::ub)
+		auto& first_color = (selected == 0 ? Theme::c(Color::hi_fg) : Theme::c(Color::div_line));
+		out = Mv::d(1) + Mv::r(pos) + Fx::b + first_color + button_left + (selected == 0 ? Theme::c(Color::title) : Theme::c(Color::main_fg) + Fx::ub)
 			+ (boxtype == 0 ? "    Ok    " : "    Yes    ") + first_color + button_right;
 		mouse_mappings["button1"] = Input::Mouse_loc{y + height - 4, x + pos + 1, 3, 12 + (boxtype > 0 ? 1 : 0)};
 		if (boxtype > 0) {
-			auto& second_color = (selected == 1 ? Theme::c("hi_fg") : Theme::c("div_line"));
-			out += Mv::r(2) + second_color + button_left + (selected == 1 ? Theme::c("title") : Theme::c("main_fg") + Fx::ub)
+			auto& second_color = (selected == 1 ? Theme::c(Color::hi_fg) : Theme::c(Color::div_line));
+			out += Mv::r(2) + second_color + button_left + (selected == 1 ? Theme::c(Color::title) : Theme::c(Color::main_fg) + Fx::ub)
 				+ "    No    " + second_color + button_right;
 			mouse_mappings["button2"] = Input::Mouse_loc{y + height - 4, x + pos + 15 + (boxtype > 0 ? 1 : 0), 3, 12};
 		}
@@ -896,8 +1015,8 @@ namespace Menu {
 		if (redraw) {
 			x = Term::width/2 - 40;
 			y = Term::height/2 - 9;
-			bg = Draw::createBox(x + 2, y, 78, 19, Theme::c("hi_fg"), true, "signals");
-			bg += Mv::to(y+2, x+3) + Theme::c("title") + Fx::b + cjust("Send signal to PID " + to_string(s_pid) + " ("
+			bg = Draw::createBox(x + 2, y, 78, 19, Theme::c(Color::hi_fg), true, "signals");
+			bg += Mv::to(y+2, x+3) + Theme::c(Color::title) + Fx::b + cjust("Send signal to PID " + to_string(s_pid) + " ("
 				+ uresize((s_pid == Config::getI("detailed_pid") ? Proc::detailed.entry.name : Config::getS("selected_name")), 30) + ")", 76);
 		}
 		else if (is_in(key, "escape", "q")) {
@@ -962,27 +1081,27 @@ namespace Menu {
 
 		if (retval == Changed) {
 			int cy = y+4, cx = x+4;
-			out = bg + Mv::to(cy++, x+3) + Theme::c("main_fg") + Fx::ub
-				+ rjust("Enter signal number: ", 48) + Theme::c("hi_fg") + (selected_signal >= 0 ? to_string(selected_signal) : "") + Theme::c("main_fg") + Fx::bl + "█" + Fx::ubl;
+			out = bg + Mv::to(cy++, x+3) + Theme::c(Color::main_fg) + Fx::ub
+				+ rjust("Enter signal number: ", 48) + Theme::c(Color::hi_fg) + (selected_signal >= 0 ? to_string(selected_signal) : "") + Theme::c(Color::main_fg) + Fx::bl + "█" + Fx::ubl;
 
 			auto sig_str = to_string(selected_signal);
 			for (int count = 0, i = 0; const auto& sig : P_Signals) {
 				if (count == 0 or count == 16) { count++; continue; }
 				if (i++ % 5 == 0) { ++cy; cx = x+4; }
 				out += Mv::to(cy, cx);
-				if (count == selected_signal) out += Theme::c("selected_bg") + Theme::c("selected_fg") + Fx::b + ljust(to_string(count), 3) + ljust('(' + sig + ')', 12) + Fx::reset;
-				else out += Theme::c("hi_fg") + ljust(to_string(count), 3) + Theme::c("main_fg") + ljust('(' + sig + ')', 12);
+				if (count == selected_signal) out += Theme::c(Color::selected_bg) + Theme::c(Color::selected_fg) + Fx::b + ljust(to_string(count), 3) + ljust('(' + sig + ')', 12) + Fx::reset;
+				else out += Theme::c(Color::hi_fg) + ljust(to_string(count), 3) + Theme::c(Color::main_fg) + ljust('(' + sig + ')', 12);
 				if (redraw) mouse_mappings["button_" + to_string(count)] = {cy, cx, 1, 15};
 				count++;
 				cx += 15;
 			}
 
 			cy++;
-			out += Mv::to(++cy, x+3) + Fx::b + Theme::c("hi_fg") + rjust( "↑ ↓ ← →", 33, true) + Theme::c("main_fg") + Fx::ub + " | To choose signal.";
-			out += Mv::to(++cy, x+3) + Fx::b + Theme::c("hi_fg") + rjust("0-9", 33) + Theme::c("main_fg") + Fx::ub + " | Enter manually.";
-			out += Mv::to(++cy, x+3) + Fx::b + Theme::c("hi_fg") + rjust("ENTER", 33) + Theme::c("main_fg") + Fx::ub + " | To send signal.";
+			out += Mv::to(++cy, x+3) + Fx::b + Theme::c(Color::hi_fg) + rjust( "↑ ↓ ← →", 33, true) + Theme::c(Color::main_fg) + Fx::ub + " | To choose signal.";
+			out += Mv::to(++cy, x+3) + Fx::b + Theme::c(Color::hi_fg) + rjust("0-9", 33) + Theme::c(Color::main_fg) + Fx::ub + " | Enter manually.";
+			out += Mv::to(++cy, x+3) + Fx::b + Theme::c(Color::hi_fg) + rjust("ENTER", 33) + Theme::c(Color::main_fg) + Fx::ub + " | To send signal.";
 			mouse_mappings["enter"] = {cy, x, 1, 73};
-			out += Mv::to(++cy, x+3) + Fx::b + Theme::c("hi_fg") + rjust("ESC or \"q\"", 33) + Theme::c("main_fg") + Fx::ub + " | To abort.";
+			out += Mv::to(++cy, x+3) + Fx::b + Theme::c(Color::hi_fg) + rjust("ESC or \"q\"", 33) + Theme::c(Color::main_fg) + Fx::ub + " | To abort.";
 			mouse_mappings["escape"] = {cy, x, 1, 73};
 
 			out += Fx::reset;
@@ -994,7 +1113,7 @@ namespace Menu {
 	int sizeError(const string& key) {
 		if (redraw) {
 			vector<string> cont_vec;
-			cont_vec.push_back(Fx::b + Theme::g("used")[100] + "Error:" + Theme::c("main_fg") + Fx::ub);
+			cont_vec.push_back(Fx::b + Theme::g(Gradient::used)[100] + "Error:" + Theme::c(Color::main_fg) + Fx::ub);
 			cont_vec.push_back("Terminal size to small to" + Fx::reset);
 			cont_vec.push_back("display menu or box!" + Fx::reset);
 
@@ -1051,10 +1170,10 @@ namespace Menu {
 			atomic_wait(Runner::active);
 			auto& p_name = (s_pid == detailedPid ? Proc::detailed.entry.name : Config::getS("selected_name"));
 			vector<string> cont_vec = {
-				Fx::b + Theme::c("main_fg") + "Send signal: " + Fx::ub + Theme::c("hi_fg") + to_string(signalToSend)
-				+ (signalToSend > 0 and signalToSend <= 32 ? Theme::c("main_fg") + " (" + P_Signals.at(signalToSend) + ')' : ""),
+				Fx::b + Theme::c(Color::main_fg) + "Send signal: " + Fx::ub + Theme::c(Color::hi_fg) + to_string(signalToSend)
+				+ (signalToSend > 0 and signalToSend <= 32 ? Theme::c(Color::main_fg) + " (" + P_Signals.at(signalToSend) + ')' : ""),
 
-				Fx::b + Theme::c("main_fg") + "To PID: " + Fx::ub + Theme::c("hi_fg") + to_string(s_pid) + Theme::c("main_fg") + " ("
+				Fx::b + Theme::c(Color::main_fg) + "To PID: " + Fx::ub + Theme::c(Color::hi_fg) + to_string(s_pid) + Theme::c(Color::main_fg) + " ("
 				+ uresize(p_name, 16) + ')' + Fx::reset,
 			};
 			messageBox = Menu::msgBox{50, 1, cont_vec, (signalToSend > 1 and signalToSend <= 32 and signalToSend != 17 ? P_Signals.at(signalToSend) : "signal")};
@@ -1088,7 +1207,7 @@ namespace Menu {
 	int signalReturn(const string& key) {
 		if (redraw) {
 			vector<string> cont_vec;
-			cont_vec.push_back(Fx::b + Theme::g("used")[100] + "Failure:" + Theme::c("main_fg") + Fx::ub);
+			cont_vec.push_back(Fx::b + Theme::g(Gradient::used)[100] + "Failure:" + Theme::c(Color::main_fg) + Fx::ub);
 			if (signalKillRet == EINVAL) {
 				cont_vec.push_back("Unsupported signal!" + Fx::reset);
 			}
@@ -1182,7 +1301,7 @@ namespace Menu {
 			out = bg + Fx::reset + Fx::b;
 			auto cy = y + 7;
 			for (const auto& i : iota(0, 3)) {
-				if (tty_mode) out += (i == selected ? Theme::c("hi_fg") : Theme::c("main_fg"));
+				if (tty_mode) out += (i == selected ? Theme::c(Color::hi_fg) : Theme::c(Color::main_fg));
 				const auto& menu = (not tty_mode and i == selected ? menu_selected[i] : menu_normal[i]);
 				const auto& colors = (i == selected ? colors_selected : colors_normal);
 				if (redraw) mouse_mappings["button_" + to_string(i)] = {cy, Term::width/2 - menu_width[i]/2, 3, menu_width[i]};
@@ -1226,6 +1345,7 @@ namespace Menu {
 			{"cpu_graph_upper", std::cref(Cpu::available_fields)},
 			{"cpu_graph_lower", std::cref(Cpu::available_fields)},
 			{"cpu_sensor", std::cref(Cpu::available_sensors)},
+			{"cpu_core_view", std::cref(Config::cpu_core_views)},
 			{"selected_battery", std::cref(Config::available_batteries)},
 		#ifdef GPU_SUPPORT
 			{"show_gpu_info", std::cref(Config::show_gpu_values)},
@@ -1258,10 +1378,10 @@ namespace Menu {
 			height = min(Term::height - 7, max_items * 2 + 4);
 			if (height % 2 != 0) height--;
 			bg 	= Draw::banner_gen(y, 0, true)
-				+ Draw::createBox(x, y + 6, 78, height, Theme::c("hi_fg"), true, "tab" + Symbols::right)
-				+ Mv::to(y+8, x) + Theme::c("hi_fg") + Symbols::div_left + Theme::c("div_line") + Symbols::h_line * 29
-				+ Symbols::div_up + Symbols::h_line * (78 - 32) + Theme::c("hi_fg") + Symbols::div_right
-				+ Mv::to(y+6+height - 1, x+30) + Symbols::div_down + Theme::c("div_line");
+				+ Draw::createBox(x, y + 6, 78, height, Theme::c(Color::hi_fg), true, "tab" + Symbols::right)
+				+ Mv::to(y+8, x) + Theme::c(Color::hi_fg) + Symbols::div_left + Theme::c(Color::div_line) + Symbols::h_line * 29
+				+ Symbols::div_up + Symbols::h_line * (78 - 32) + Theme::c(Color::hi_fg) + Symbols::div_right
+				+ Mv::to(y+6+height - 1, x+30) + Symbols::div_down + Theme::c(Color::div_line);
 			for (const auto& i : iota(0, height - 4)) {
 				bg += Mv::to(y+9 + i, x + 30) + Symbols::v_line;
 			}
@@ -1375,7 +1495,7 @@ namespace Menu {
 		else if (is_in(key, "left", "right") or (vim_keys and is_in(key, "h", "l"))) {
 			const auto& option = categories[selected_cat][item_height * page + selected][0];
 			if (selPred.test(isInt)) {
-				const int mod = (option == "update_ms" ? 100 : 1);
+				const int mod = (is_in(option, "update_ms", "adaptive_update_max") ? 100 : 1);
 				long value = Config::getI(option);
 				if (key == "right" or (vim_keys and key == "l")) value += mod;
 				else value -= mod;
@@ -1403,6 +1523,7 @@ namespace Menu {
 					Runner::pause_output = false;
 				}
 				else if (option == "base_10_sizes") {
+					update_units();
 					recollect = true;
 				}
 			}
@@ -1420,7 +1541,7 @@ namespace Menu {
 					Logger::set(optList.at(i));
 					Logger::info("Logger set to " + optList.at(i));
 				}
-				else if (is_in(option, "proc_sorting", "cpu_sensor", "show_gpu_info") or option.starts_with("graph_symbol") or option.starts_with("cpu_graph_"))
+				else if (is_in(option, "proc_sorting", "cpu_sensor", "cpu_core_view", "show_gpu_info") or option.starts_with("graph_symbol") or option.starts_with("cpu_graph_"))
 					screen_redraw = true;
 			}
 			else
@@ -1472,8 +1593,8 @@ namespace Menu {
 			for (int i = 0; const auto& m : {"general", "cpu", "mem", "net", "proc"}) {
 		#endif
 				out += Fx::b + (i == selected_cat
-						? Theme::c("hi_fg") + '[' + Theme::c("title") + m + Theme::c("hi_fg") + ']'
-						: Theme::c("hi_fg") + to_string(i + 1) + Theme::c("title") + m + ' ')
+						? Theme::c(Color::hi_fg) + '[' + Theme::c(Color::title) + m + Theme::c(Color::hi_fg) + ']'
+						: Theme::c(Color::hi_fg) + to_string(i + 1) + Theme::c(Color::title) + m + ' ')
 				#ifdef GPU_SUPPORT
 					+ Mv::r(7);
 				#else
@@ -1484,8 +1605,8 @@ namespace Menu {
 				i++;
 			}
 			if (pages > 1) {
-				out += Mv::to(y+6 + height - 1, x+2) + Theme::c("hi_fg") + Symbols::title_left_down + Fx::b + Symbols::up + Theme::c("title") + " page "
-					+ to_string(page+1) + '/' + to_string(pages) + ' ' + Theme::c("hi_fg") + Symbols::down + Fx::ub + Symbols::title_right_down;
+				out += Mv::to(y+6 + height - 1, x+2) + Theme::c(Color::hi_fg) + Symbols::title_left_down + Fx::b + Symbols::up + Theme::c(Color::title) + " page "
+					+ to_string(page+1) + '/' + to_string(pages) + ' ' + Theme::c(Color::hi_fg) + Symbols::down + Fx::ub + Symbols::title_right_down;
 			}
 			//? Option name and value
 			auto cy = y+9;
@@ -1493,12 +1614,12 @@ namespace Menu {
 				const auto& option = categories[selected_cat][i][0];
 				const auto& value = (option == "color_theme" ? (string) fs::path(Config::getS("color_theme")).stem() : Config::getAsString(option));
 
-				out += Mv::to(cy++, x + 1) + (c-1 == selected ? Theme::c("selected_bg") + Theme::c("selected_fg") : Theme::c("title"))
+				out += Mv::to(cy++, x + 1) + (c-1 == selected ? Theme::c(Color::selected_bg) + Theme::c(Color::selected_fg) : Theme::c(Color::title))
 					+ Fx::b + cjust(capitalize(s_replace(option, "_", " "))
 						+ (c-1 == selected and selPred.test(isBrowseable)
 							? ' ' + to_string(v_index(optionsList.at(option).get(), (option == "color_theme" ? Config::getS("color_theme") : value)) + 1) + '/' + to_string(optionsList.at(option).get().size())
 							: ""), 29);
-				out	+= Mv::to(cy++, x + 1) + (c-1 == selected ? "" : Theme::c("main_fg")) + Fx::ub + "  "
+				out	+= Mv::to(cy++, x + 1) + (c-1 == selected ? "" : Theme::c(Color::main_fg)) + Fx::ub + "  "
 					+ (c-1 == selected and editing ? cjust(editor(24), 34, true) : cjust(value, 25, true)) + "  ";
 
 				if (c-1 == selected) {
@@ -1511,10 +1632,10 @@ namespace Menu {
 						out += Fx::b + Mv::to(cy-1, x+28 - (not editing and selPred.test(isInt) ? 2 : 0)) + (tty_mode ? "E" : Symbols::enter);
 					}
 					//? Description of selected option
-					out += Fx::reset + Theme::c("title") + Fx::b;
+					out += Fx::reset + Theme::c(Color::title) + Fx::b;
 					for (int cyy = y+7; const auto& desc : categories[selected_cat][i]) {
 						if (cyy++ == y+7) continue;
-						else if (cyy == y+10) out += Theme::c("main_fg") + Fx::ub;
+						else if (cyy == y+10) out += Theme::c(Color::main_fg) + Fx::ub;
 						else if (cyy > y + height + 4) break;
 						out += Mv::to(cyy, x+32) + desc;
 					}
@@ -1569,7 +1690,7 @@ namespace Menu {
 			pages = ceil((double)help_text.size() / (height - 3));
 			page = 0;
 			bg = Draw::banner_gen(y, 0, true);
-			bg += Draw::createBox(x, y + 6, 78, height, Theme::c("hi_fg"), true, "help");
+			bg += Draw::createBox(x, y + 6, 78, height, Theme::c(Color::hi_fg), true, "help");
 		}
 		else if (is_in(key, "escape", "q", "h", "backspace", "space", "enter", "mouse_click")) {
 			return Closed;
@@ -1589,14 +1710,14 @@ namespace Menu {
 			auto& out = Global::overlay;
 			out = bg;
 			if (pages > 1) {
-				out += Mv::to(y+height+6, x + 2) + Theme::c("hi_fg") + Symbols::title_left_down + Fx::b + Symbols::up + Theme::c("title") + " page "
-					+ to_string(page+1) + '/' + to_string(pages) + ' ' + Theme::c("hi_fg") + Symbols::down + Fx::ub + Symbols::title_right_down;
+				out += Mv::to(y+height+6, x + 2) + Theme::c(Color::hi_fg) + Symbols::title_left_down + Fx::b + Symbols::up + Theme::c(Color::title) + " page "
+					+ to_string(page+1) + '/' + to_string(pages) + ' ' + Theme::c(Color::hi_fg) + Symbols::down + Fx::ub + Symbols::title_right_down;
 			}
 			auto cy = y+7;
-			out += Mv::to(cy++, x + 1) + Theme::c("title") + Fx::b + cjust("Key:", 20) + "Description:";
+			out += Mv::to(cy++, x + 1) + Theme::c(Color::title) + Fx::b + cjust("Key:", 20) + "Description:";
 			for (int c = 0, i = max(0, (height - 3) * page); c++ < height - 3 and i < (int)help_text.size(); i++) {
-				out += Mv::to(cy++, x + 1) + Theme::c("hi_fg") + Fx::b + cjust(help_text[i][0], 20)
-					+ Theme::c("main_fg") + Fx::ub + help_text[i][1];
+				out += Mv::to(cy++, x + 1) + Theme::c(Color::hi_fg) + Fx::b + cjust(help_text[i][0], 20)
+					+ Theme::c(Color::main_fg) + Fx::ub + help_text[i][1];
 			}
 			out += Fx::reset;
 		}
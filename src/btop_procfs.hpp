@@ -0,0 +1,289 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+//* Allocation free reading and parsing of the text files in /proc and /sys
+namespace Procfs {
+
+	//* open(), pread() and close() calls made by the readers in this namespace, for the debug stats
+	inline std::atomic<uint64_t> syscalls{0};
+
+	//* Attributes currently held open by a SysfsHandle
+	inline std::atomic<uint64_t> open_handles{0};
+
+	//* A whole file read into a buffer that is kept between reads, the buffer only grows so steady state reads don't allocate
+	class ReadBuffer {
+		std::string buf;
+		size_t length = 0;
+	public:
+		explicit ReadBuffer(size_t initial_size = 4096) : buf(initial_size, '\0') {}
+
+		//* Read from the start of the open file <fd>, at most <limit> bytes if <limit> isn't 0
+		bool read_fd(int fd, size_t limit = 0) {
+			length = 0;
+			while (true) {
+				if (length == buf.size()) {
+					if (limit > 0 and length >= limit) break;
+					buf.resize(buf.size() * 2);
+				}
+				const size_t want = (limit > 0 ? std::min(buf.size(), limit) : buf.size()) - length;
+				if (want == 0) break;
+				const ssize_t got = ::pread(fd, buf.data() + length, want, length);
+				syscalls.fetch_add(1, std::memory_order_relaxed);
+				if (got < 0 and errno == EINTR) continue;
+				if (got < 0) return false;
+				if (got == 0) break;
+				length += got;
+			}
+			return true;
+		}
+
+		//* Read the file at <path>, returns false if it couldn't be opened or read
+		bool read(const char* path, size_t limit = 0) {
+			const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+			syscalls.fetch_add(1, std::memory_order_relaxed);
+			if (fd < 0) {
+				length = 0;
+				return false;
+			}
+			const bool good = read_fd(fd, limit);
+			::close(fd);
+			syscalls.fetch_add(1, std::memory_order_relaxed);
+			return good;
+		}
+		bool read(const std::string& path, size_t limit = 0) { return read(path.c_str(), limit); }
+
+		std::string_view view() const { return {buf.data(), length}; }
+	};
+
+	//* Pieces of a text split on <delim>, empty pieces are kept and a trailing delimiter doesn't produce an empty piece
+	class Splitter {
+		std::string_view rest;
+		char delim;
+	public:
+		Splitter(std::string_view text, char delim) : rest(text), delim(delim) {}
+
+		bool next(std::string_view& piece) {
+			if (rest.empty()) return false;
+			const size_t end = rest.find(delim);
+			piece = rest.substr(0, end);
+			rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+			return true;
+		}
+	};
+
+	//* Lines of a text, without the newline
+	class Lines : public Splitter {
+	public:
+		explicit Lines(std::string_view text) : Splitter(text, '\n') {}
+	};
+
+	inline bool is_blank(char c) { return c == ' ' or c == '\t' or c == '\n'; }
+
+	inline std::string_view trim(std::string_view text) {
+		while (not text.empty() and is_blank(text.front())) text.remove_prefix(1);
+		while (not text.empty() and is_blank(text.back())) text.remove_suffix(1);
+		return text;
+	}
+
+	//* Whitespace separated fields of a text, runs of spaces and tabs count as one separator
+	class Fields {
+		std::string_view rest;
+	public:
+		explicit Fields(std::string_view text) : rest(text) {}
+
+		bool next(std::string_view& field) {
+			while (not rest.empty() and is_blank(rest.front())) rest.remove_prefix(1);
+			if (rest.empty()) return false;
+			size_t end = 0;
+			while (end < rest.size() and not is_blank(rest[end])) end++;
+			field = rest.substr(0, end);
+			rest.remove_prefix(end);
+			return true;
+		}
+
+		//* Skip <count> fields, returns false if there were fewer left
+		bool skip(size_t count) {
+			std::string_view ignored;
+			while (count-- > 0) if (not next(ignored)) return false;
+			return true;
+		}
+
+		//* Parse the next field as an integer
+		template <typename T>
+		bool next_int(T& value) {
+			std::string_view field;
+			return next(field) and std::from_chars(field.data(), field.data() + field.size(), value).ec == std::errc{};
+		}
+	};
+
+	//* Integer at the start of <text> after any whitespace, <fallback> if there's none or it's out of range for <T>
+	template <typename T>
+	T to_int(std::string_view text, T fallback = 0) {
+		while (not text.empty() and is_blank(text.front())) text.remove_prefix(1);
+		T value;
+		if (std::from_chars(text.data(), text.data() + text.size(), value).ec != std::errc{}) return fallback;
+		return value;
+	}
+
+	//* Decimal number like "2400.123" at the start of <text> as an integer scaled by 10^<Decimals>, extra decimals are truncated
+	template <int Decimals>
+	int64_t to_fixed(std::string_view text, int64_t fallback = 0) {
+		text = trim(text);
+		const bool negative = text.starts_with('-');
+		if (negative) text.remove_prefix(1);
+		int64_t value = 0;
+		const char* const end = text.data() + text.size();
+		auto [it, ec] = std::from_chars(text.data(), end, value);
+		if (ec != std::errc{}) return fallback;
+		const bool has_decimals = (it < end and *it == '.');
+		if (has_decimals) it++;
+		for (int i = 0; i < Decimals; i++) {
+			value *= 10;
+			if (has_decimals and it < end and *it >= '0' and *it <= '9') value += *it++ - '0';
+		}
+		return (negative ? -value : value);
+	}
+
+	//* A sysfs attribute that is opened once and then re-read with a single pread from offset 0 on every read,
+	//* sysfs regenerates the value for each read at offset 0 so the handle never goes stale while the device exists.
+	//* When the device goes away the read fails with ENODEV or ENOENT, the handle then closes and tries to reopen
+	//* the path, which also picks up a device that was replaced under the same name
+	class SysfsHandle {
+		std::string file;
+		int fd = -1;
+
+		bool open() {
+			fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+			syscalls.fetch_add(1, std::memory_order_relaxed);
+			if (fd < 0) return false;
+			open_handles.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		void close() {
+			if (fd < 0) return;
+			::close(fd);
+			syscalls.fetch_add(1, std::memory_order_relaxed);
+			open_handles.fetch_sub(1, std::memory_order_relaxed);
+			fd = -1;
+		}
+	public:
+		SysfsHandle() = default;
+		explicit SysfsHandle(std::string path) : file(std::move(path)) {}
+		SysfsHandle(const SysfsHandle&) = delete;
+		SysfsHandle& operator=(const SysfsHandle&) = delete;
+		SysfsHandle(SysfsHandle&& other) noexcept : file(std::move(other.file)), fd(std::exchange(other.fd, -1)) {}
+		SysfsHandle& operator=(SysfsHandle&& other) noexcept {
+			if (this != &other) {
+				close();
+				file = std::move(other.file);
+				fd = std::exchange(other.fd, -1);
+			}
+			return *this;
+		}
+		~SysfsHandle() { close(); }
+
+		const std::string& path() const { return file; }
+		bool empty() const { return file.empty(); }
+		bool is_open() const { return fd >= 0; }
+
+		//* Current value trimmed of whitespace, false if the attribute couldn't be read.
+		//* <value> points into a per thread buffer and is valid until the next read on the same thread
+		bool read(std::string_view& value) {
+			thread_local std::array<char, 4096> buffer;
+			if (file.empty()) return false;
+			for (int attempt = 0; attempt < 2; attempt++) {
+				if (fd < 0 and not open()) return false;
+				ssize_t got;
+				do {
+					got = ::pread(fd, buffer.data(), buffer.size(), 0);
+					syscalls.fetch_add(1, std::memory_order_relaxed);
+				} while (got < 0 and errno == EINTR);
+				if (got >= 0) {
+					value = trim({buffer.data(), (size_t)got});
+					return true;
+				}
+				//? Other errors like EIO or ENODATA are usually transient sensor faults, keep the handle for the next read
+				if (errno != ENODEV and errno != ENOENT and errno != ESTALE) return false;
+				close();
+			}
+			return false;
+		}
+
+		//* Value parsed as an integer, <fallback> if it couldn't be read or parsed
+		template <typename T>
+		T read_int(T fallback = 0) {
+			std::string_view value;
+			return (read(value) ? to_int<T>(value, fallback) : fallback);
+		}
+
+		//* Value as a string, <fallback> if it couldn't be read or was empty
+		std::string read_string(std::string_view fallback = {}) {
+			std::string_view value;
+			return std::string(read(value) and not value.empty() ? value : fallback);
+		}
+	};
+
+	//* Call <func>(cpu) for each cpu in a sysfs cpu list like "0-3,8,10-11"
+	template <typename F>
+	void for_each_cpu(std::string_view list, F&& func) {
+		Splitter ranges(trim(list), ',');
+		for (std::string_view range; ranges.next(range);) {
+			const size_t dash = range.find('-');
+			const int first = to_int<int>(range.substr(0, dash), -1);
+			const int last = (dash == std::string_view::npos ? first : to_int<int>(range.substr(dash + 1), -1));
+			for (int cpu = first; cpu >= 0 and cpu <= last; cpu++) func(cpu);
+		}
+	}
+
+	//* FNV-1a hash of <key>, constexpr so keys can be switched on with the hashes of the expected names as cases
+	constexpr uint64_t fnv1a(std::string_view key) {
+		uint64_t hash = 14695981039346656037ULL;
+		for (const char c : key) hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+		return hash;
+	}
+
+	//* Call <func>(key, value) for each "key<sep>value" line in <text>, both are trimmed of whitespace.
+	//* Lines without <sep> are skipped, <func> returns false to stop scanning
+	template <typename F>
+	void scan_keys(std::string_view text, char sep, F&& func) {
+		Lines lines(text);
+		for (std::string_view line; lines.next(line);) {
+			const size_t split = (sep == ' ' ? line.find_first_of(" \t") : line.find(sep));
+			if (split == std::string_view::npos) continue;
+			if (not func(trim(line.substr(0, split)), trim(line.substr(split + 1)))) return;
+		}
+	}
+}
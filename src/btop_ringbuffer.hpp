@@ -0,0 +1,173 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+//* How values pushed to a RingBuffer are narrowed to its element type
+namespace RingPolicy {
+
+	//* Values outside the range of the element type are clamped to it
+	struct Saturate {
+		template <typename T>
+		static constexpr T store(long long value) {
+			if constexpr (std::is_unsigned_v<T>) {
+				if (value <= 0) return 0;
+				return (T)std::min<unsigned long long>(value, std::numeric_limits<T>::max());
+			}
+			else return (T)std::clamp<long long>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+		}
+	};
+
+	//* Values are clamped to 0-100
+	struct Percent {
+		template <typename T>
+		static constexpr T store(long long value) {
+			return (T)std::clamp(value, 0ll, 100ll);
+		}
+	};
+}
+
+//* History of values stored as <T>, pushing to a full buffer drops the oldest value.
+//* Values are pushed and read back as long long, a buffer without a capacity grows as needed.
+template <typename T, typename Policy = RingPolicy::Saturate>
+class RingBuffer {
+	std::vector<T> buf;
+	size_t head = 0, count = 0, limit = 0;
+
+	size_t slot(size_t index) const {
+		index += head;
+		return (index >= buf.size() ? index - buf.size() : index);
+	}
+
+	//? Move the newest values that fit to the start of a new buffer of <size> slots
+	void relocate(size_t size) {
+		std::vector<T> next(size);
+		const size_t keep = std::min(count, size);
+		for (size_t i = 0; i < keep; i++) next[i] = buf[slot(count - keep + i)];
+		buf.swap(next);
+		head = 0;
+		count = keep;
+	}
+
+public:
+	using value_type = long long;
+
+	class const_iterator {
+		const RingBuffer* ring = nullptr;
+		size_t index = 0;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = long long;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = long long;
+
+		const_iterator() = default;
+		const_iterator(const RingBuffer* ring, size_t index) : ring(ring), index(index) {}
+
+		long long operator*() const { return (*ring)[index]; }
+		long long operator[](difference_type n) const { return (*ring)[index + n]; }
+		const_iterator& operator++() { ++index; return *this; }
+		const_iterator& operator--() { --index; return *this; }
+		const_iterator operator++(int) { auto old = *this; ++index; return old; }
+		const_iterator operator--(int) { auto old = *this; --index; return old; }
+		const_iterator& operator+=(difference_type n) { index += n; return *this; }
+		const_iterator& operator-=(difference_type n) { index -= n; return *this; }
+		friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+		friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+		friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+		friend difference_type operator-(const const_iterator& a, const const_iterator& b) { return (difference_type)a.index - (difference_type)b.index; }
+		friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.index == b.index; }
+		friend auto operator<=>(const const_iterator& a, const const_iterator& b) { return a.index <=> b.index; }
+	};
+
+	RingBuffer() = default;
+	RingBuffer(std::initializer_list<long long> values) {
+		for (const auto value : values) push_back(value);
+	}
+
+	//* Keep at most <size> values, dropping the oldest ones, 0 lets the buffer grow without limit
+	void set_capacity(size_t size) {
+		if (size == limit) return;
+		limit = size;
+		if (limit > 0) relocate(limit);
+	}
+
+	size_t capacity() const { return limit; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	void push_back(long long value) {
+		if (count == buf.size()) {
+			if (limit > 0) {
+				buf[head] = Policy::template store<T>(value);
+				head = slot(1);
+				return;
+			}
+			relocate(std::max<size_t>(8, buf.size() * 2));
+		}
+		buf[slot(count++)] = Policy::template store<T>(value);
+	}
+
+	void pop_front() {
+		if (count == 0) return;
+		head = slot(1);
+		count--;
+	}
+
+	void clear() {
+		head = count = 0;
+	}
+
+	long long operator[](size_t index) const { return buf[slot(index)]; }
+	long long at(size_t index) const {
+		if (index >= count) throw std::out_of_range("RingBuffer::at");
+		return buf[slot(index)];
+	}
+	long long front() const { return buf[head]; }
+	long long back() const { return buf[slot(count - 1)]; }
+
+	const_iterator begin() const { return {this, 0}; }
+	const_iterator end() const { return {this, count}; }
+	auto rbegin() const { return std::reverse_iterator(end()); }
+	auto rend() const { return std::reverse_iterator(begin()); }
+
+	//* The values from <from> to the newest as at most two contiguous spans, oldest first
+	std::array<std::span<const T>, 2> spans(size_t from = 0) const {
+		from = std::min(from, count);
+		const size_t start = slot(from), length = count - from;
+		if (start + length <= buf.size()) return {std::span<const T>(buf.data() + start, length), std::span<const T>()};
+		const size_t first = buf.size() - start;
+		return {std::span<const T>(buf.data() + start, first), std::span<const T>(buf.data(), length - first)};
+	}
+};
+
+//* History of percentages 0-100
+using PercentHistory = RingBuffer<uint8_t, RingPolicy::Percent>;
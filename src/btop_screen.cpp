@@ -0,0 +1,727 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "btop_input.hpp"
+#include "btop_screen.hpp"
+#include "btop_shared.hpp"
+#include "btop_tools.hpp"
+
+using std::clamp;
+using std::max;
+using std::min;
+
+namespace Screen {
+	atomic<uint64_t> bytes_in (0);
+	atomic<uint64_t> bytes_out (0);
+	atomic<uint64_t> frames_dropped (0);
+	atomic<uint64_t> write_latency (0);
+	atomic<uint64_t> write_latency_max (0);
+
+	namespace {
+		std::mutex screen_mtx;
+		int width = 0, height = 0;
+		vector<Cell> back, front;
+		bool front_valid = false;
+
+		//? Cursor and pen of the replayed frames
+		int row = 0, col = 0, saved_row = 0, saved_col = 0;
+		Pen pen;
+		int last_cell = -1;
+
+		//? What is known about the real terminal, -1 / false when unknown
+		int term_row = -1, term_col = -1;
+		Pen term_pen;
+		bool term_pen_valid = false;
+
+		//? Writer thread, frames are queued by write() and picked up by _writer
+		pthread_t writer_id;
+		std::condition_variable work_cv, idle_cv;
+		atomic<bool> writer_running (false);
+		atomic<bool> writer_stop (false);
+		bool writer_busy = false;
+		bool pending_diff = false;
+		string pending_raw;
+		uint64_t pending_time = 0;
+
+		//? Unwritten raw output above this size is dropped in favour of a full redraw of the latest frame
+		constexpr size_t max_pending_raw = 1 << 20;
+		int out_fd = -1;
+
+		void resize(int w, int h) {
+			width = max(0, w);
+			height = max(0, h);
+			back.assign(width * height, Cell{});
+			front.assign(width * height, Cell{});
+			front_valid = false;
+			row = min(row, max(0, height - 1));
+			col = min(col, max(0, width - 1));
+			last_cell = -1;
+			term_row = term_col = -1;
+		}
+
+		//* Turn what is left of a double width glyph into a space when one of its halves is overwritten
+		void split_wide(int idx) {
+			const int x = idx % width;
+			if (back[idx].width == 0 and x > 0 and back[idx - 1].width == 2) {
+				auto& left = back[idx - 1];
+				left.width = left.len = 1;
+				left.ch = {' '};
+			}
+			else if (back[idx].width == 2 and x + 1 < width) {
+				auto& right = back[idx + 1];
+				right.width = right.len = 1;
+				right.ch = {' '};
+			}
+		}
+
+		void put(const char* p, int len, int w) {
+			//? Zero width characters are combined with the previously written cell
+			if (w == 0) {
+				if (last_cell >= 0) {
+					auto& c = back[last_cell];
+					if (c.len + len <= (int)c.ch.size()) {
+						std::memcpy(c.ch.data() + c.len, p, len);
+						c.len += len;
+					}
+				}
+				return;
+			}
+			if (row >= height or col + w > width) {
+				col += w;
+				last_cell = -1;
+				return;
+			}
+			const int idx = row * width + col;
+			split_wide(idx);
+			if (w == 2) split_wide(idx + 1);
+
+			auto& c = back[idx];
+			c.pen = pen;
+			c.width = w;
+			c.len = len;
+			c.ch = {};
+			std::memcpy(c.ch.data(), p, len);
+			if (w == 2) {
+				auto& right = back[idx + 1];
+				right.pen = pen;
+				right.width = right.len = 0;
+				right.ch = {};
+			}
+			last_cell = idx;
+			col += w;
+		}
+
+		//* Clear cells [from, to) with the current background color, like a terminal with bce does
+		void erase(int from, int to) {
+			from = max(0, from);
+			to = min(width * height, to);
+			if (from >= to) return;
+			split_wide(from);
+			split_wide(to - 1);
+			const Cell blank{{pen.fg, pen.bg, 0}};
+			std::fill(back.begin() + from, back.begin() + to, blank);
+			last_cell = -1;
+		}
+
+		void sgr(Pen& pen, const int* p, int n) {
+			if (n == 0) {
+				pen = {};
+				return;
+			}
+			for (int i = 0; i < n; i++) {
+				const int v = max(0, p[i]);
+				if (v == 0) pen = {};
+				else if (v == 1) pen.attrs |= Bold;
+				else if (v == 2) pen.attrs |= Dim;
+				else if (v == 3) pen.attrs |= Italic;
+				else if (v == 4) pen.attrs |= Underline;
+				else if (v == 5) pen.attrs |= Blink;
+				else if (v == 7) pen.attrs |= Reverse;
+				else if (v == 8) pen.attrs |= Hidden;
+				else if (v == 9) pen.attrs |= Strike;
+				else if (v == 22) pen.attrs &= ~(Bold | Dim);
+				else if (v == 23) pen.attrs &= ~Italic;
+				else if (v == 24) pen.attrs &= ~Underline;
+				else if (v == 25) pen.attrs &= ~Blink;
+				else if (v == 27) pen.attrs &= ~Reverse;
+				else if (v == 28) pen.attrs &= ~Hidden;
+				else if (v == 29) pen.attrs &= ~Strike;
+				else if (v >= 30 and v <= 37) pen.fg = Basic << 24 | (v - 30);
+				else if (v >= 90 and v <= 97) pen.fg = Basic << 24 | (v - 90 + 8);
+				else if (v >= 40 and v <= 47) pen.bg = Basic << 24 | (v - 40);
+				else if (v >= 100 and v <= 107) pen.bg = Basic << 24 | (v - 100 + 8);
+				else if (v == 39) pen.fg = Default;
+				else if (v == 49) pen.bg = Default;
+				else if (v == 38 or v == 48) {
+					uint32_t color;
+					if (i + 2 < n and p[i + 1] == 5) {
+						color = Indexed << 24 | (max(0, p[i + 2]) & 0xff);
+						i += 2;
+					}
+					else if (i + 4 < n and p[i + 1] == 2) {
+						color = Rgb << 24 | (max(0, p[i + 2]) & 0xff) << 16 | (max(0, p[i + 3]) & 0xff) << 8 | (max(0, p[i + 4]) & 0xff);
+						i += 4;
+					}
+					else return;
+					(v == 38 ? pen.fg : pen.bg) = color;
+				}
+			}
+		}
+
+		struct Csi {
+			//? Parameters past the limit are dropped, xterm and vte keep about as many
+			array<int, 32> params;
+			int count = 0;
+			char final = 0;
+			bool priv = false;
+		};
+
+		//* Parse the CSI sequence starting at <i>, just after "\e[", returns the index after it or npos if it's incomplete
+		size_t parse_csi(const string& s, size_t i, Csi& seq) {
+			const size_t n = s.size();
+			if (i < n and s[i] >= '<' and s[i] <= '?') {
+				seq.priv = true;
+				while (i < n and (s[i] < 0x40 or s[i] > 0x7e)) i++;
+				if (i >= n) return string::npos;
+				seq.final = s[i];
+				return i + 1;
+			}
+			int value = -1;
+			while (i < n and ((s[i] >= '0' and s[i] <= '9') or s[i] == ';' or s[i] == ':')) {
+				if (s[i] == ';' or s[i] == ':') {
+					if (seq.count < (int)seq.params.size()) seq.params[seq.count++] = value;
+					value = -1;
+				}
+				else value = max(0, value) * 10 + (s[i] - '0');
+				i++;
+			}
+			if ((value >= 0 or seq.count > 0) and seq.count < (int)seq.params.size())
+				seq.params[seq.count++] = value;
+			while (i < n and s[i] >= 0x20 and s[i] <= 0x2f) i++;
+			if (i >= n) return string::npos;
+			seq.final = s[i];
+			return i + 1;
+		}
+
+		void csi(char final, const int* p, int n) {
+			const int n0 = (n > 0 and p[0] > 0 ? p[0] : 1);
+			switch (final) {
+				case 'm': sgr(pen, p, n); return;
+				case 'H': case 'f':
+					row = n0 - 1;
+					col = (n > 1 and p[1] > 0 ? p[1] : 1) - 1;
+					break;
+				case 'A': row -= n0; break;
+				case 'B': row += n0; break;
+				case 'C': col += n0; break;
+				case 'D': col -= n0; break;
+				case 'E': row += n0; col = 0; break;
+				case 'F': row -= n0; col = 0; break;
+				case 'G': case '`': col = n0 - 1; break;
+				case 'd': row = n0 - 1; break;
+				case 's': saved_row = row; saved_col = col; return;
+				case 'u': row = saved_row; col = saved_col; break;
+				case 'J': {
+					const int mode = max(0, n > 0 ? p[0] : 0);
+					const int cur = row * width + min(col, width - 1);
+					if (mode == 0) erase(cur, width * height);
+					else if (mode == 1) erase(0, cur + 1);
+					else erase(0, width * height);
+					return;
+				}
+				case 'K': {
+					const int mode = max(0, n > 0 ? p[0] : 0);
+					const int start = row * width;
+					const int cur = start + min(col, width - 1);
+					if (mode == 0) erase(cur, start + width);
+					else if (mode == 1) erase(start, cur + 1);
+					else erase(start, start + width);
+					return;
+				}
+				case 'X': {
+					const int cur = row * width + min(col, width - 1);
+					erase(cur, min(cur + n0, row * width + width));
+					return;
+				}
+				default: return;
+			}
+			row = clamp(row, 0, max(0, height - 1));
+			col = clamp(col, 0, max(0, width - 1));
+			last_cell = -1;
+		}
+
+		void replay(const string& s) {
+			const size_t n = s.size();
+			size_t i = 0;
+			while (i < n) {
+				const auto c = static_cast<unsigned char>(s[i]);
+
+				//? Printable ascii
+				if (c >= 0x20 and c < 0x7f) {
+					put(&s[i++], 1, 1);
+				}
+				else if (c == 0x1b) {
+					if (i + 1 >= n) break;
+					const char kind = s[i + 1];
+					i += 2;
+					if (kind == '[') {
+						Csi seq;
+						i = parse_csi(s, i, seq);
+						if (i == string::npos) break;
+						//? Private modes (synchronized output, cursor visibility, ...) don't change any cells
+						if (not seq.priv) csi(seq.final, seq.params.data(), seq.count);
+					}
+					else if (kind == ']') {
+						//? OSC, skip until BEL or ST
+						while (i < n and s[i] != '\a' and not (s[i] == 0x1b and i + 1 < n and s[i + 1] == '\\')) i++;
+						i += (i < n and s[i] == 0x1b ? 2 : 1);
+					}
+					else if (kind == '7') {
+						saved_row = row;
+						saved_col = col;
+					}
+					else if (kind == '8') {
+						row = saved_row;
+						col = saved_col;
+					}
+				}
+				else if (c < 0x20 or c == 0x7f) {
+					if (c == '\r') col = 0;
+					else if (c == '\n') row = min(row + 1, max(0, height - 1));
+					else if (c == '\b') col = max(0, col - 1);
+					else if (c == '\t') col = min((col / 8 + 1) * 8, max(0, width - 1));
+					last_cell = -1;
+					i++;
+				}
+				else {
+					//? UTF-8 sequence, invalid bytes are passed on as single width cells
+					int len = (c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : c >= 0xc0 ? 2 : 1);
+					len = min<int>(len, n - i);
+					uint32_t cp = (len == 1 ? c : c & (0x3f >> (len - 1)));
+					for (int j = 1; j < len; j++) cp = cp << 6 | (static_cast<unsigned char>(s[i + j]) & 0x3f);
+
+					const int w = (len > 1 ? Tools::char_width(cp) : 1);
+					put(&s[i], len, w);
+					i += len;
+				}
+			}
+		}
+
+		//? ------------------------------------------ Output generation ------------------------------------------
+
+		inline void add_num(string& out, int v) {
+			array<char, 12> buf;
+			const auto res = std::to_chars(buf.data(), buf.data() + buf.size(), v);
+			out.append(buf.data(), res.ptr);
+		}
+
+		inline int digits(int v) {
+			return (v < 10 ? 1 : v < 100 ? 2 : v < 1000 ? 3 : v < 10000 ? 4 : 5);
+		}
+
+		void add_code(string& out, int code) {
+			if (not out.empty()) out += ';';
+			add_num(out, code);
+		}
+
+		void add_color(string& out, uint32_t color, bool bg) {
+			const uint32_t v = color & 0xffffff;
+			switch (color >> 24) {
+				case Basic:
+					add_code(out, (v < 8 ? (bg ? 40 : 30) + v : (bg ? 100 : 90) + v - 8));
+					return;
+				case Indexed:
+					add_code(out, bg ? 48 : 38);
+					add_code(out, 5);
+					add_code(out, v);
+					return;
+				case Rgb:
+					add_code(out, bg ? 48 : 38);
+					add_code(out, 2);
+					add_code(out, v >> 16);
+					add_code(out, (v >> 8) & 0xff);
+					add_code(out, v & 0xff);
+					return;
+				default:
+					add_code(out, bg ? 49 : 39);
+			}
+		}
+
+		constexpr array<std::pair<Attr, int>, 8> attr_codes = {{
+			{Bold, 1}, {Dim, 2}, {Italic, 3}, {Underline, 4}, {Blink, 5}, {Reverse, 7}, {Hidden, 8}, {Strike, 9}
+		}};
+
+		//* Switch the terminal pen with the shortest of a full reset or only the changed parts
+		void set_pen(string& out, const Pen& p) {
+			if (term_pen_valid and p == term_pen) return;
+
+			string reset = "0";
+			for (const auto& [attr, code] : attr_codes)
+				if (p.attrs & attr) add_code(reset, code);
+			if (p.fg != Default) add_color(reset, p.fg, false);
+			if (p.bg != Default) add_color(reset, p.bg, true);
+
+			string changes;
+			if (term_pen_valid) {
+				const uint16_t off = term_pen.attrs & ~p.attrs;
+				uint16_t on = p.attrs & ~term_pen.attrs;
+				if (off & (Bold | Dim)) {
+					add_code(changes, 22);
+					on |= p.attrs & (Bold | Dim);
+				}
+				if (off & Italic) add_code(changes, 23);
+				if (off & Underline) add_code(changes, 24);
+				if (off & Blink) add_code(changes, 25);
+				if (off & Reverse) add_code(changes, 27);
+				if (off & Hidden) add_code(changes, 28);
+				if (off & Strike) add_code(changes, 29);
+				for (const auto& [attr, code] : attr_codes)
+					if (on & attr) add_code(changes, code);
+				if (p.fg != term_pen.fg) add_color(changes, p.fg, false);
+				if (p.bg != term_pen.bg) add_color(changes, p.bg, true);
+			}
+
+			out += Fx::e;
+			out += (term_pen_valid and changes.size() <= reset.size() ? changes : reset);
+			out += 'm';
+			term_pen = p;
+			term_pen_valid = true;
+		}
+
+		//* Move the terminal cursor with the shortest sequence available, reprinting unchanged cells if that's cheaper
+		void move_to(string& out, int y, int x) {
+			if (term_row == y and term_col == x) return;
+			const int cup_len = 3 + digits(y + 1) + (x > 0 ? 1 + digits(x + 1) : 0);
+
+			if (term_row == y and term_col >= 0) {
+				if (x == 0) {
+					out += '\r';
+					term_col = 0;
+					return;
+				}
+				const int gap = abs(x - term_col);
+				const int rel_len = (gap == 1 ? 3 : 3 + digits(gap));
+				if (x > term_col and front_valid and term_pen_valid and gap < rel_len) {
+					const int start = y * width + term_col;
+					int bytes = 0;
+					bool reuse = true;
+					for (int i = start; i < start + gap and reuse; i++) {
+						reuse = (back[i].width == 1 and back[i].pen == term_pen);
+						bytes += back[i].len;
+					}
+					if (reuse and bytes <= rel_len) {
+						for (int i = start; i < start + gap; i++)
+							out.append(back[i].ch.data(), back[i].len);
+						term_col = x;
+						return;
+					}
+				}
+				if (rel_len < cup_len) {
+					out += Fx::e;
+					if (gap > 1) add_num(out, gap);
+					out += (x > term_col ? 'C' : 'D');
+					term_col = x;
+					return;
+				}
+			}
+
+			out += Fx::e;
+			add_num(out, y + 1);
+			if (x > 0) {
+				out += ';';
+				add_num(out, x + 1);
+			}
+			out += 'H';
+			term_row = y;
+			term_col = x;
+		}
+
+		//* Copy <s> without the SGR sequences, the pen they leave is set with a single sequence right before
+		//* the next text or erase and only if it differs from what the terminal already uses
+		string coalesce(const string& s) {
+			string out;
+			out.reserve(s.size());
+			Pen want = pen;
+			const size_t n = s.size();
+			size_t i = 0;
+			while (i < n) {
+				const size_t esc = s.find('\x1b', i);
+				if (esc != i) {
+					const size_t end = (esc == string::npos ? n : esc);
+					//? Control characters only move the cursor, anything else is text drawn with the current pen
+					if (std::any_of(s.begin() + i, s.begin() + end, [](char c) { return static_cast<unsigned char>(c) >= 0x20; }))
+						set_pen(out, want);
+					out.append(s, i, end - i);
+					i = end;
+					continue;
+				}
+				if (i + 1 >= n or s[i + 1] != '[') {
+					//? Other escapes are copied as is, OSC up to its terminator
+					size_t end = min(n, i + 2);
+					if (i + 1 < n and s[i + 1] == ']') {
+						while (end < n and s[end] != '\a' and not (s[end] == 0x1b and end + 1 < n and s[end + 1] == '\\')) end++;
+						end = min(n, end + (end < n and s[end] == 0x1b ? 2 : 1));
+					}
+					out.append(s, i, end - i);
+					i = end;
+					continue;
+				}
+				Csi seq;
+				const size_t end = parse_csi(s, i + 2, seq);
+				if (end == string::npos) {
+					out.append(s, i);
+					break;
+				}
+				if (not seq.priv and seq.final == 'm')
+					sgr(want, seq.params.data(), seq.count);
+				else {
+					//? Erasing fills with the current background color
+					if (not seq.priv and (seq.final == 'J' or seq.final == 'K' or seq.final == 'X'))
+						set_pen(out, want);
+					out.append(s, i, end - i);
+				}
+				i = end;
+			}
+			return out;
+		}
+
+		//* Diff the back buffer against the front buffer and return the output needed to update the terminal
+		string diff_output() {
+			string out;
+			for (int y = 0; y < height; y++) {
+				const int row_start = y * width;
+				for (int x = 0; x < width;) {
+					const int idx = row_start + x;
+					const auto& cell = back[idx];
+					if (cell.width == 0) {
+						x++;
+						continue;
+					}
+					const bool dirty = not front_valid or cell != front[idx]
+						or (cell.width == 2 and back[idx + 1] != front[idx + 1]);
+					if (not dirty) {
+						x++;
+						continue;
+					}
+
+					move_to(out, y, x);
+					set_pen(out, cell.pen);
+					out.append(cell.ch.data(), cell.len);
+					front[idx] = cell;
+					if (cell.width == 2) front[idx + 1] = back[idx + 1];
+
+					x += cell.width;
+					term_col = x;
+					//? Cursor position after writing the last column depends on the terminals autowrap handling
+					if (x >= width) term_row = term_col = -1;
+				}
+			}
+			front_valid = true;
+			return out;
+		}
+
+		//* Collect everything queued since the last call, caller must hold screen_mtx
+		string take_output() {
+			string out;
+			out.swap(pending_raw);
+			if (pending_diff) {
+				out += diff_output();
+				pending_diff = false;
+			}
+			bytes_out += out.size();
+			return out;
+		}
+
+		//* Write <out> wrapped in synchronized output markers, waits for the tty when it can't keep up
+		bool write_all(const string& out) {
+			array<iovec, 3> iov = {{
+				{const_cast<char*>(Term::sync_start.data()), Term::sync_start.size()},
+				{const_cast<char*>(out.data()), out.size()},
+				{const_cast<char*>(Term::sync_end.data()), Term::sync_end.size()}
+			}};
+			size_t first = 0;
+			while (first < iov.size()) {
+				const ssize_t written = ::writev(out_fd, iov.data() + first, iov.size() - first);
+				if (written < 0) {
+					if (errno == EINTR) continue;
+					if (errno == EAGAIN or errno == EWOULDBLOCK) {
+						struct pollfd pfd = {out_fd, POLLOUT, 0};
+						poll(&pfd, 1, 100);
+						if (writer_stop) return false;
+						continue;
+					}
+					return false;
+				}
+				size_t left = written;
+				while (first < iov.size() and left >= iov[first].iov_len) left -= iov[first++].iov_len;
+				if (first < iov.size()) {
+					iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+					iov[first].iov_len -= left;
+				}
+			}
+			return true;
+		}
+
+		//? ------------------------------------------- Writer thread -------------------------------------------------
+		void * _writer(void *) {
+			//? Signals are handled by the main thread
+			sigset_t mask;
+			sigfillset(&mask);
+			pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+			std::unique_lock lock(screen_mtx);
+			while (true) {
+				work_cv.wait(lock, [] { return writer_stop or pending_diff or not pending_raw.empty(); });
+				if (writer_stop) break;
+
+				const string out = take_output();
+				const uint64_t submitted = pending_time;
+				writer_busy = true;
+				lock.unlock();
+
+				if (not out.empty() and not write_all(out) and not writer_stop)
+					Logger::debug("Screen: write to terminal failed: " + string{strerror(errno)});
+				const uint64_t latency = Tools::time_micros() - submitted;
+				write_latency = latency;
+				if (latency > write_latency_max) write_latency_max = latency;
+
+				lock.lock();
+				writer_busy = false;
+				idle_cv.notify_all();
+			}
+			writer_busy = false;
+			idle_cv.notify_all();
+			return nullptr;
+		}
+	}
+
+	bool start() {
+		if (writer_running) return true;
+		const char* tty = ttyname(STDOUT_FILENO);
+		out_fd = (tty != nullptr ? open(tty, O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC) : -1);
+		if (out_fd < 0) {
+			Logger::warning("Screen: failed to open terminal for writing, using synchronous output.");
+			return false;
+		}
+		writer_stop = false;
+		if (pthread_create(&writer_id, nullptr, &_writer, nullptr) != 0) {
+			Logger::warning("Screen: failed to create writer thread, using synchronous output.");
+			close(out_fd);
+			out_fd = -1;
+			return false;
+		}
+		writer_running = true;
+		return true;
+	}
+
+	void stop() {
+		if (not writer_running) return;
+		{
+			std::lock_guard lock(screen_mtx);
+			writer_stop = true;
+		}
+		work_cv.notify_all();
+		pthread_join(writer_id, nullptr);
+		writer_running = false;
+		close(out_fd);
+		out_fd = -1;
+	}
+
+	bool drain(uint64_t timeout_ms) {
+		std::unique_lock lock(screen_mtx);
+		return idle_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [] {
+			return not writer_running or writer_stop or (not writer_busy and not pending_diff and pending_raw.empty());
+		});
+	}
+
+	void write(const string& frame, bool diff) {
+		std::unique_lock lock(screen_mtx);
+		bytes_in += frame.size();
+
+		if (Term::width != width or Term::height != height)
+			resize(Term::width, Term::height);
+
+		const bool has_cells = (width > 0 and height > 0);
+		const bool queued = (pending_diff or not pending_raw.empty());
+		if (not diff and has_cells and queued and (writer_busy or pending_raw.size() > max_pending_raw)) {
+			//? The writer is blocked on the tty, what is queued is replaced by a full redraw of the back buffer
+			//? which this frame is replayed into below, so only the latest state is sent
+			pending_raw.clear();
+			++frames_dropped;
+			pending_diff = true;
+			front_valid = term_pen_valid = false;
+			term_row = term_col = -1;
+		}
+		else if (not diff or not has_cells) {
+			//? Written as is apart from redundant colors and styles, the terminal no longer matches the front buffer
+			//? Without cells there is nothing to repaint from, what is queued may end in the middle of a frame so it's
+			//? replaced by a cleared screen and this frame, and the main loop is woken to redraw every box like after a resize
+			//? The colors and position the dropped bytes would have left are unknown, so nothing in this frame is skipped
+			if (pending_raw.size() > max_pending_raw) {
+				term_pen_valid = false;
+				term_row = term_col = -1;
+				pending_raw = Term::clear + Fx::reset + coalesce(frame);
+				++frames_dropped;
+				Global::resized = true;
+				Input::interrupt();
+			}
+			else pending_raw += coalesce(frame);
+			front_valid = false;
+			term_row = term_col = -1;
+		}
+		else {
+			//? The previous frame hasn't been written yet, it's superseded by this one
+			if (pending_diff) ++frames_dropped;
+			pending_diff = true;
+		}
+		if (has_cells) replay(frame);
+		pending_time = Tools::time_micros();
+
+		if (writer_running) {
+			lock.unlock();
+			work_cv.notify_one();
+			return;
+		}
+
+		const string out = take_output();
+		lock.unlock();
+		std::cout << Term::sync_start << out << Term::sync_end << std::flush;
+	}
+
+	void invalidate() {
+		std::lock_guard lock(screen_mtx);
+		front_valid = term_pen_valid = false;
+		term_row = term_col = -1;
+	}
+}
@@ -0,0 +1,93 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::array;
+using std::atomic;
+using std::string;
+using std::vector;
+
+//* Cell based screen model, the escape sequence output of the draw functions is replayed into a back buffer
+//* and only the cells that differ from what is already on the terminal (the front buffer) are written out
+namespace Screen {
+
+	//* Text attributes tracked per cell
+	enum Attr : uint16_t {
+		Bold		= 1 << 0,
+		Dim			= 1 << 1,
+		Italic		= 1 << 2,
+		Underline	= 1 << 3,
+		Blink		= 1 << 4,
+		Reverse		= 1 << 5,
+		Hidden		= 1 << 6,
+		Strike		= 1 << 7,
+	};
+
+	//* Colors are packed as <type << 24 | value>, type 0 = terminal default, 1 = 16 color index, 2 = 256 color index, 3 = 24-bit rgb
+	enum ColorType : uint32_t { Default = 0, Basic = 1, Indexed = 2, Rgb = 3 };
+
+	struct Pen {
+		uint32_t fg = 0;
+		uint32_t bg = 0;
+		uint16_t attrs = 0;
+
+		bool operator==(const Pen&) const = default;
+	};
+
+	struct Cell {
+		Pen pen;
+		uint8_t width = 1;	//? 0 for the right half of a double width glyph
+		uint8_t len = 1;	//? Bytes used in ch
+		array<char, 8> ch = {' '};
+
+		bool operator==(const Cell&) const = default;
+	};
+
+	//* Total bytes passed to write() and sent to the terminal, clock and overlay writes included
+	extern atomic<uint64_t> bytes_in, bytes_out;
+
+	//* Frames replaced by a newer frame before the writer got to them
+	extern atomic<uint64_t> frames_dropped;
+
+	//* Microseconds from queueing a frame until it was written to the terminal, last and max
+	extern atomic<uint64_t> write_latency, write_latency_max;
+
+	//* Start the writer thread, frames are written synchronously from write() if this fails or hasn't been called
+	bool start();
+
+	//* Stop the writer thread, frames not yet written are discarded
+	void stop();
+
+	//* Wait for all queued output to reach the terminal, call before writing to it directly
+	bool drain(uint64_t timeout_ms);
+
+	//* Replay <frame> into the back buffer and queue the cells that changed for writing, only the latest state is
+	//* written if the terminal can't keep up, if <diff> is false <frame> is queued with only redundant SGR sequences removed
+	//* and what is queued is replaced by a full redraw when the writer is blocked on the terminal
+	void write(const string& frame, bool diff = true);
+
+	//* Forget what is on the terminal, call after writing to it without going through write()
+	void invalidate();
+}
@@ -27,13 +27,15 @@ tab-size = 4
 #include "intrin.hpp"
 
 namespace rng = std::ranges;
+using std::clamp;
+using std::max;
 using namespace Tools;
 
 #ifdef GPU_SUPPORT
 namespace Gpu {
 	vector<string> gpu_names;
 	vector<int> gpu_b_height_offsets;
-	std::unordered_map<string, deque<long long>> shared_gpu_percent = {
+	std::unordered_map<string, PercentHistory> shared_gpu_percent = {
 		{"gpu-average", {}},
 		{"gpu-vram-total", {}},
 		{"gpu-pwr-total", {}},
@@ -239,3 +241,81 @@ namespace Cpu {
 
    }
 }
+
+namespace Adaptive {
+	atomic<uint64_t> interval (2000);
+
+	namespace {
+		atomic<bool> quiet (false);
+		atomic<size_t> wakeups (0);
+		bool sample_active{};
+		uint64_t last_input{};
+		deque<uint64_t> wakeup_times;
+	}
+
+	void begin_sample() {
+		sample_active = false;
+	}
+
+	void sample(const Cpu::cpu_info& cpu) {
+		const auto& total = cpu.cpu_percent[Cpu::Field::total];
+		if (not total.empty() and total.back() > cpu_usage_max)
+			sample_active = true;
+	}
+
+	void sample(const Mem::mem_info& mem) {
+		for (const auto& [name, disk] : mem.disks) {
+			if (not disk.io_activity.empty() and disk.io_activity.back() > io_activity_max) {
+				sample_active = true;
+				return;
+			}
+		}
+	}
+
+	void sample(const Net::net_info& net) {
+		for (const auto& data : net.bandwidth) {
+			if (not data.empty() and data.back() > net_speed_max) {
+				sample_active = true;
+				return;
+			}
+		}
+	}
+
+	void end_sample() {
+		quiet = not sample_active;
+	}
+
+	bool input() {
+		last_input = time_ms();
+		const uint64_t update_ms = g_CfgMgr.get<CfgI>("update_ms").v();
+		if (interval <= update_ms) return false;
+		interval = update_ms;
+		return true;
+	}
+
+	void wakeup() {
+		const uint64_t now = time_ms();
+		wakeup_times.push_back(now);
+		while (not wakeup_times.empty() and wakeup_times.front() + 60000 < now) wakeup_times.pop_front();
+		wakeups = wakeup_times.size();
+	}
+
+	uint64_t next(uint64_t update_ms) {
+		const uint64_t now = time_ms();
+		if (last_input == 0) last_input = now;
+
+		const uint64_t old_interval = interval;
+		if (not g_CfgMgr.get<CfgB>("adaptive_update").v() or not quiet or now - last_input < input_idle_ms)
+			interval = update_ms;
+		else
+			interval = clamp(old_interval * 2, update_ms, max(update_ms, (uint64_t)g_CfgMgr.get<CfgI>("adaptive_update_max").v()));
+
+		if (interval != old_interval)
+			Logger::debug("Adaptive::next() : Update interval changed from " + to_string(old_interval) + "ms to " + to_string(interval) + "ms.");
+		return interval;
+	}
+
+	size_t wakeups_per_min() {
+		return wakeups;
+	}
+}
@@ -18,11 +18,14 @@ tab-size = 4
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <deque>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -40,6 +43,8 @@ tab-size = 4
 # include <kvm.h>
 #endif
 
+#include "btop_ringbuffer.hpp"
+
 using std::array;
 using std::atomic;
 using std::deque;
@@ -107,6 +112,36 @@ public:
 
 /////////////// OLD SHIT (YUCKERS) ////////////////////////////////////////////
 
+//* Array of <V> indexed by the enum class <E>, <names> holds the display and config name of each index.
+//* Lookups by name are linear and meant for config values, samples should be indexed by <E>
+template <typename E, typename V, const auto& names>
+class EnumArray {
+	array<V, names.size()> values{};
+
+	static size_t index(std::string_view name) {
+		for (size_t i = 0; i < names.size(); i++)
+			if (names[i] == name) return i;
+		throw std::out_of_range("EnumArray: unknown name " + string(name));
+	}
+public:
+	static constexpr size_t size() { return names.size(); }
+	static constexpr std::string_view name(E id) { return names[(size_t)id]; }
+	static bool contains(std::string_view name) { return std::ranges::find(names, name) != names.end(); }
+
+	V& operator[](E id) { return values[(size_t)id]; }
+	const V& operator[](E id) const { return values[(size_t)id]; }
+	V& at(E id) { return values.at((size_t)id); }
+	const V& at(E id) const { return values.at((size_t)id); }
+	V& operator[](std::string_view name) { return values[index(name)]; }
+	V& at(std::string_view name) { return values[index(name)]; }
+	const V& at(std::string_view name) const { return values[index(name)]; }
+
+	auto begin() { return values.begin(); }
+	auto end() { return values.end(); }
+	auto begin() const { return values.begin(); }
+	auto end() const { return values.end(); }
+};
+
 namespace Global {
 	extern const vector<array<string, 2>> Banner_src;
 	extern const string Version;
@@ -123,18 +158,37 @@ namespace Global {
 
 namespace Runner {
 
+	//* Explicit runner states, work is handed over by moving from idle to collecting
+	enum class State {
+		idle,
+		collecting,
+		drawing,
+		stopping
+	};
+
+	extern atomic<State> state;
 	extern atomic<bool> active;
 	extern atomic<bool> reading;
 	extern atomic<bool> stopping;
 	extern atomic<bool> redraw;
 	extern atomic<bool> coreNum_reset;
+	extern atomic<bool> focused;
 	extern pthread_t runner_id;
 	extern bool pause_output;
 	extern string debug_bg;
 
+	//* Cycles started by the runner thread, and cycles started while another one was still running which should never happen
+	extern atomic<uint64_t> cycles, overlapped_cycles;
+
+	//* Start the runner thread, returns false if it couldn't be created
+	bool start();
+
 	void run(const string& box="", bool no_update = false, bool force_redraw = false);
 	void stop();
 
+	//* Wait until runner is idle or <wait_ms> milliseconds have passed, returns true if idle
+	bool wait_idle(const uint64_t wait_ms);
+
 }
 
 namespace Tools {
@@ -162,6 +216,29 @@ namespace Shared {
 #endif
 }
 
+//* Pressure stall information from /proc/pressure, how much of the time tasks were stalled waiting for a resource
+namespace Pressure {
+	enum class Resource : uint8_t { cpu, memory, io };
+	inline constexpr array<std::string_view, 3> resource_names { "cpu", "memory", "io" };
+
+	//* One line of a pressure file
+	struct stall {
+		//? Kernel running averages over the last 10 and 60 seconds, in hundredths of a percent
+		int64_t avg10 = 0, avg60 = 0;
+		//? Total stall time in microseconds and how much of it was added since the previous update
+		uint64_t total = 0, delta = 0;
+		//? Stall percentage per update, avg10 or the share of the time since the previous update in high resolution mode
+		PercentHistory percent;
+	};
+
+	//* "some" is the time at least one task was stalled on the resource, "full" the time all non idle tasks were at once.
+	//* <supported> is false on kernels without PSI, "full" for cpu is only kept by cgroups and reads zero system wide
+	struct pressure_info {
+		bool supported = false;
+		uint64_t sampled = 0;
+		stall some, full;
+	};
+}
 
 namespace Gpu {
 #ifdef GPU_SUPPORT
@@ -176,7 +253,7 @@ namespace Gpu {
 	extern vector<int> gpu_b_height_offsets;
 	extern long long gpu_pwr_total_max;
 
-	extern std::unordered_map<string, deque<long long>> shared_gpu_percent; // averages, power/vram total
+	extern std::unordered_map<string, PercentHistory> shared_gpu_percent; // averages, power/vram total
 
 	const array mem_names { "used"s, "free"s };
 
@@ -202,7 +279,7 @@ namespace Gpu {
 
 	//* Per-device container for GPU info
 	struct gpu_info {
-		std::unordered_map<string, deque<long long>> gpu_percent = {
+		std::unordered_map<string, PercentHistory> gpu_percent = {
 			{"gpu-totals", {}},
 			{"gpu-vram-totals", {}},
 			{"gpu-pwr-totals", {}},
@@ -213,12 +290,12 @@ namespace Gpu {
 		long long pwr_max_usage = 255000;
 		long long pwr_state;
 
-		deque<long long> temp = {0};
+		RingBuffer<int16_t> temp = {0};
 		long long temp_max = 110;
 
 		long long mem_total = 0;
 		long long mem_used = 0;
-		deque<long long> mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
+		PercentHistory mem_utilization_percent = {0}; // TODO: properly handle GPUs that can't report some stats
 		long long mem_clock_speed = 0; // MHz
 
 		long long pcie_tx = 0; // KB/s
@@ -258,29 +335,71 @@ namespace Cpu {
 	extern vector<string> available_sensors;
 	extern tuple<int, float, long, string> current_bat;
 
+	//* Cpu usage fields, total followed by the time fields in /proc/stat order
+	enum class Field : uint8_t {
+		total, user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice
+	};
+	inline constexpr array<std::string_view, 11> field_names {
+		"total", "user", "nice", "system", "idle", "iowait", "irq", "softirq", "steal", "guest", "guest_nice"
+	};
+
+	//* Topology levels the cores can be grouped by, the names double as cpu_core_view values
+	enum class Level : uint8_t { socket, node, llc };
+	inline constexpr array<std::string_view, 3> level_names { "socket", "node", "llc" };
+
+	//* Cores sharing a socket, NUMA node or last level cache, with their average usage and hottest core temperature
+	struct core_group {
+		int id{};
+		vector<int> cores;
+		PercentHistory percent;
+		RingBuffer<int16_t> temp;
+	};
+
+	//* Performance counter rates of a core over the last update
+	struct core_counters {
+		//? Instructions per cycle in hundredths and the percent of cache references and branches that missed, -1 if not counted
+		long long ipc = -1, cache_miss = -1, branch_miss = -1;
+		//? Context switches per second, only counted by the software fallback
+		long long switches = -1;
+	};
+
 	struct cpu_info {
-		std::unordered_map<string, deque<long long>> cpu_percent = {
-			{"total", {}},
-			{"user", {}},
-			{"nice", {}},
-			{"system", {}},
-			{"idle", {}},
-			{"iowait", {}},
-			{"irq", {}},
-			{"softirq", {}},
-			{"steal", {}},
-			{"guest", {}},
-			{"guest_nice", {}}
-		};
-		vector<deque<long long>> core_percent;
-		vector<deque<long long>> temp;
+		EnumArray<Field, PercentHistory, field_names> cpu_percent;
+		vector<PercentHistory> core_percent;
+		vector<RingBuffer<int16_t>> temp;
 		long long temp_max = 0;
 		array<double, 3> load_avg;
+		//? Per core frequencies in MHz, min/avg/max are over the online cores and freq_top is the highest seen on any core
+		vector<RingBuffer<uint16_t>> core_freq;
+		long long freq_min = 0, freq_avg = 0, freq_max = 0, freq_top = 0;
+		EnumArray<Level, vector<core_group>, level_names> groups;
+		Pressure::pressure_info pressure;
+		//? Per core performance counters when cpu_pmu is on, counters_hardware is false when only software counters could be opened
+		vector<core_counters> counters;
+		bool counters_hardware = false;
+		//? Context switches and forks per second since the previous update and the tasks runnable and blocked on io, from /proc/stat
+		long long ctxt_rate = 0, fork_rate = 0, procs_running = 0, procs_blocked = 0;
+		//? Average run queue wait per timeslice of each core in microseconds from /proc/schedstat, empty without schedstats
+		vector<long long> core_run_wait;
 	};
 
+	//* Cores in each group of every level, set by the collector when it reads the topology so calcSizes can fit the core box
+	extern EnumArray<Level, vector<int>, level_names> group_sizes;
+
+	//* Group of the grouped core views whose cores are shown, -1 shows the groups themselves
+	extern int drill_group;
+
+	//* Per core performance counters are open, set by the collector so calcSizes can make room for them next to the cores
+	extern bool has_counters;
+
 	//* Collect cpu stats and temperatures
 	auto collect(bool no_update = false) -> cpu_info&;
 
+#ifdef __linux__
+	//* Parse the leading "cpu" lines of /proc/stat in <data> into <cpu>
+	void parse_stat(std::string_view data, cpu_info& cpu);
+#endif
+
 	//* Draw contents of cpu box using <cpu> as source
     string draw(const cpu_info& cpu, const vector<Gpu::gpu_info>& gpu, bool force_redraw = false, bool data_same = false);
 
@@ -299,8 +418,18 @@ namespace Mem {
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
 	extern bool has_swap, shown, redraw;
-	const array mem_names { "used"s, "available"s, "cached"s, "free"s };
-	const array swap_names { "swap_used"s, "swap_free"s };
+
+	//* Memory and io pressure is shown in the mem box, set by the collector when the kernel has PSI and show_pressure is on
+	extern bool has_pressure;
+	//* Memory and swap fields
+	enum class Field : uint8_t {
+		used, available, cached, free, swap_total, swap_used, swap_free
+	};
+	inline constexpr array<std::string_view, 7> field_names {
+		"used", "available", "cached", "free", "swap_total", "swap_used", "swap_free"
+	};
+	inline constexpr array mem_fields { Field::used, Field::available, Field::cached, Field::free };
+	inline constexpr array swap_fields { Field::swap_used, Field::swap_free };
 	extern int disk_ios;
 
 	struct disk_info {
@@ -315,20 +444,18 @@ namespace Mem {
 		int free_percent{};
 
 		array<int64_t, 3> old_io = {0, 0, 0};
-		deque<long long> io_read = {};
-		deque<long long> io_write = {};
-		deque<long long> io_activity = {};
+		RingBuffer<uint64_t> io_read = {};
+		RingBuffer<uint64_t> io_write = {};
+		RingBuffer<uint32_t> io_activity = {};
 	};
 
 	struct mem_info {
-		std::unordered_map<string, uint64_t> stats =
-			{{"used", 0}, {"available", 0}, {"cached", 0}, {"free", 0},
-			{"swap_total", 0}, {"swap_used", 0}, {"swap_free", 0}};
-		std::unordered_map<string, deque<long long>> percent =
-			{{"used", {}}, {"available", {}}, {"cached", {}}, {"free", {}},
-			{"swap_total", {}}, {"swap_used", {}}, {"swap_free", {}}};
+		EnumArray<Field, uint64_t, field_names> stats;
+		EnumArray<Field, PercentHistory, field_names> percent;
 		std::unordered_map<string, disk_info> disks;
 		vector<string> disks_order;
+		//? Only memory and io are collected here, cpu pressure is part of cpu_info
+		EnumArray<Pressure::Resource, Pressure::pressure_info, Pressure::resource_names> pressure;
 	};
 
 	//?* Get total system memory
@@ -337,6 +464,12 @@ namespace Mem {
 	//* Collect mem & disks stats
 	auto collect(bool no_update = false) -> mem_info&;
 
+#ifdef __linux__
+	//* Parse the free, available, cached and swap fields of /proc/meminfo in <data> into <mem>, available is free + cached
+	//* on kernels without MemAvailable. Stops at Cached unless <need_swap>
+	void parse_meminfo(std::string_view data, mem_info& mem, bool need_swap);
+#endif
+
 	//* Draw contents of mem box using <mem> as source
 	string draw(const mem_info& mem, bool force_redraw = false, bool data_same = false);
 
@@ -349,7 +482,13 @@ namespace Net {
 	extern string selected_iface;
 	extern vector<string> interfaces;
 	extern bool rescale;
-	extern std::unordered_map<string, uint64_t> graph_max;
+
+	//* Traffic directions
+	enum class Direction : uint8_t { download, upload };
+	inline constexpr array<std::string_view, 2> direction_names { "download", "upload" };
+	inline constexpr array directions { Direction::download, Direction::upload };
+
+	extern EnumArray<Direction, uint64_t, direction_names> graph_max;
 
 	struct net_stat {
 		uint64_t speed{};
@@ -361,8 +500,8 @@ namespace Net {
 	};
 
 	struct net_info {
-		std::unordered_map<string, deque<long long>> bandwidth = { {"download", {}}, {"upload", {}} };
-		std::unordered_map<string, net_stat> stat = { {"download", {}}, {"upload", {}} };
+		EnumArray<Direction, RingBuffer<uint64_t>, direction_names> bandwidth;
+		EnumArray<Direction, net_stat, direction_names> stat;
 		string ipv4{};      // defaults to ""
 		string ipv6{};      // defaults to ""
 		bool connected{};
@@ -433,7 +572,6 @@ namespace Proc {
 		string cmd{};           // defaults to ""
 		string short_cmd{};     // defaults to ""
 		size_t threads{};
-		int name_offset{};
 		string user{};          // defaults to ""
 		uint64_t mem{};
 		double cpu_p{};         // defaults to = 0.0
@@ -457,8 +595,8 @@ namespace Proc {
 		proc_info entry;
 		string elapsed, parent, status, io_read, io_write, memory;
 		long long first_mem = -1;
-		deque<long long> cpu_percent;
-		deque<long long> mem_bytes;
+		PercentHistory cpu_percent;
+		RingBuffer<uint64_t> mem_bytes;
 	};
 
 	//? Contains all info for proc detailed box
@@ -492,3 +630,38 @@ namespace Proc {
 				   int cur_depth, bool collapsed, const string& filter,
 				   bool found = false, bool no_update = false, bool should_filter = false);
 }
+
+//* Stretches the update interval while the system and user are idle, see config option adaptive_update
+namespace Adaptive {
+	//? Thresholds below which a collected sample counts as idle
+	constexpr long long cpu_usage_max = 10;			// percent total cpu usage
+	constexpr long long net_speed_max = 32 << 10;	// bytes/s download or upload speed
+	constexpr long long io_activity_max = 5;		// percent disk activity
+	constexpr uint64_t input_idle_ms = 10000;		// time without input before stretching
+
+	//* Current effective update interval in milliseconds
+	extern atomic<uint64_t> interval;
+
+	//* Called by the runner at the start of a collection cycle
+	void begin_sample();
+
+	//* Mark the current sample as active if usage, speed or disk activity exceed the thresholds
+	void sample(const Cpu::cpu_info& cpu);
+	void sample(const Mem::mem_info& mem);
+	void sample(const Net::net_info& net);
+
+	//* Called by the runner when a collection cycle is done
+	void end_sample();
+
+	//* Register user input, returns true if the interval was stretched and has been reset
+	bool input();
+
+	//* Calculate the interval until the next update
+	uint64_t next(uint64_t update_ms);
+
+	//* Record a wakeup of the main loop, called each time it returns from waiting on input or a timeout
+	void wakeup();
+
+	//* Number of main loop wakeups during the last 60 seconds
+	size_t wakeups_per_min();
+}
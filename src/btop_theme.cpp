@@ -45,6 +45,23 @@ namespace Theme {
 	std::unordered_map<string, string> colors;
 	std::unordered_map<string, array<int, 3>> rgbs;
 	std::unordered_map<string, array<string, 101>> gradients;
+	array<string, static_cast<size_t>(Color::count)> color_table;
+	array<array<string, 101>, static_cast<size_t>(Gradient::count)> gradient_table;
+	array<bool, static_cast<size_t>(Gradient::count)> gradient_set;
+
+	//? Theme file names of the ids in Color and Gradient, in the same order
+	constexpr array<std::string_view, static_cast<size_t>(Color::count)> color_names = {
+		"main_bg", "main_fg", "title", "hi_fg", "selected_bg", "selected_fg", "inactive_fg", "graph_text", "meter_bg", "proc_misc",
+		"cpu_box", "mem_box", "net_box", "proc_box", "div_line",
+		"temp_start", "temp_mid", "temp_end", "cpu_start", "cpu_mid", "cpu_end",
+		"free_start", "free_mid", "free_end", "cached_start", "cached_mid", "cached_end",
+		"available_start", "available_mid", "available_end", "used_start", "used_mid", "used_end",
+		"download_start", "download_mid", "download_end", "upload_start", "upload_mid", "upload_end",
+		"process_start", "process_mid", "process_end"
+	};
+	constexpr array<std::string_view, static_cast<size_t>(Gradient::count)> gradient_names = {
+		"temp", "cpu", "free", "cached", "available", "used", "download", "upload", "process", "proc", "proc_color"
+	};
 
 	const std::unordered_map<string, string> Default_theme = {
 		{ "main_bg", "#00" },
@@ -370,6 +387,19 @@ namespace Theme {
 			}
 		}
 
+		//* Resolve the generated colors and gradients into the id indexed tables
+		void fillTables() {
+			for (size_t i = 0; i < color_names.size(); i++) {
+				const auto it = colors.find(string(color_names[i]));
+				color_table[i] = (it != colors.end() ? it->second : "");
+			}
+			for (size_t i = 0; i < gradient_names.size(); i++) {
+				const auto it = gradients.find(string(gradient_names[i]));
+				gradient_set[i] = (it != gradients.end());
+				gradient_table[i] = (gradient_set[i] ? it->second : array<string, 101>{});
+			}
+		}
+
 		//* Load a .theme file from disk
 		auto loadFile(const string& filename) {
 			std::unordered_map<string, string> theme_out;
@@ -442,9 +472,17 @@ namespace Theme {
 			generateColors((theme == "Default" or theme_path.empty() ? Default_theme : loadFile(theme_path)));
 			generateGradients();
 		}
-		Term::fg = colors.at("main_fg");
-		Term::bg = colors.at("main_bg");
+		fillTables();
+		Term::fg = c(Color::main_fg);
+		Term::bg = c(Color::main_bg);
 		Fx::reset = Fx::reset_base + Term::fg + Term::bg;
 	}
 
+	Gradient gradient_id(std::string_view name) {
+		for (size_t i = 0; i < gradient_names.size(); i++) {
+			if (gradient_names[i] == name) return static_cast<Gradient>(i);
+		}
+		return Gradient::none;
+	}
+
 }
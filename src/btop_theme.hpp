@@ -19,8 +19,10 @@ tab-size = 4
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 
@@ -53,19 +55,44 @@ namespace Theme {
 	//* Set current theme from current "color_theme" value in config
 	void setTheme();
 
+	//* Theme colors, draw code uses these ids and setTheme() resolves them to escape codes
+	enum class Color : uint8_t {
+		main_bg, main_fg, title, hi_fg, selected_bg, selected_fg, inactive_fg, graph_text, meter_bg, proc_misc,
+		cpu_box, mem_box, net_box, proc_box, div_line,
+		temp_start, temp_mid, temp_end, cpu_start, cpu_mid, cpu_end,
+		free_start, free_mid, free_end, cached_start, cached_mid, cached_end,
+		available_start, available_mid, available_end, used_start, used_mid, used_end,
+		download_start, download_mid, download_end, upload_start, upload_mid, upload_end,
+		process_start, process_mid, process_end,
+		count
+	};
+
+	//* Theme gradients, <none> is used by graphs and meters without a gradient
+	enum class Gradient : uint8_t {
+		temp, cpu, free, cached, available, used, download, upload, process, proc, proc_color,
+		count, none = count
+	};
+
+	//* Colors, decimal rgb values and gradients by name as parsed from the theme, used to fill the id indexed tables
 	extern std::unordered_map<string, string> colors;
 	extern std::unordered_map<string, array<int, 3>> rgbs;
 	extern std::unordered_map<string, array<string, 101>> gradients;
 
-	//* Return escape code for color <name>
-   template<size_t N>
-   inline const string& c(const char (&name)[N]) { return colors.at(name); }
-	inline const string& c(const string& name) { return colors.at(name); }
+	extern array<string, static_cast<size_t>(Color::count)> color_table;
+	extern array<array<string, 101>, static_cast<size_t>(Gradient::count)> gradient_table;
+	extern array<bool, static_cast<size_t>(Gradient::count)> gradient_set;
 
-	//* Return array of escape codes for color gradient <name>
-   template<size_t N>
-   inline const array<string, 101>& g(const char (&name)[N]) { return gradients.at(name); }
-	inline const array<string, 101>& g(string name) { return gradients.at(name); }
+	//* Return escape code for color <id>
+	inline const string& c(Color id) { return color_table[static_cast<size_t>(id)]; }
+
+	//* Return array of escape codes for color gradient <id>, <id> must not be Gradient::none
+	inline const array<string, 101>& g(Gradient id) { return gradient_table[static_cast<size_t>(id)]; }
+
+	//* Return true if the current theme defines gradient <id>
+	inline bool has_gradient(Gradient id) { return id < Gradient::count and gradient_set[static_cast<size_t>(id)]; }
+
+	//* Return id of gradient <name>, Gradient::none if unknown
+	Gradient gradient_id(std::string_view name);
 
 	//* Return array of red, green and blue in decimal for color <name>
 	inline const std::array<int, 3>& dec(string name) { return rgbs.at(name); }
@@ -16,10 +16,12 @@ indent = tab
 tab-size = 4
 */
 
+#include <cctype>
+#include <charconv>
 #include <cmath>
-#include <codecvt>
 #include <iostream>
 #include <fstream>
+#include <cstring>
 #include <ctime>
 #include <sstream>
 #include <iomanip>
@@ -32,6 +34,12 @@ tab-size = 4
 #include <unistd.h>
 #include <pwd.h>
 
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#elif defined(__aarch64__)
+	#include <arm_neon.h>
+#endif
+
 #include "unordered_map"
 #include "widechar_width.hpp"
 #include "btop_shared.hpp"
@@ -165,7 +173,7 @@ namespace Term {
 				linebuffered(false);
 				refresh();
 
-				cout << alt_screen << hide_cursor << mouse_on << flush;
+				cout << alt_screen << hide_cursor << mouse_on << focus_on << flush;
 				Global::resized = false;
 			}
 		}
@@ -175,7 +183,7 @@ namespace Term {
 	void restore() {
 		if (initialized) {
 			tcsetattr(STDIN_FILENO, TCSANOW, &initial_settings);
-			cout << mouse_off << clear << Fx::reset << normal_screen << show_cursor << flush;
+			cout << mouse_off << focus_off << clear << Fx::reset << normal_screen << show_cursor << flush;
 			initialized = false;
 		}
 	}
@@ -183,58 +191,110 @@ namespace Term {
 
 //? --------------------------------------------------- FUNCTIONS -----------------------------------------------------
 
-// ! Disabled due to issue when compiling with musl, reverted back to using regex
-// namespace Fx {
-// 	string uncolor(const string& s) {
-// 		string out = s;
-// 		for (size_t offset = 0, start_pos = 0, end_pos = 0;;) {
-// 			start_pos = (offset == 0) ? out.find('\x1b') : offset;
-// 			if (start_pos == string::npos)
-// 				break;
-// 			offset = start_pos + 1;
-// 			end_pos = out.find('m', offset);
-// 			if (end_pos == string::npos)
-// 				break;
-// 			else if (auto next_pos = out.find('\x1b', offset); not isdigit(out[end_pos - 1]) or end_pos > next_pos) {
-// 			 	offset = next_pos;
-// 				continue;
-// 			}
-
-// 			out.erase(start_pos, (end_pos - start_pos)+1);
-// 			offset = 0;
-// 		}
-// 		out.shrink_to_fit();
-// 		return out;
-// 	}
-// }
+namespace Fx {
+	string uncolor(const string& s) {
+		string out;
+		out.reserve(s.size());
+		const char* pos = s.data();
+		const char* const end = s.data() + s.size();
+
+		//? Single pass, copy everything between SGR sequences (ESC [ <digits and ;> m)
+		while (pos < end) {
+			const char* esc = static_cast<const char*>(memchr(pos, '\x1b', end - pos));
+			if (esc == nullptr) {
+				out.append(pos, end);
+				break;
+			}
+			out.append(pos, esc);
+			const char* p = esc + 1;
+			if (p < end and *p == '[' and p + 1 < end and p[1] >= '0' and p[1] <= '9') {
+				p += 2;
+				while (p < end and ((*p >= '0' and *p <= '9') or *p == ';')) p++;
+				if (p < end and *p == 'm') {
+					pos = p + 1;
+					continue;
+				}
+			}
+			out += '\x1b';
+			pos = esc + 1;
+		}
+		return out;
+	}
+}
 
 namespace Tools {
 
-	size_t wide_ulen(const string& str) {
-		unsigned int chars = 0;
-		try {
-			std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-			auto w_str = conv.from_bytes((str.size() > 10000 ? str.substr(0, 10000).c_str() : str.c_str()));
+	int char_width(uint32_t c) {
+		//? Box drawing, blocks, braille, CJK ideographs and hangul are common in output and process names, skip the table lookups for them
+		if ((c >= 0x20 and c < 0x7f) or (c >= 0x2500 and c <= 0x25fc) or (c >= 0x2800 and c <= 0x28ff)) return 1;
+		if ((c >= 0x4e00 and c <= 0x9fff) or (c >= 0xac00 and c <= 0xd7a3)) return 2;
+		return max(0, utf8::wcwidth(c));
+	}
+
+	UWidth u8_width(string_view str, size_t limit) {
+		UWidth res{0, str.size()};
+		bool fits = true;
+		const auto* s = reinterpret_cast<const unsigned char*>(str.data());
+		const size_t n = str.size();
+		size_t i = 0;
+
+		while (i < n) {
+			//? Printable ASCII is one column per byte, skip over it 16 bytes at a time
+		#if defined(__SSE2__)
+			for (; i + 16 <= n; i += 16) {
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				//? Signed compare, bytes >= 0x80 are negative and caught by the first test
+				if (_mm_movemask_epi8(_mm_or_si128(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)))) != 0) break;
+				if (fits and res.width + 16 > limit) {
+					res.fit = i + (limit - res.width);
+					fits = false;
+				}
+				res.width += 16;
+			}
+		#elif defined(__aarch64__)
+			for (; i + 16 <= n; i += 16) {
+				const uint8x16_t v = vld1q_u8(s + i);
+				if (vmaxvq_u8(vorrq_u8(vcltq_u8(v, vdupq_n_u8(0x20)), vcgeq_u8(v, vdupq_n_u8(0x7f)))) != 0) break;
+				if (fits and res.width + 16 > limit) {
+					res.fit = i + (limit - res.width);
+					fits = false;
+				}
+				res.width += 16;
+			}
+		#endif
+			if (i >= n) break;
+
+			//? Decode one character
+			const unsigned char c = s[i];
+			size_t len = 1;
+			int w = 1;
+			if (c < 0x80) {
+				if (c < 0x20 or c == 0x7f) w = 0;
+			}
+			else if (c >= 0xc0 and c < 0xf8) {
+				const size_t seq = (c >= 0xf0 ? 4 : (c >= 0xe0 ? 3 : 2));
+				uint32_t cp = c & (0x7f >> seq);
+				size_t x = 1;
+				for (; x < seq and i + x < n and (s[i + x] & 0xc0) == 0x80; x++)
+					cp = (cp << 6) | (s[i + x] & 0x3f);
+				if (x == seq) {
+					len = seq;
+					w = char_width(cp);
+				}
+			}
 
-			for (auto c : w_str) {
-				chars += utf8::wcwidth(c);
+			if (fits and res.width + w > limit) {
+				res.fit = i;
+				fits = false;
 			}
+			res.width += w;
+			i += len;
 		}
-		catch (...) {
-			return ulen(str);
-		}
-
-		return chars;
+		return res;
 	}
 
-	size_t wide_ulen(const std::wstring& w_str) {
-		unsigned int chars = 0;
-
-		for (auto c : w_str) {
-			chars += utf8::wcwidth(c);
-		}
-
-		return chars;
+	size_t wide_ulen(const string& str) {
+		return u8_width(str).width;
 	}
 
 	string uresize(string str, const size_t len, bool wide) {
@@ -242,17 +302,7 @@ namespace Tools {
 			return "";
 
 		if (wide) {
-			try {
-				std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-				auto w_str = conv.from_bytes((str.size() > 10000 ? str.substr(0, 10000).c_str() : str.c_str()));
-				while (wide_ulen(w_str) > len)
-					w_str.pop_back();
-				string n_str = conv.to_bytes(w_str);
-				return n_str;
-			}
-			catch (...) {
-				return uresize(str, len, false);
-			}
+			str.resize(u8_width(str, len).fit);
 		}
 		else {
 			for (size_t x = 0, i = 0; i < str.size(); i++) {
@@ -271,12 +321,18 @@ namespace Tools {
 		if (len < 1 or str.empty())
 			return "";
 
-		for (size_t x = 0, last_pos = 0, i = str.size() - 1; i > 0 ; i--) {
-			if (wide and static_cast<unsigned char>(str.at(i)) > 0xef) {
-				x += 2;
-				last_pos = max((size_t)0, i - 1);
+		if (wide) {
+			//? Keep the shortest suffix at least <len> columns wide, what's cut is the longest prefix that fits in the rest
+			const size_t width = u8_width(str).width;
+			if (width > len) {
+				str.erase(0, u8_width(str, width - len).fit);
+				str.shrink_to_fit();
 			}
-			else if ((static_cast<unsigned char>(str.at(i)) & 0xC0) != 0x80) {
+			return str;
+		}
+
+		for (size_t x = 0, last_pos = 0, i = str.size() - 1; i > 0 ; i--) {
+			if ((static_cast<unsigned char>(str.at(i)) & 0xC0) != 0x80) {
 				x++;
 				last_pos = i;
 			}
@@ -326,8 +382,14 @@ namespace Tools {
 
 	string ljust(string str, const size_t x, bool utf, bool wide, bool limit) {
 		if (utf) {
-			if (limit and ulen(str, wide) > x)
-				return uresize(str, x, wide);
+			if (limit and wide) {
+				if (const auto [width, fit] = u8_width(str, x); width > x) {
+					str.resize(fit);
+					return str;
+				}
+			}
+			else if (limit and ulen(str) > x)
+				return uresize(str, x);
 
 			return str + string(max((int)(x - ulen(str)), 0), ' ');
 		}
@@ -342,8 +404,14 @@ namespace Tools {
 
 	string rjust(string str, const size_t x, bool utf, bool wide, bool limit) {
 		if (utf) {
-			if (limit and ulen(str, wide) > x)
-				return uresize(str, x, wide);
+			if (limit and wide) {
+				if (const auto [width, fit] = u8_width(str, x); width > x) {
+					str.resize(fit);
+					return str;
+				}
+			}
+			else if (limit and ulen(str) > x)
+				return uresize(str, x);
 
 			return string(max((int)(x - ulen(str)), 0), ' ') + str;
 		}
@@ -358,8 +426,14 @@ namespace Tools {
 
 	string cjust(string str, const size_t x, bool utf, bool wide, bool limit) {
 		if (utf) {
-			if (limit and ulen(str, wide) > x)
-				return uresize(str, x, wide);
+			if (limit and wide) {
+				if (const auto [width, fit] = u8_width(str, x); width > x) {
+					str.resize(fit);
+					return str;
+				}
+			}
+			else if (limit and ulen(str) > x)
+				return uresize(str, x);
 
 			return string(max((int)ceil((double)(x - ulen(str)) / 2), 0), ' ') + str + string(max((int)floor((double)(x - ulen(str)) / 2), 0), ' ');
 		}
@@ -397,92 +471,114 @@ namespace Tools {
 		return out;
 	}
 
-	string floating_humanizer(uint64_t value, bool shorten, size_t start, bool bit, bool per_second) {
-		string out;
-		const size_t mult = (bit) ? 8 : 1;
-		bool mega = g_CfgMgr.get<CfgB>("base_10_sizes").v();
-
-		// taking advantage of type deduction for array creation (since C++17)
-		// combined with string literals (operator""s)
-		static const array mebiUnits_bit {
-			"bit"s, "Kib"s, "Mib"s,
-			"Gib"s, "Tib"s, "Pib"s,
-			"Eib"s, "Zib"s, "Yib"s,
-			"Bib"s, "GEb"s
-		};
-		static const array mebiUnits_byte {
-			"Byte"s, "KiB"s, "MiB"s,
-			"GiB"s, "TiB"s, "PiB"s,
-			"EiB"s, "ZiB"s, "YiB"s,
-			"BiB"s, "GEB"s
+	namespace {
+		struct UnitTable {
+			array<string_view, 11> bit, byte;
+			bool mega;
 		};
-		static const array megaUnits_bit {
-			"bit"s, "Kb"s, "Mb"s,
-			"Gb"s, "Tb"s, "Pb"s,
-			"Eb"s, "Zb"s, "Yb"s,
-			"Bb"s, "Gb"s
+		constexpr UnitTable mebi_units {
+			{"bit", "Kib", "Mib", "Gib", "Tib", "Pib", "Eib", "Zib", "Yib", "Bib", "GEb"},
+			{"Byte", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", "BiB", "GEB"},
+			false
 		};
-		static const array megaUnits_byte {
-			"Byte"s, "KB"s, "MB"s,
-			"GB"s, "TB"s, "PB"s,
-			"EB"s, "ZB"s, "YB"s,
-			"BB"s, "GB"s
+		constexpr UnitTable mega_units {
+			{"bit", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb", "Zb", "Yb", "Bb", "Gb"},
+			{"Byte", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", "BB", "GB"},
+			true
 		};
-		const auto& units = (bit) ? ( mega ? megaUnits_bit : mebiUnits_bit) : ( mega ? megaUnits_byte : mebiUnits_byte);
+		std::atomic<const UnitTable*> active_units{&mebi_units};
 
-		value *= 100 * mult;
+		//? Values from which another 1000 or 1024 step is taken, in hundredths
+		constexpr array<uint64_t, 5> mega_limits {100'000, 100'000'000, 100'000'000'000, 100'000'000'000'000, 100'000'000'000'000'000};
+		constexpr array<uint64_t, 6> mega_divisors {1, 1'000, 1'000'000, 1'000'000'000, 1'000'000'000'000, 1'000'000'000'000'000};
+		constexpr array<uint64_t, 5> mebi_limits {102400, 102400ull << 10, 102400ull << 20, 102400ull << 30, 102400ull << 40};
 
-		if (mega) {
-			while (value >= 100000) {
-				value /= 1000;
-				if (value < 100) {
-					out = to_string(value);
-					break;
-				}
-				start++;
-			}
+		inline char* put_uint(char* out, uint64_t value) {
+			return std::to_chars(out, out + 20, value).ptr;
+		}
+	}
+
+	void update_units() {
+		active_units.store(g_CfgMgr.get<CfgB>("base_10_sizes").v() ? &mega_units : &mebi_units, std::memory_order_relaxed);
+	}
+
+	size_t humanize(char* out, uint64_t value, bool shorten, size_t start, bool bit, bool per_second) {
+		const UnitTable& table = *active_units.load(std::memory_order_relaxed);
+		const auto& units = (bit) ? table.bit : table.byte;
+		char* p = out;
+
+		//? <value> is kept in hundredths of the current unit, the number of unit steps is counted against
+		//? fixed thresholds instead of dividing in a loop
+		value *= (bit) ? 800 : 100;
+		size_t steps = 0;
+		if (table.mega) {
+			for (const auto limit : mega_limits) steps += (value >= limit);
+			value /= mega_divisors[steps];
 		}
 		else {
-			while (value >= 102400) {
-				value >>= 10;
-				if (value < 100) {
-					out = to_string(value);
-					break;
-				}
-				start++;
-			}
+			for (const auto limit : mebi_limits) steps += (value >= limit);
+			value >>= 10 * steps;
 		}
-		if (out.empty()) {
-			out = to_string(value);
-			if (not mega and out.size() == 4 and start > 0) {
-				out.pop_back();
-				out.insert(2, ".");
+		start += steps;
+
+		//? One decimal for 10.0-99.9 of a binary unit, two for 1.00-9.99, none otherwise
+		const int decimals = (start == 0 or value < 100 or value >= 10000) ? 0
+							: (value < 1000) ? 2 : (table.mega ? 0 : 1);
+
+		if (shorten) {
+			if (decimals == 2) {
+				const uint64_t tenths = (value + 5) / 10;
+				if (tenths >= 100) {
+					//? Matches the old string based rounding, 9.95 rounds to "10."
+					p = put_uint(p, tenths / 10);
+					*p++ = '.';
+				}
+				else {
+					*p++ = '0' + tenths / 10;
+					*p++ = '.';
+					*p++ = '0' + tenths % 10;
+				}
 			}
-			else if (out.size() == 3 and start > 0) {
-				out.insert(1, ".");
+			else if (decimals == 1) {
+				p = put_uint(p, (value / 10 + 5) / 10);
 			}
-			else if (out.size() >= 2) {
-				out.resize(out.size() - 2);
+			else if (value / 100 >= 1000) {
+				uint64_t lead = value / 100;
+				while (lead >= 10) lead /= 10;
+				*p++ = '0' + lead;
+				*p++ = '.';
+				*p++ = '0';
+				start++;
 			}
+			else p = put_uint(p, value / 100);
+			*p++ = units[std::min(start, units.size() - 1)][0];
 		}
-		if (shorten) {
-			auto f_pos = out.find('.');
-			if (f_pos == 1 and out.size() > 3) {
-				out = to_string(round(stod(out) * 10) / 10).substr(0,3);
-			}
-			else if (f_pos != string::npos) {
-				out = to_string((int)round(stod(out)));
+		else {
+			p = put_uint(p, value / 100);
+			if (decimals == 1) {
+				*p++ = '.';
+				*p++ = '0' + (value / 10) % 10;
 			}
-			if (out.size() > 3) {
-				out = to_string((int)(out[0] - '0')) + ".0";
-				start++;
+			else if (decimals == 2) {
+				*p++ = '.';
+				*p++ = '0' + (value / 10) % 10;
+				*p++ = '0' + value % 10;
 			}
-			out.push_back(units[start][0]);
+			*p++ = ' ';
+			const auto unit = units[std::min(start, units.size() - 1)];
+			p = std::copy(unit.begin(), unit.end(), p);
 		}
-		else out += " " + units[start];
 
-		if (per_second) out += (bit) ? "ps" : "/s";
-		return out;
+		if (per_second) {
+			*p++ = (bit) ? 'p' : '/';
+			*p++ = 's';
+		}
+		return p - out;
+	}
+
+	string floating_humanizer(uint64_t value, bool shorten, size_t start, bool bit, bool per_second) {
+		char out[humanize_max];
+		return string(out, humanize(out, value, shorten, start, bit, per_second));
 	}
 
 	std::string operator*(const string& str, int64_t n) {
@@ -511,21 +607,22 @@ namespace Tools {
 	}
 
 	void atomic_wait(const atomic<bool>& atom, bool old) noexcept {
-		while (atom.load(std::memory_order_relaxed) == old ) busy_wait();
-	}
-
-	void atomic_wait_for(const atomic<bool>& atom, bool old, const uint64_t wait_ms) noexcept {
-		const uint64_t start_time = time_ms();
-		while (atom.load(std::memory_order_relaxed) == old and (time_ms() - start_time < wait_ms)) sleep_ms(1);
+		while (atom.load() == old) atom.wait(old);
 	}
 
 	atomic_lock::atomic_lock(atomic<bool>& atom, bool wait) : atom(atom) {
-		if (wait) while (not this->atom.compare_exchange_strong(this->not_true, true));
+		if (wait) {
+			while (not this->atom.compare_exchange_strong(this->not_true, true)) {
+				this->atom.wait(true);
+				this->not_true = false;
+			}
+		}
 		else this->atom.store(true);
 	}
 
 	atomic_lock::~atomic_lock() {
 		this->atom.store(false);
+		this->atom.notify_all();
 	}
 
 	string readfile(const std::filesystem::path& path, const string& fallback) {
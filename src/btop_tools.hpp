@@ -30,6 +30,7 @@ tab-size = 4
 #include <ranges>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -85,12 +86,11 @@ namespace Fx {
 	//* Regex for matching color, style and cursor move escape sequences
 	const std::regex escape_regex("\033\\[\\d+;?\\d?;?\\d*;?\\d*;?\\d*(m|f|s|u|C|D|A|B){1}");
 
-	//* Regex for matching only color and style escape sequences
+	//* Regex for matching only color and style escape sequences, the reference uncolor() is tested against
 	const std::regex color_regex("\033\\[\\d+;?\\d?;?\\d*;?\\d*;?\\d*(m){1}");
 
 	//* Return a string with all colors and text styling removed
-	inline string uncolor(const string& s) { return std::regex_replace(s, color_regex, ""); }
-	// string uncolor(const string& s);
+	string uncolor(const string& s);
 
 }
 
@@ -136,6 +136,8 @@ namespace Term {
 	const string mouse_off = Fx::e + "?1002l" + Fx::e + "?1015l" + Fx::e + "?1006l";
 	const string mouse_direct_on = Fx::e + "?1003h"; //? Enable reporting of mouse position at any movement
 	const string mouse_direct_off = Fx::e + "?1003l";
+	const string focus_on = Fx::e + "?1004h"; //? Enable reporting of terminal focus in and out
+	const string focus_off = Fx::e + "?1004l";
 	const string sync_start = Fx::e + "?2026h"; //? Start of terminal synchronized output
 	const string sync_end = Fx::e + "?2026l"; //? End of terminal synchronized output
 
@@ -192,8 +194,20 @@ namespace Tools {
 		virtual std::string do_grouping() const { return "\03"; }
 	};
 
+	//* Return number of terminal columns used by unicode codepoint <c>, 0 for combining and non printable characters
+	int char_width(uint32_t c);
+
+	//* Terminal columns used by a UTF8 string and byte size of its longest prefix that fits in a column limit
+	struct UWidth {
+		size_t width;
+		size_t fit;
+	};
+
+	//* Return columns needed on terminal for UTF8 string <str> and the byte size of the longest prefix at most <limit> columns wide,
+	//* invalid bytes are counted as one column each
+	UWidth u8_width(std::string_view str, size_t limit = std::numeric_limits<size_t>::max());
+
 	size_t wide_ulen(const string& str);
-	size_t wide_ulen(const std::wstring& w_str);
 
 	//* Return number of UTF8 characters in a string (wide=true for column size needed on terminal)
 	inline size_t ulen(const string& str, bool wide = false) {
@@ -261,19 +275,22 @@ namespace Tools {
 		return ((first == t) or ...);
 	}
 
-	//* Return current time since epoch in seconds
+	//? The time_* functions use the monotonic steady_clock and are only meant for measuring intervals,
+	//? they are not affected by NTP or manual changes to the system clock
+
+	//* Return current monotonic time in seconds
 	inline uint64_t time_s() {
-		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 	}
 
-	//* Return current time since epoch in milliseconds
+	//* Return current monotonic time in milliseconds
 	inline uint64_t time_ms() {
-		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 	}
 
-	//* Return current time since epoch in microseconds
+	//* Return current monotonic time in microseconds
 	inline uint64_t time_micros() {
-		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 	}
 
 	//* Check if a string is a valid bool value
@@ -336,6 +353,15 @@ namespace Tools {
 	//* short=True always returns 0 decimals and shortens unit to 1 character
 	string floating_humanizer(uint64_t value, bool shorten = false, size_t start = 0, bool bit = false, bool per_second = false);
 
+	//* Size of the buffer humanize() needs
+	constexpr size_t humanize_max = 16;
+
+	//* Same as floating_humanizer() but integer only and writing into <out>, returns the number of bytes written
+	size_t humanize(char* out, uint64_t value, bool shorten = false, size_t start = 0, bool bit = false, bool per_second = false);
+
+	//* Select the units used by humanize() from the base_10_sizes option, call after the config has changed
+	void update_units();
+
 	//* Add std::string operator * : Repeat string <str> <n> number of times
 	std::string operator*(const string& str, int64_t n);
 
@@ -389,22 +415,9 @@ namespace Tools {
 	string hostname();
 	string username();
 
-	static inline void busy_wait (void) {
-	#if defined __i386__ || defined __x86_64__
-		__builtin_ia32_pause();
-	#elif defined __ia64__
-		__asm volatile("hint @pause" : : : "memory");
-	#elif defined __sparc__ && (defined __arch64__ || defined __sparc_v9__)
-		__asm volatile("membar #LoadLoad" : : : "memory");
-	#else
-		__asm volatile("" : : : "memory");
-	#endif
-	}
-
+	//* Block until <atom> no longer equals <old>, writers must call notify_all() as atomic_lock does
 	void atomic_wait(const atomic<bool>& atom, bool old = true) noexcept;
 
-	void atomic_wait_for(const atomic<bool>& atom, bool old = true, const uint64_t wait_ms = 0) noexcept;
-
 	//* Sets atomic<bool> to true on construct, sets to false on destruct
 	class atomic_lock {
 		atomic<bool>& atom;
@@ -172,8 +172,9 @@ namespace Shared {
 		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
 		Logger::debug("Init -> Cpu::collect()");
 		Cpu::collect();
-		for (auto &[field, vec] : Cpu::current_cpu.cpu_percent) {
-			if (not vec.empty() and not v_contains(Cpu::available_fields, field)) Cpu::available_fields.push_back(field);
+		for (const auto& field : Cpu::field_names) {
+			if (not Cpu::current_cpu.cpu_percent[field].empty() and not v_contains(Cpu::available_fields, field))
+				Cpu::available_fields.emplace_back(field);
 		}
 		Logger::debug("Init -> Cpu::get_cpuName()");
 		Cpu::cpuName = Cpu::get_cpuName();
@@ -674,7 +675,7 @@ namespace Mem {
 		}
 
 		if (show_swap and mem.stats.at("swap_total") > 0) {
-			for (const auto &name : swap_names) {
+			for (const auto name : swap_fields) {
 				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
 				while (cmp_greater(mem.percent.at(name).size(), width * 2))
 					mem.percent.at(name).pop_front();
@@ -683,7 +684,7 @@ namespace Mem {
 		} else
 			has_swap = false;
 		//? Calculate percentages
-		for (const auto &name : mem_names) {
+		for (const auto name : mem_fields) {
 			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / Shared::totalMem));
 			while (cmp_greater(mem.percent.at(name).size(), width * 2))
 				mem.percent.at(name).pop_front();
@@ -816,7 +817,7 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors = 0;
-	std::unordered_map<string, uint64_t> graph_max = {{"download", {}}, {"upload", {}}};
+	EnumArray<Direction, uint64_t, direction_names> graph_max;
 	std::unordered_map<string, array<int, 2>> max_count = {{"download", {}}, {"upload", {}}};
 	bool rescale = true;
 	uint64_t timestamp = 0;
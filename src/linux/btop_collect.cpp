@@ -16,7 +16,9 @@ indent = tab
 tab-size = 4
 */
 
+#include <charconv>
 #include <cstdlib>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <fstream>
@@ -34,6 +36,9 @@ tab-size = 4
 #include <dlfcn.h>
 #include <unordered_map>
 #include <utility>
+#include <span>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
 
 #if defined(RSMI_STATIC)
 	#include <rocm_smi/rocm_smi.h>
@@ -46,7 +51,8 @@ tab-size = 4
 #include "../btop_shared.hpp"
 #include "../btop_config.hpp"
 #include "../btop_tools.hpp"
-#include "intrin.hpp"
+#include "../btop_procfs.hpp"
+#include "../intrin.hpp"
 
 #if defined(GPU_SUPPORT)
 	#define class class_
@@ -96,7 +102,7 @@ namespace Cpu {
 	vector<string> available_fields = {"Auto", "total"};
 	vector<string> available_sensors = {"Auto"};
 	cpu_info current_cpu;
-	fs::path freqPath = "/sys/devices/system/cpu/cpufreq/policy0/scaling_cur_freq";
+	Procfs::SysfsHandle freqPath{Paths::CPUFREQ};
 	bool got_sensors{};
 	bool cpu_temp_only{};
 
@@ -106,8 +112,26 @@ namespace Cpu {
 	//* Get current cpu clock speed
 	string get_cpuHz();
 
+	//* Push the current frequency of every core to cpu.core_freq and update the summary over the cores
+	void update_core_freqs(cpu_info& cpu);
+
+	//* Group the cores by socket, NUMA node and last level cache, called at start and when cores are hotplugged
+	void get_topology(cpu_info& cpu);
+
+	//* Push the average usage and hottest core temperature of each group from this tick's per core values
+	void update_groups(cpu_info& cpu);
+
+	//* Open performance counters on every core on first use and set cpu.counters from what they counted since the previous update
+	void update_counters(cpu_info& cpu);
+
+	//* Close the performance counters opened by update_counters
+	void close_counters();
+
+	//* Set cpu.core_run_wait from the growth of the per core run queue wait and timeslices in /proc/schedstat
+	void update_run_wait(cpu_info& cpu);
+
 	struct Sensor {
-		fs::path path;
+		Procfs::SysfsHandle input;
 		string label;
 		int64_t temp{};
 		int64_t high{};
@@ -295,22 +319,26 @@ namespace Shared {
       }
 
 		//? Init for namespace Cpu
-      if (!path_readable(Paths::CPUFREQ)) Cpu::freqPath.clear();
+      if (!path_readable(Paths::CPUFREQ)) Cpu::freqPath = {};
 		Cpu::current_cpu.core_percent.insert(Cpu::current_cpu.core_percent.begin(), Shared::coreCount, {});
 		Cpu::current_cpu.temp.insert(Cpu::current_cpu.temp.begin(), Shared::coreCount + 1, {});
 		Cpu::core_old_totals.insert(Cpu::core_old_totals.begin(), Shared::coreCount, 0);
 		Cpu::core_old_idles.insert(Cpu::core_old_idles.begin(), Shared::coreCount, 0);
 		Cpu::collect();
 		if (Runner::coreNum_reset) Runner::coreNum_reset = false;
-		for (auto& [field, vec] : Cpu::current_cpu.cpu_percent) {
-			if (not vec.empty() and not v_contains(Cpu::available_fields, field)) Cpu::available_fields.push_back(field);
+		for (const auto& field : Cpu::field_names) {
+			if (not Cpu::current_cpu.cpu_percent[field].empty() and not v_contains(Cpu::available_fields, field))
+				Cpu::available_fields.emplace_back(field);
 		}
+		if (Cpu::current_cpu.pressure.supported)
+			Cpu::available_fields.emplace_back("pressure");
 		Cpu::cpuName = Cpu::get_cpu_name();
 		Cpu::got_sensors = Cpu::get_sensors();
 		for (const auto& [sensor, ignored] : Cpu::found_sensors) {
 			Cpu::available_sensors.push_back(sensor);
 		}
 		Cpu::core_mapping = Cpu::get_core_mapping();
+		Cpu::get_topology(Cpu::current_cpu);
 
 		//? Init for namespace Gpu
 	#ifdef GPU_SUPPORT
@@ -342,31 +370,68 @@ namespace Shared {
 	}
 }
 
+namespace Pressure {
+	//? Pressure files are kept open and re-read from the start, a resource is only probed once
+	EnumArray<Resource, Procfs::SysfsHandle, resource_names> files;
+	EnumArray<Resource, bool, resource_names> probed;
+
+	//* Read /proc/pressure/<resource> into <info> keeping <history> values, it stays unsupported if the kernel was built or booted without PSI
+	void update(Resource resource, pressure_info& info, size_t history) {
+		auto& file = files[resource];
+		if (not std::exchange(probed[resource], true))
+			file = Procfs::SysfsHandle{(Shared::procPath / "pressure" / string(resource_names[(size_t)resource])).string()};
+
+		std::string_view text;
+		if (file.empty() or not file.read(text)) {
+			if (info.supported) Logger::warning("Failed to read " + file.path() + ", pressure stall information disabled.");
+			file = {};
+			info.supported = false;
+			return;
+		}
+
+		//? Lines are "some avg10=0.12 avg60=0.05 avg300=0.01 total=123456"
+		const bool high_res = g_CfgMgr.get<CfgB>("pressure_high_res").v();
+		const uint64_t now = time_micros();
+		const uint64_t elapsed = (info.supported ? now - info.sampled : 0);
+		Procfs::Lines lines(text);
+		for (std::string_view line; lines.next(line);) {
+			Procfs::Fields fields(line);
+			std::string_view kind;
+			if (not fields.next(kind) or (kind != "some" and kind != "full")) continue;
+			auto& stall = (kind == "some" ? info.some : info.full);
+			for (std::string_view field; fields.next(field);) {
+				const size_t split = field.find('=');
+				if (split == std::string_view::npos) continue;
+				const auto key = field.substr(0, split), value = field.substr(split + 1);
+				if (key == "avg10") stall.avg10 = Procfs::to_fixed<2>(value);
+				else if (key == "avg60") stall.avg60 = Procfs::to_fixed<2>(value);
+				else if (key == "total") {
+					const auto total = Procfs::to_int<uint64_t>(value);
+					stall.delta = (info.supported and total >= stall.total ? total - stall.total : 0);
+					stall.total = total;
+				}
+			}
+			if (high_res and elapsed > 0)
+				stall.percent.push_back(round((double)stall.delta * 100 / elapsed));
+			else
+				stall.percent.push_back(round((double)stall.avg10 / 100));
+			stall.percent.set_capacity(history);
+		}
+		info.sampled = now;
+		info.supported = true;
+	}
+}
+
 namespace Cpu {
 	string cpuName;
 	string cpuHz;
 	bool has_battery = true;
 	tuple<int, float, long, string> current_bat;
 
-	const array time_names {
-		"user"s, "nice"s, "system"s, "idle"s, "iowait"s,
-		"irq"s, "softirq"s, "steal"s, "guest"s, "guest_nice"s
-	};
-
-	std::unordered_map<string, long long> cpu_old = {
-			{"totals", 0},
-			{"idles", 0},
-			{"user", 0},
-			{"nice", 0},
-			{"system", 0},
-			{"idle", 0},
-			{"iowait", 0},
-			{"irq", 0},
-			{"softirq", 0},
-			{"steal", 0},
-			{"guest", 0},
-			{"guest_nice", 0}
-	};
+	//* Previous /proc/stat values, the time fields are indexed by Field
+	long long cpu_old_totals = 0, cpu_old_idles = 0;
+	array<long long, field_names.size()> cpu_old{};
+	uint64_t old_ctxt = 0, old_forks = 0, stat_sampled = 0;
 
 	bool get_sensors() {
 		bool got_cpu = false, got_coretemp = false;
@@ -434,7 +499,7 @@ namespace Cpu {
 						const int64_t high = stol(readfile(fs::path(basepath + "max"), "80000")) / 1000;
 						const int64_t crit = stol(readfile(fs::path(basepath + "crit"), "95000")) / 1000;
 
-						found_sensors[sensor_name] = {fs::path(basepath + "input"), label, temp, high, crit};
+						found_sensors[sensor_name] = {Procfs::SysfsHandle(basepath + "input"), label, temp, high, crit};
 
 						if (not got_cpu and (label.starts_with("Package id") or label.starts_with("Tdie"))) {
 							got_cpu = true;
@@ -467,7 +532,7 @@ namespace Cpu {
 					if (high < 1) high = 80;
 					if (crit < 1) crit = 95;
 
-					found_sensors[sensor_name] = {basepath / "temp", label, temp, high, crit};
+					found_sensors[sensor_name] = {Procfs::SysfsHandle(basepath / "temp"), label, temp, high, crit};
 				}
 			}
 
@@ -506,24 +571,305 @@ namespace Cpu {
 
 		const auto& cpu_sensor = (not cpu_sensor_conf.empty() and found_sensors.contains(cpu_sensor_conf) ? cpu_sensor_conf : Cpu::cpu_sensor);
 
-		found_sensors.at(cpu_sensor).temp = stol(readfile(found_sensors.at(cpu_sensor).path, "0")) / 1000;
+		found_sensors.at(cpu_sensor).temp = found_sensors.at(cpu_sensor).input.read_int<long long>() / 1000;
 		current_cpu.temp.at(0).push_back(found_sensors.at(cpu_sensor).temp);
 		current_cpu.temp_max = found_sensors.at(cpu_sensor).crit;
-		if (current_cpu.temp.at(0).size() > 20) current_cpu.temp.at(0).pop_front();
+		current_cpu.temp.at(0).set_capacity(20);
 
 		if (g_CfgMgr.get<CfgB>("show_coretemp").v() && !cpu_temp_only) {
 			vector<string> done;
 			for (const auto& sensor : core_sensors) {
 				if (v_contains(done, sensor)) continue;
-				found_sensors.at(sensor).temp = stol(readfile(found_sensors.at(sensor).path, "0")) / 1000;
+				found_sensors.at(sensor).temp = found_sensors.at(sensor).input.read_int<long long>() / 1000;
 				done.push_back(sensor);
 			}
 			for (const auto& [core, temp] : core_mapping) {
 				if (cmp_less(core + 1, current_cpu.temp.size()) and cmp_less(temp, core_sensors.size())) {
 					current_cpu.temp.at(core + 1).push_back(found_sensors.at(core_sensors.at(temp)).temp);
-					if (current_cpu.temp.at(core + 1).size() > 20) current_cpu.temp.at(core + 1).pop_front();
+					current_cpu.temp.at(core + 1).set_capacity(20);
+				}
+			}
+		}
+	}
+
+	//* Incremented on every collect, /proc/cpuinfo is slow to generate on many core machines so it's read at most once per tick
+	uint64_t collect_tick{};
+
+	std::string_view cpuinfo_view() {
+		static Procfs::ReadBuffer cpuinfo(1 << 16);
+		static uint64_t read_tick = numeric_limits<uint64_t>::max();
+		if (read_tick != collect_tick) {
+			cpuinfo.read(Shared::procPath / "cpuinfo");
+			read_tick = collect_tick;
+		}
+		return cpuinfo.view();
+	}
+
+	//* scaling_cur_freq of each core, opened as cores are first seen. Cores without one are left with an empty handle
+	//* until get_topology clears the list on hotplug, so they aren't opened again every tick
+	vector<Procfs::SysfsHandle> core_freq_files;
+
+	void update_core_freqs(cpu_info& cpu) {
+		static const bool has_cpufreq = fs::exists("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq");
+		const size_t cores = cpu.core_percent.size();
+		if (cpu.core_freq.size() < cores) cpu.core_freq.resize(cores);
+
+		if (has_cpufreq) {
+			while (core_freq_files.size() < cores)
+				core_freq_files.emplace_back("/sys/devices/system/cpu/cpu" + to_string(core_freq_files.size()) + "/cpufreq/scaling_cur_freq");
+			for (size_t core = 0; core < cores; core++) {
+				auto& file = core_freq_files[core];
+				std::string_view value;
+				if (file.read(value)) {
+					cpu.core_freq[core].push_back(Procfs::to_int<long long>(value) / 1000);
+					continue;
+				}
+				if (not file.is_open()) file = {};
+				cpu.core_freq[core].push_back(0);
+			}
+		}
+		else {
+			//? Each core's block in /proc/cpuinfo starts with "processor" and has a "cpu MHz" line further down
+			static vector<long long> mhz;
+			mhz.assign(cores, 0);
+			size_t core = cores;
+			Procfs::scan_keys(cpuinfo_view(), ':', [&](std::string_view key, std::string_view value) {
+				if (key == "processor") core = Procfs::to_int<size_t>(value, cores);
+				else if (key == "cpu MHz" and core < cores) mhz[core] = Procfs::to_fixed<3>(value) / 1000;
+				return true;
+			});
+			for (core = 0; core < cores; core++)
+				cpu.core_freq[core].push_back(mhz[core]);
+		}
+
+		//? Offline cores read as 0 and are left out of the summary
+		long long total = 0, counted = 0;
+		cpu.freq_min = cpu.freq_max = 0;
+		for (auto& freqs : cpu.core_freq) {
+			freqs.set_capacity(40);
+			const long long mhz = freqs.back();
+			if (mhz <= 0) continue;
+			if (counted++ == 0 or mhz < cpu.freq_min) cpu.freq_min = mhz;
+			cpu.freq_max = max(cpu.freq_max, mhz);
+			total += mhz;
+		}
+		cpu.freq_avg = (counted > 0 ? total / counted : 0);
+		cpu.freq_top = max(cpu.freq_top, cpu.freq_max);
+	}
+
+	void get_topology(cpu_info& cpu) {
+		const int cores = cpu.core_percent.size();
+		core_freq_files.clear();
+		EnumArray<Level, vector<int>, level_names> keys;
+		for (auto& level_keys : keys) level_keys.assign(cores, 0);
+
+		Procfs::ReadBuffer attr(256);
+		for (int core = 0; core < cores; core++) {
+			const string core_dir = "/sys/devices/system/cpu/cpu" + to_string(core);
+			if (attr.read(core_dir + "/topology/physical_package_id"))
+				keys[Level::socket][core] = max(0, Procfs::to_int<int>(attr.view()));
+
+			//? The last level cache is the cache index with the highest level, cores sharing it have the same sorted
+			//? shared_cpu_list so its first cpu identifies the cache
+			int llc_index = -1;
+			for (int index = 0, llc_level = 0; attr.read(core_dir + "/cache/index" + to_string(index) + "/level"); index++) {
+				if (const int level = Procfs::to_int<int>(attr.view()); level >= llc_level) {
+					llc_level = level;
+					llc_index = index;
+				}
+			}
+			if (llc_index >= 0 and attr.read(core_dir + "/cache/index" + to_string(llc_index) + "/shared_cpu_list"))
+				keys[Level::llc][core] = max(0, Procfs::to_int<int>(attr.view()));
+		}
+
+		//? NUMA nodes list their cores in node<N>/cpulist
+		std::error_code ec;
+		for (const auto& node : fs::directory_iterator("/sys/devices/system/node", ec)) {
+			const string name = node.path().filename();
+			if (name.size() < 5 or not name.starts_with("node") or not isint(name.substr(4)) or not attr.read(node.path() / "cpulist")) continue;
+			const int node_id = stoi(name.substr(4));
+			Procfs::for_each_cpu(attr.view(), [&](int core) {
+				if (core < cores) keys[Level::node][core] = node_id;
+			});
+		}
+
+		//? Sockets and nodes keep their kernel ids, caches are numbered in order of their first core
+		for (const auto level : {Level::socket, Level::node, Level::llc}) {
+			std::map<int, vector<int>> members;
+			for (int core = 0; core < cores; core++) members[keys[level][core]].push_back(core);
+
+			auto& groups = cpu.groups[level];
+			groups.clear();
+			group_sizes[level].clear();
+			for (auto& [key, group_cores] : members) {
+				group_sizes[level].push_back(group_cores.size());
+				groups.push_back({(level == Level::llc ? (int)groups.size() : key), std::move(group_cores), {}, {}});
+			}
+		}
+
+		//? Hotplug can leave fewer groups than the one drilled into, all groups are shown again
+		const string view = g_CfgMgr.get<CfgS>("cpu_core_view").v();
+		if (drill_group >= 0 and (not decltype(group_sizes)::contains(view) or drill_group >= (int)group_sizes.at(view).size()))
+			drill_group = -1;
+	}
+
+	void update_groups(cpu_info& cpu) {
+		for (auto& groups : cpu.groups) {
+			for (auto& group : groups) {
+				long long total = 0, hottest = 0;
+				bool has_temp = false;
+				for (const int core : group.cores) {
+					if (cmp_less(core, cpu.core_percent.size()) and not cpu.core_percent[core].empty())
+						total += cpu.core_percent[core].back();
+					if (cmp_less(core + 1, cpu.temp.size()) and not cpu.temp[core + 1].empty()) {
+						hottest = (has_temp ? max(hottest, cpu.temp[core + 1].back()) : cpu.temp[core + 1].back());
+						has_temp = true;
+					}
+				}
+				group.percent.push_back(group.cores.empty() ? 0 : total / (long long)group.cores.size());
+				group.percent.set_capacity(40);
+				if (has_temp) {
+					group.temp.push_back(hottest);
+					group.temp.set_capacity(20);
+				}
+			}
+		}
+	}
+
+	//? Performance counters from perf_event_open, one group per core with the first event as leader so a single read()
+	//? returns every counter of the core sampled at the same time
+	namespace Pmu {
+		struct event { uint32_t type; uint64_t config; };
+		enum Counter { cycles, instructions, cache_references, cache_misses, branches, branch_misses };
+		constexpr array hardware_events {
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+			event{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+		};
+		//? Used when the PMU is missing, like in most virtual machines. Timer based software events like cpu-clock
+		//? can't lead a group of the other software events, those then never count
+		constexpr array software_events {
+			event{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+		};
+
+		//? Layout of a read() from a group leader with the read_format below
+		struct sample {
+			uint64_t count, time_enabled, time_running;
+			array<uint64_t, hardware_events.size()> values;
+		};
+
+		struct group {
+			vector<int> fds;
+			array<uint64_t, hardware_events.size()> last{};
+			uint64_t last_enabled{};
+		};
+
+		vector<group> groups;
+		bool hardware{}, failed{};
+
+		void close_group(group& core) {
+			for (const int fd : core.fds) ::close(fd);
+			core.fds.clear();
+		}
+
+		//* Open <events> as one group counting everything that runs on <cpu>, false with errno set if any of them failed
+		bool open_group(std::span<const event> events, int cpu, group& core) {
+			for (const auto& ev : events) {
+				perf_event_attr attr{};
+				attr.size = sizeof(attr);
+				attr.type = ev.type;
+				attr.config = ev.config;
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+				const int fd = syscall(SYS_perf_event_open, &attr, -1, cpu, (core.fds.empty() ? -1 : core.fds.front()), PERF_FLAG_FD_CLOEXEC);
+				if (fd < 0) {
+					const int error = errno;
+					close_group(core);
+					errno = error;
+					return false;
+				}
+				core.fds.push_back(fd);
+			}
+			return true;
+		}
+
+		//* Open a group on every core, trying all hardware counters, then only cycles and instructions for PMUs that can't
+		//* schedule the whole group, and then software counters
+		bool open(int cores) {
+			const array<std::span<const event>, 3> tiers {
+				std::span<const event>(hardware_events), std::span<const event>(hardware_events).first(2), std::span<const event>(software_events)
+			};
+			for (const auto& events : tiers) {
+				hardware = (events.data() == hardware_events.data());
+				groups.assign(cores, {});
+				int error = 0;
+				bool opened = false;
+				for (int cpu = 0; cpu < cores and error == 0; cpu++) {
+					if (open_group(events, cpu, groups[cpu])) opened = true;
+					//? ENODEV is an offline core, it's left without counters
+					else if (errno != ENODEV) error = errno;
+				}
+				if (error == 0 and opened) {
+					Logger::debug("Cpu::update_counters() : Opened " + to_string(events.size()) + (hardware ? " hardware" : " software") + " counters per core.");
+					return true;
+				}
+				for (auto& core : groups) close_group(core);
+				groups.clear();
+				if (error == EACCES or error == EPERM) {
+					Logger::warning("No permission to open performance counters, needs CAP_PERFMON or kernel.perf_event_paranoid set to 0 or lower.");
+					return false;
 				}
 			}
+			Logger::info("Performance counters are not supported on this system.");
+			return false;
+		}
+	}
+
+	void close_counters() {
+		for (auto& core : Pmu::groups) Pmu::close_group(core);
+		Pmu::groups.clear();
+		has_counters = false;
+	}
+
+	void update_counters(cpu_info& cpu) {
+		using namespace Pmu;
+		if (not failed and std::cmp_not_equal(groups.size(), Shared::coreCount)) {
+			close_counters();
+			failed = not open(Shared::coreCount);
+			has_counters = not failed;
+		}
+		cpu.counters.assign(groups.size(), {});
+		cpu.counters_hardware = hardware;
+
+		sample read_sample;
+		for (size_t core = 0; core < groups.size(); core++) {
+			auto& group = groups[core];
+			if (group.fds.empty()) continue;
+			const ssize_t got = ::read(group.fds.front(), &read_sample, sizeof(read_sample));
+			if (got < (ssize_t)(3 * sizeof(uint64_t)) or read_sample.count != group.fds.size()) continue;
+
+			array<uint64_t, hardware_events.size()> delta{};
+			for (size_t i = 0; i < read_sample.count; i++) {
+				delta[i] = read_sample.values[i] - group.last[i];
+				group.last[i] = read_sample.values[i];
+			}
+			const uint64_t enabled = read_sample.time_enabled - group.last_enabled;
+			group.last_enabled = read_sample.time_enabled;
+			if (enabled == 0 or read_sample.time_running == 0) continue;
+
+			//? Counters of a group are scheduled together so the ratios hold even when the PMU is multiplexed
+			auto& out = cpu.counters[core];
+			if (hardware) {
+				if (delta[cycles] > 0) out.ipc = delta[instructions] * 100 / delta[cycles];
+				if (read_sample.count > cache_misses and delta[cache_references] > 0)
+					out.cache_miss = min<uint64_t>(100, delta[cache_misses] * 100 / delta[cache_references]);
+				if (read_sample.count > branch_misses and delta[branches] > 0)
+					out.branch_miss = min<uint64_t>(100, delta[branch_misses] * 100 / delta[branches]);
+			}
+			else
+				out.switches = delta[0] * 1'000'000'000 / enabled;
 		}
 	}
 
@@ -538,26 +884,17 @@ namespace Cpu {
 			double hz{};
 			//? Try to get freq from /sys/devices/system/cpu/cpufreq/policy first (faster)
 			if (not freqPath.empty()) {
-				hz = stod(readfile(freqPath, "0.0")) / 1000;
+				if (std::string_view value; freqPath.read(value)) hz = Procfs::to_fixed<3>(value) / 1'000'000.0;
 				if (hz <= 0.0 and ++failed >= 2)
-					freqPath.clear();
+					freqPath = {};
 			}
 			//? If freq from /sys failed or is missing try to use /proc/cpuinfo
 			if (hz <= 0.0) {
-				ifstream cpufreq(Shared::procPath / "cpuinfo");
-				if (cpufreq.good()) {
-					while (cpufreq.ignore(SSmax, '\n')) {
-						if (cpufreq.peek() == 'c') {
-							cpufreq.ignore(SSmax, ' ');
-							if (cpufreq.peek() == 'M') {
-								cpufreq.ignore(SSmax, ':');
-								cpufreq.ignore(1);
-								cpufreq >> hz;
-								break;
-							}
-						}
-					}
-				}
+				Procfs::scan_keys(cpuinfo_view(), ':', [&](std::string_view key, std::string_view value) {
+					if (key != "cpu MHz") return true;
+					hz = Procfs::to_fixed<3>(value) / 1000.0;
+					return false;
+				});
 			}
 
 			if (hz <= 1 or hz >= 1000000)
@@ -589,19 +926,15 @@ namespace Cpu {
 		if (cpu_temp_only) return core_map;
 
 		//? Try to get core mapping from /proc/cpuinfo
-		ifstream cpuinfo(Shared::procPath / "cpuinfo");
-		if (cpuinfo.good()) {
+		Procfs::ReadBuffer cpuinfo;
+		if (cpuinfo.read(Shared::procPath / "cpuinfo")) {
 			int cpu{};
-			int core{};
 			int n{};
-			for (string instr; cpuinfo >> instr;) {
-				if (instr == "processor") {
-					cpuinfo.ignore(SSmax, ':');
-					cpuinfo >> cpu;
-				}
-				else if (instr.starts_with("core")) {
-					cpuinfo.ignore(SSmax, ':');
-					cpuinfo >> core;
+			Procfs::scan_keys(cpuinfo.view(), ':', [&](std::string_view key, std::string_view value) {
+				if (key == "processor")
+					cpu = Procfs::to_int<int>(value);
+				else if (key.starts_with("core")) {
+					const int core = Procfs::to_int<int>(value);
 					if (std::cmp_greater_equal(core, core_sensors.size())) {
 						if (std::cmp_greater_equal(n, core_sensors.size())) n = 0;
 						core_map[cpu] = n++;
@@ -609,8 +942,8 @@ namespace Cpu {
 					else
 						core_map[cpu] = core;
 				}
-				cpuinfo.ignore(SSmax, '\n');
-			}
+				return true;
+			});
 		}
 
 		//? If core mapping from cpuinfo was incomplete try to guess remainder, if missing completely, map 0-0 1-1 2-2 etc.
@@ -649,8 +982,10 @@ namespace Cpu {
 		return core_map;
 	}
 
+	//* The attributes read on every update are kept open, an attribute the battery doesn't have is left empty
 	struct battery {
-		fs::path base_dir, energy_now, charge_now, energy_full, charge_full, power_now, current_now, voltage_now, status, online;
+		fs::path base_dir;
+		Procfs::SysfsHandle energy_now, charge_now, energy_full, charge_full, power_now, current_now, voltage_now, capacity, status, time_to_empty, online;
 		string device_type;
 		bool use_energy_or_charge = true;
 		bool use_power = true;
@@ -675,7 +1010,7 @@ namespace Cpu {
 							if (not d.is_directory()
 								or not fs::exists(d.path() / "type")
 								or not fs::exists(d.path() / "present")
-								or stoi(readfile(d.path() / "present")) != 1)
+								or Procfs::to_int<int>(readfile(d.path() / "present")) != 1)
 								continue;
 							string dev_type = readfile(d.path() / "type");
 							if (is_in(dev_type, "Battery", "UPS")) {
@@ -688,12 +1023,12 @@ namespace Cpu {
 							continue;
 						}
 
-						if (fs::exists(bat_dir / "energy_now")) new_bat.energy_now = bat_dir / "energy_now";
-						else if (fs::exists(bat_dir / "charge_now")) new_bat.charge_now = bat_dir / "charge_now";
+						if (fs::exists(bat_dir / "energy_now")) new_bat.energy_now = Procfs::SysfsHandle(bat_dir / "energy_now");
+						else if (fs::exists(bat_dir / "charge_now")) new_bat.charge_now = Procfs::SysfsHandle(bat_dir / "charge_now");
 						else new_bat.use_energy_or_charge = false;
 
-						if (fs::exists(bat_dir / "energy_full")) new_bat.energy_full = bat_dir / "energy_full";
-						else if (fs::exists(bat_dir / "charge_full")) new_bat.charge_full = bat_dir / "charge_full";
+						if (fs::exists(bat_dir / "energy_full")) new_bat.energy_full = Procfs::SysfsHandle(bat_dir / "energy_full");
+						else if (fs::exists(bat_dir / "charge_full")) new_bat.charge_full = Procfs::SysfsHandle(bat_dir / "charge_full");
 						else new_bat.use_energy_or_charge = false;
 
 						if (not new_bat.use_energy_or_charge and not fs::exists(bat_dir / "capacity")) {
@@ -701,20 +1036,24 @@ namespace Cpu {
 						}
 
 						if (fs::exists(bat_dir / "power_now")) {
-							new_bat.power_now = bat_dir / "power_now";
+							new_bat.power_now = Procfs::SysfsHandle(bat_dir / "power_now");
 						}
 						else if ((fs::exists(bat_dir / "current_now")) and (fs::exists(bat_dir / "voltage_now"))) {
-							 new_bat.current_now = bat_dir / "current_now";
-							 new_bat.voltage_now = bat_dir / "voltage_now";
+							 new_bat.current_now = Procfs::SysfsHandle(bat_dir / "current_now");
+							 new_bat.voltage_now = Procfs::SysfsHandle(bat_dir / "voltage_now");
 						}
 						else {
 							new_bat.use_power = false;
 						}
 
-						if (fs::exists(bat_dir / "AC0/online")) new_bat.online = bat_dir / "AC0/online";
-						else if (fs::exists(bat_dir / "AC/online")) new_bat.online = bat_dir / "AC/online";
+						if (fs::exists(bat_dir / "capacity")) new_bat.capacity = Procfs::SysfsHandle(bat_dir / "capacity");
+						if (fs::exists(bat_dir / "status")) new_bat.status = Procfs::SysfsHandle(bat_dir / "status");
+						if (fs::exists(bat_dir / "time_to_empty")) new_bat.time_to_empty = Procfs::SysfsHandle(bat_dir / "time_to_empty");
 
-						batteries[bat_dir.filename()] = new_bat;
+						if (fs::exists(bat_dir / "AC0/online")) new_bat.online = Procfs::SysfsHandle(bat_dir / "AC0/online");
+						else if (fs::exists(bat_dir / "AC/online")) new_bat.online = Procfs::SysfsHandle(bat_dir / "AC/online");
+
+						batteries[bat_dir.filename()] = std::move(new_bat);
 						Config::available_batteries.push_back(bat_dir.filename());
 					}
 				}
@@ -748,25 +1087,13 @@ namespace Cpu {
 
 		//? Try to get battery percentage
 		if (percent < 0) {
-			try {
-				percent = stoll(readfile(b.base_dir / "capacity", "-1"));
-			}
-			catch (const std::invalid_argument&) { }
-			catch (const std::out_of_range&) { }
+			percent = b.capacity.read_int<long long>(-1);
 		}
 		if (b.use_energy_or_charge and percent < 0) {
-			try {
-				percent = round(100.0 * stoll(readfile(b.energy_now, "-1")) / stoll(readfile(b.energy_full, "1")));
-			}
-			catch (const std::invalid_argument&) { }
-			catch (const std::out_of_range&) { }
+			percent = round(100.0 * b.energy_now.read_int<long long>(-1) / b.energy_full.read_int<long long>(1));
 		}
 		if (b.use_energy_or_charge and percent < 0) {
-			try {
-				percent = round(100.0 * stoll(readfile(b.charge_now, "-1")) / stoll(readfile(b.charge_full, "1")));
-			}
-			catch (const std::invalid_argument&) { }
-			catch (const std::out_of_range&) { }
+			percent = round(100.0 * b.charge_now.read_int<long long>(-1) / b.charge_full.read_int<long long>(1));
 		}
 		if (percent < 0) {
 			has_battery = false;
@@ -774,9 +1101,9 @@ namespace Cpu {
 		}
 
 		//? Get charging/discharging status
-		string status = str_to_lower(readfile(b.base_dir / "status", "unknown"));
+		string status = str_to_lower(b.status.read_string("unknown"));
 		if (status == "unknown" and not b.online.empty()) {
-			const auto online = readfile(b.online, "0");
+			const auto online = b.online.read_string("0");
 			if (online == "1" and percent < 100) status = "charging";
 			else if (online == "1") status = "full";
 			else status = "discharging";
@@ -786,45 +1113,25 @@ namespace Cpu {
 		if (not is_in(status, "charging", "full")) {
 			if (b.use_energy_or_charge ) {
 				if (not b.power_now.empty()) {
-					try {
-						seconds = round((double)stoll(readfile(b.energy_now, "0")) / stoll(readfile(b.power_now, "1")) * 3600);
-					}
-					catch (const std::invalid_argument&) { }
-					catch (const std::out_of_range&) { }
+					seconds = round((double)b.energy_now.read_int<long long>() / b.power_now.read_int<long long>(1) * 3600);
 				}
 				else if (not b.current_now.empty()) {
-					try {
-						seconds = round((double)stoll(readfile(b.charge_now, "0")) / (double)stoll(readfile(b.current_now, "1")) * 3600);
-					}
-					catch (const std::invalid_argument&) { }
-					catch (const std::out_of_range&) { }
+					seconds = round((double)b.charge_now.read_int<long long>() / (double)b.current_now.read_int<long long>(1) * 3600);
 				}
 			}
 
-			if (seconds < 0 and fs::exists(b.base_dir / "time_to_empty")) {
-				try {
-					seconds = stoll(readfile(b.base_dir / "time_to_empty", "0")) * 60;
-				}
-				catch (const std::invalid_argument&) { }
-				catch (const std::out_of_range&) { }
+			if (seconds < 0 and not b.time_to_empty.empty()) {
+				seconds = b.time_to_empty.read_int<long long>() * 60;
 			}
 		}
 
 		//? Get power draw
 		if (b.use_power) {
 			if (not b.power_now.empty()) {
-				try {
-					watts = (float)stoll(readfile(b.power_now, "-1")) / 1000000.0;
-				}
-				catch (const std::invalid_argument&) { }
-				catch (const std::out_of_range&) { }
+				watts = (float)b.power_now.read_int<long long>(-1) / 1000000.0;
 			}
 			else if (not b.voltage_now.empty() and not b.current_now.empty()) {
-				try {
-					watts = (float)stoll(readfile(b.current_now, "-1")) / 1000000.0 * stoll(readfile(b.voltage_now, "1")) / 1000000.0;
-				}
-				catch (const std::invalid_argument&) { }
-				catch (const std::out_of_range&) { }
+				watts = (float)b.current_now.read_int<long long>(-1) / 1000000.0 * b.voltage_now.read_int<long long>(1) / 1000000.0;
 			}
 
 		}
@@ -832,121 +1139,187 @@ namespace Cpu {
 		return {percent, watts, seconds, status};
 	}
 
-	auto collect(bool no_update) -> cpu_info& {
-		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty())) return current_cpu;
-		auto& cpu = current_cpu;
-
-		if (Config::getB("show_cpu_freq"))
-			cpuHz = get_cpuHz();
+	//* /proc/stat is read whole into this buffer, it only grows so steady state updates don't allocate
+	Procfs::ReadBuffer stat_read(1 << 16);
 
-		if (getloadavg(cpu.load_avg.data(), cpu.load_avg.size()) < 0) {
-			Logger::error("failed to get load averages");
+	//* Make room for core <core> in the per core containers if a new core was hotplugged
+	void fit_core(cpu_info& cpu, size_t core) {
+		while (cpu.core_percent.size() <= core) {
+			core_old_totals.push_back(0);
+			core_old_idles.push_back(0);
+			cpu.core_percent.emplace_back();
 		}
+	}
 
-		ifstream cread;
+	//* Add a zero value for a core that is missing from /proc/stat
+	void zero_core(cpu_info& cpu, size_t core) {
+		fit_core(cpu, core);
+		cpu.core_percent[core].push_back(0);
+		cpu.core_percent[core].set_capacity(40);
+	}
 
-		try {
-			//? Get cpu total times for all cores from /proc/stat
-			string cpu_name;
-			cread.open(Shared::procPath / "stat");
-			int i = 0;
-			int target = Shared::coreCount;
-			for (; i <= target or (cread.good() and cread.peek() == 'c'); i++) {
-				//? Make sure to add zero value for missing core values if at end of file
-				if ((not cread.good() or cread.peek() != 'c') and i <= target) {
-					if (i == 0) throw std::runtime_error("Failed to parse /proc/stat");
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						cpu.core_percent.at(i-1).push_back(0);
-					}
+	void parse_stat(std::string_view data, cpu_info& cpu) {
+		//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
+		array<long long, 10> times;
+		size_t next_core = 0;
+		bool got_total = false;
+
+		uint64_t ctxt = 0, forks = 0;
+		Procfs::Lines lines(data);
+		for (std::string_view line; lines.next(line);) {
+			//? The scheduler counters come after the cpu lines, "processes" is the number of forks since boot
+			if (not line.starts_with("cpu")) {
+				const size_t split = line.find(' ');
+				if (split == std::string_view::npos) continue;
+				const auto key = line.substr(0, split), value = line.substr(split + 1);
+				if (key == "ctxt") ctxt = Procfs::to_int<uint64_t>(value);
+				else if (key == "processes") forks = Procfs::to_int<uint64_t>(value);
+				else if (key == "procs_running") cpu.procs_running = Procfs::to_int<long long>(value);
+				else if (key == "procs_blocked") cpu.procs_blocked = Procfs::to_int<long long>(value);
+				continue;
+			}
+			Procfs::Fields fields(line.substr(3));
+
+			//? The first line is the total of all cores, the rest are named cpu<N>
+			int core = -1;
+			if (got_total) {
+				if (not fields.next_int(core) or core < 0) throw std::runtime_error("Malformed /proc/stat");
+				//? Add zero value for core if core number is missing from /proc/stat
+				while (cmp_less(next_core, core)) zero_core(cpu, next_core++);
+				core = next_core++;
+			}
+
+			size_t count = 0;
+			long long totals = 0;
+			for (uint64_t val; fields.next_int(val);) {
+				if (count < times.size()) times[count] = val;
+				//? Fields 8-9 (guest time) are already counted in user and nice, also skip any future unknown fields
+				if (count++ < 8) totals += val;
+			}
+			if (count < 4) throw std::runtime_error("Malformed /proc/stat");
+			totals = max(0ll, totals);
+
+			//? Add iowait field if present
+			const long long idles = max(0ll, times[3] + (count > 4 ? times[4] : 0));
+
+			//? Calculate values for totals from first line of stat
+			if (not got_total) {
+				got_total = true;
+				const long long calc_totals = max(1ll, totals - cpu_old_totals);
+				const long long calc_idles = max(1ll, idles - cpu_old_idles);
+				cpu_old_totals = totals;
+				cpu_old_idles = idles;
+
+				//? Total usage of cpu
+				cpu.cpu_percent[Field::total].push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+
+				//? Reduce size if there are more values than needed for graph
+				cpu.cpu_percent[Field::total].set_capacity(width * 2);
+
+				//? Populate cpu.cpu_percent with all fields from stat
+				for (size_t ii = 0; ii < min(count, times.size()); ii++) {
+					auto& field_percent = cpu.cpu_percent[Field(ii + 1)];
+					field_percent.push_back(clamp((long long)round((double)(times[ii] - cpu_old[ii + 1]) * 100 / calc_totals), 0ll, 100ll));
+					cpu_old[ii + 1] = times[ii];
+
+					//? Reduce size if there are more values than needed for graph
+					field_percent.set_capacity(width * 2);
 				}
-				else {
-					if (i == 0) cread.ignore(SSmax, ' ');
-					else {
-						cread >> cpu_name;
-						int cpuNum = std::stoi(cpu_name.substr(3));
-						if (cpuNum >= target - 1) target = cpuNum + (cread.peek() == 'c' ? 2 : 1);
-
-						//? Add zero value for core if core number is missing from /proc/stat
-						while (i - 1 < cpuNum) {
-							//? Fix container sizes if new cores are detected
-							while (cmp_less(cpu.core_percent.size(), i)) {
-								core_old_totals.push_back(0);
-								core_old_idles.push_back(0);
-								cpu.core_percent.emplace_back();
-							}
-							cpu.core_percent[i-1].push_back(0);
-							if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
-							i++;
-						}
-					}
+				continue;
+			}
 
-					//? Expected on kernel 2.6.3> : 0=user, 1=nice, 2=system, 3=idle, 4=iowait, 5=irq, 6=softirq, 7=steal, 8=guest, 9=guest_nice
-					vector<long long> times;
-					long long total_sum = 0;
+			//? Calculate cpu total for each core
+			fit_core(cpu, core);
+			const long long calc_totals = max(0ll, totals - core_old_totals[core]);
+			const long long calc_idles = max(0ll, idles - core_old_idles[core]);
+			core_old_totals[core] = totals;
+			core_old_idles[core] = idles;
 
-					for (uint64_t val; cread >> val; total_sum += val) {
-						times.push_back(val);
-					}
-					cread.clear();
-					if (times.size() < 4) throw std::runtime_error("Malformed /proc/stat");
+			//? A core that didn't tick since the last read shows 0% instead of dividing by zero
+			cpu.core_percent[core].push_back(calc_totals > 0 ? clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll) : 0);
 
-					//? Subtract fields 8-9 and any future unknown fields
-					const long long totals = max(0ll, total_sum - (times.size() > 8 ? std::accumulate(times.begin() + 8, times.end(), 0ll) : 0));
+			//? Reduce size if there are more values than needed for graph
+			cpu.core_percent[core].set_capacity(40);
+		}
+		if (not got_total) throw std::runtime_error("Failed to parse /proc/stat");
 
-					//? Add iowait field if present
-					const long long idles = max(0ll, times.at(3) + (times.size() > 4 ? times.at(4) : 0));
+		//? Make sure to add zero value for missing core values if at end of file
+		while (cmp_less(next_core, Shared::coreCount)) zero_core(cpu, next_core++);
 
-					//? Calculate values for totals from first line of stat
-					if (i == 0) {
-						const long long calc_totals = max(1ll, totals - cpu_old.at("totals"));
-						const long long calc_idles = max(1ll, idles - cpu_old.at("idles"));
-						cpu_old.at("totals") = totals;
-						cpu_old.at("idles") = idles;
+		//? Rates over the time since the previous read, the first read has nothing to compare with
+		const uint64_t now = time_micros();
+		if (stat_sampled > 0 and now > stat_sampled) {
+			cpu.ctxt_rate = (ctxt >= old_ctxt ? (ctxt - old_ctxt) * 1'000'000 / (now - stat_sampled) : 0);
+			cpu.fork_rate = (forks >= old_forks ? (forks - old_forks) * 1'000'000 / (now - stat_sampled) : 0);
+		}
+		old_ctxt = ctxt;
+		old_forks = forks;
+		stat_sampled = now;
+	}
 
-						//? Total usage of cpu
-						cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+	void update_run_wait(cpu_info& cpu) {
+		static Procfs::ReadBuffer schedstat;
+		static vector<uint64_t> old_delay, old_slices;
+		static bool unsupported{};
+		if (unsupported) return;
 
-						//? Reduce size if there are more values than needed for graph
-						while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
+		if (not schedstat.read(Shared::procPath / "schedstat")) {
+			Logger::info("No /proc/schedstat, run queue wait needs a kernel with CONFIG_SCHEDSTATS.");
+			unsupported = true;
+			return;
+		}
 
-						//? Populate cpu.cpu_percent with all fields from stat
-						for (int ii = 0; const auto& val : times) {
-							cpu.cpu_percent.at(time_names.at(ii)).push_back(clamp((long long)round((double)(val - cpu_old.at(time_names.at(ii))) * 100 / calc_totals), 0ll, 100ll));
-							cpu_old.at(time_names.at(ii)) = val;
+		Procfs::Lines lines(schedstat.view());
+		for (std::string_view line; lines.next(line);) {
+			//? The cpu lines below have had the same fields since version 15
+			if (line.starts_with("version ")) {
+				if (const int version = Procfs::to_int<int>(line.substr(8)); version < 15) {
+					Logger::info("Unsupported /proc/schedstat version " + to_string(version) + ", run queue wait disabled.");
+					unsupported = true;
+					cpu.core_run_wait.clear();
+					return;
+				}
+				continue;
+			}
+			if (not line.starts_with("cpu")) continue;
+
+			//? cpu<N> yld_count legacy sched_count sched_goidle ttwu_count ttwu_local rq_cpu_time run_delay pcount,
+			//? run_delay is the time tasks waited on the run queue in nanoseconds and pcount the number of timeslices run
+			Procfs::Fields fields(line.substr(3));
+			int core;
+			uint64_t run_delay, slices;
+			if (not fields.next_int(core) or core < 0 or not fields.skip(7) or not fields.next_int(run_delay) or not fields.next_int(slices))
+				continue;
+			if (std::cmp_greater_equal(core, cpu.core_run_wait.size())) {
+				cpu.core_run_wait.resize(core + 1, 0);
+				old_delay.resize(core + 1, 0);
+				old_slices.resize(core + 1, 0);
+			}
+			const uint64_t new_slices = slices - old_slices[core];
+			cpu.core_run_wait[core] = (old_slices[core] > 0 and slices > old_slices[core] and run_delay >= old_delay[core]
+				? (run_delay - old_delay[core]) / new_slices / 1000 : 0);
+			old_delay[core] = run_delay;
+			old_slices[core] = slices;
+		}
+	}
 
-							//? Reduce size if there are more values than needed for graph
-							while (cmp_greater(cpu.cpu_percent.at(time_names.at(ii)).size(), width * 2)) cpu.cpu_percent.at(time_names.at(ii)).pop_front();
+	auto collect(bool no_update) -> cpu_info& {
+		if (Runner::stopping or (no_update and not current_cpu.cpu_percent[Field::total].empty())) return current_cpu;
+		auto& cpu = current_cpu;
+		collect_tick++;
 
-							if (++ii == 10) break;
-						}
-						continue;
-					}
-					//? Calculate cpu total for each core
-					else {
-						//? Fix container sizes if new cores are detected
-						while (cmp_less(cpu.core_percent.size(), i)) {
-							core_old_totals.push_back(0);
-							core_old_idles.push_back(0);
-							cpu.core_percent.emplace_back();
-						}
-						const long long calc_totals = max(0ll, totals - core_old_totals.at(i-1));
-						const long long calc_idles = max(0ll, idles - core_old_idles.at(i-1));
-						core_old_totals.at(i-1) = totals;
-						core_old_idles.at(i-1) = idles;
+		if (Config::getB("show_cpu_freq"))
+			cpuHz = get_cpuHz();
 
-						cpu.core_percent.at(i-1).push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
-					}
-				}
+		if (getloadavg(cpu.load_avg.data(), cpu.load_avg.size()) < 0) {
+			Logger::error("failed to get load averages");
+		}
 
-				//? Reduce size if there are more values than needed for graph
-				if (cpu.core_percent.at(i-1).size() > 40) cpu.core_percent.at(i-1).pop_front();
-			}
+		if (not stat_read.read(Shared::procPath / "stat"))
+			throw std::runtime_error("Failed to read /proc/stat");
+
+		try {
+			parse_stat(stat_read.view(), cpu);
 
 			//? Notify main thread to redraw screen if we found more cores than previously detected
 			if (cmp_greater(cpu.core_percent.size(), Shared::coreCount)) {
@@ -954,18 +1327,42 @@ namespace Cpu {
 				Runner::coreNum_reset = true;
 				Shared::coreCount = cpu.core_percent.size();
 				while (cmp_less(current_cpu.temp.size(), cpu.core_percent.size() + 1)) current_cpu.temp.push_back({0});
+				get_topology(cpu);
 			}
 
 		}
 		catch (const std::exception& e) {
 			Logger::debug("Cpu::collect() : " + string{e.what()});
-			if (cread.bad()) throw std::runtime_error("Failed to read /proc/stat");
-			else throw std::runtime_error("Cpu::collect() : " + string{e.what()});
+			throw std::runtime_error("Cpu::collect() : " + string{e.what()});
 		}
 
+		if (g_CfgMgr.get<CfgB>("cpu_core_freq").v())
+			update_core_freqs(cpu);
+
 		if (Config::getB("check_temp") and got_sensors)
 			update_sensors();
 
+		update_groups(cpu);
+
+		if (g_CfgMgr.get<CfgB>("cpu_sched_stats").v())
+			update_run_wait(cpu);
+
+		const bool had_counters = has_counters;
+		if (g_CfgMgr.get<CfgB>("cpu_pmu").v())
+			update_counters(cpu);
+		else {
+			if (has_counters) {
+				close_counters();
+				cpu.counters.clear();
+			}
+			//? Opening is tried again when the option is turned back on, permissions may have been granted since
+			Pmu::failed = false;
+		}
+		//? The counter column changes the width of the core box, resize like when the core count changes
+		if (has_counters != had_counters) Runner::coreNum_reset = true;
+
+		Pressure::update(Pressure::Resource::cpu, cpu.pressure, width * 2);
+
 		if (Config::getB("show_battery") and has_battery)
 			current_bat = get_battery();
 
@@ -1692,14 +2089,14 @@ namespace Gpu {
 			//* Trim vectors if there are more values than needed for graphs
 			if (width != 0) {
 				//? GPU & memory utilization
-				while (cmp_greater(gpu.gpu_percent.at("gpu-totals").size(), width * 2)) gpu.gpu_percent.at("gpu-totals").pop_front();
-				while (cmp_greater(gpu.mem_utilization_percent.size(), width)) gpu.mem_utilization_percent.pop_front();
+				gpu.gpu_percent.at("gpu-totals").set_capacity(width * 2);
+				gpu.mem_utilization_percent.set_capacity(width);
 				//? Power usage
-				while (cmp_greater(gpu.gpu_percent.at("gpu-pwr-totals").size(), width)) gpu.gpu_percent.at("gpu-pwr-totals").pop_front();
+				gpu.gpu_percent.at("gpu-pwr-totals").set_capacity(width);
 				//? Temperature
-				while (cmp_greater(gpu.temp.size(), 18)) gpu.temp.pop_front();
+				gpu.temp.set_capacity(18);
 				//? Memory usage
-				while (cmp_greater(gpu.gpu_percent.at("gpu-vram-totals").size(), width/2)) gpu.gpu_percent.at("gpu-vram-totals").pop_front();
+				gpu.gpu_percent.at("gpu-vram-totals").set_capacity(width/2);
 			}
 		}
 
@@ -1710,9 +2107,9 @@ namespace Gpu {
 			shared_gpu_percent.at("gpu-pwr-total").push_back(pwr_total / gpu_pwr_total_max);
 
 		if (width != 0) {
-			while (cmp_greater(shared_gpu_percent.at("gpu-average").size(), width * 2)) shared_gpu_percent.at("gpu-average").pop_front();
-			while (cmp_greater(shared_gpu_percent.at("gpu-pwr-total").size(), width * 2)) shared_gpu_percent.at("gpu-pwr-total").pop_front();
-			while (cmp_greater(shared_gpu_percent.at("gpu-vram-total").size(), width * 2)) shared_gpu_percent.at("gpu-vram-total").pop_front();
+			shared_gpu_percent.at("gpu-average").set_capacity(width * 2);
+			shared_gpu_percent.at("gpu-pwr-total").set_capacity(width * 2);
+			shared_gpu_percent.at("gpu-vram-total").set_capacity(width * 2);
 		}
 
 		count = gpus.size();
@@ -1723,15 +2120,11 @@ namespace Gpu {
 #endif
 
 namespace Mem {
-   constexpr std::size_t fnv1a(const char* str, std::size_t hash = 14695981039346656037ULL) {
-    return (str[0] == '\0') ? hash : fnv1a(str + 1, (hash ^ static_cast<std::size_t>(str[0])) * 1099511628211ULL);
-   }
-
-   constexpr size_t mem_free_h = fnv1a("MemFree:");
-   constexpr size_t mem_avail_h = fnv1a("MemAvail:");
-   constexpr size_t cached_h = fnv1a("Cached:");
-   constexpr size_t swap_total_h = fnv1a("SwapTotal:");
-   constexpr size_t swap_free_h = fnv1a("SwapFree:");
+	constexpr uint64_t mem_free_h = Procfs::fnv1a("MemFree");
+	constexpr uint64_t mem_avail_h = Procfs::fnv1a("MemAvailable");
+	constexpr uint64_t cached_h = Procfs::fnv1a("Cached");
+	constexpr uint64_t swap_total_h = Procfs::fnv1a("SwapTotal");
+	constexpr uint64_t swap_free_h = Procfs::fnv1a("SwapFree");
 
 	bool has_swap{};
 	vector<string> fstab;
@@ -1745,23 +2138,81 @@ namespace Mem {
 	//?* Collect total ZFS pool io stats
 	bool zfs_collect_pool_total_stats(struct disk_info &disk);
 
+	constexpr uint64_t zfs_writes_h = Procfs::fnv1a("writes");
+	constexpr uint64_t zfs_nwritten_h = Procfs::fnv1a("nwritten");
+	constexpr uint64_t zfs_reads_h = Procfs::fnv1a("reads");
+	constexpr uint64_t zfs_nread_h = Procfs::fnv1a("nread");
+
+	//* Get the writes, nwritten, reads and nread rows of a ZFS objset stat file, rows are "name type data"
+	bool parse_zfs_objset(std::string_view data, array<int64_t, 4>& values) {
+		int found = 0;
+		Procfs::scan_keys(data, ' ', [&](std::string_view key, std::string_view value) {
+			int index;
+			switch (Procfs::fnv1a(key)) {
+				case zfs_writes_h: index = 0; break;
+				case zfs_nwritten_h: index = 1; break;
+				case zfs_reads_h: index = 2; break;
+				case zfs_nread_h: index = 3; break;
+				default: return true;
+			}
+			Procfs::Fields fields(value);
+			if (fields.skip(1) and fields.next_int(values[index])) found |= 1 << index;
+			return found != 0b1111;
+		});
+		return found == 0b1111;
+	}
+
 	mem_info current_mem {};
 
 	uint64_t get_totalMem() {
-		ifstream meminfo(Shared::procPath / "meminfo");
-		int64_t totalMem;
-		if (meminfo.good()) {
-			meminfo.ignore(SSmax, ':');
-			meminfo >> totalMem;
-			totalMem <<= 10;
-		}
-		if (not meminfo.good() or totalMem == 0)
+		//? MemTotal is the first line of /proc/meminfo, this is called from both the collect and draw paths
+		thread_local Procfs::ReadBuffer meminfo(128);
+		uint64_t totalMem = 0;
+		if (meminfo.read(Shared::procPath / "meminfo", 128)) {
+			Procfs::scan_keys(meminfo.view(), ':', [&](std::string_view key, std::string_view value) {
+				if (key == "MemTotal") totalMem = Procfs::to_int<uint64_t>(value) << 10;
+				return false;
+			});
+		}
+		if (totalMem == 0)
 			throw std::runtime_error("Could not get total memory size from /proc/meminfo");
 		return totalMem;
 	}
 
+	void parse_meminfo(std::string_view data, mem_info& mem, bool need_swap) {
+		bool got_avail = false;
+		Procfs::scan_keys(data, ':', [&](std::string_view key, std::string_view value) {
+			if (key.starts_with('D')) return false;
+			switch (Procfs::fnv1a(key)) {
+				case mem_free_h:
+					mem.stats[Field::free] = Procfs::to_int<uint64_t>(value) << 10;
+					break;
+				case mem_avail_h:
+					mem.stats[Field::available] = Procfs::to_int<uint64_t>(value) << 10;
+					got_avail = true;
+					break;
+				case cached_h:
+					mem.stats[Field::cached] = Procfs::to_int<uint64_t>(value) << 10;
+					if (not need_swap) return false;
+					break;
+				case swap_total_h:
+					mem.stats[Field::swap_total] = Procfs::to_int<uint64_t>(value) << 10;
+					break;
+				case swap_free_h:
+					mem.stats[Field::swap_free] = Procfs::to_int<uint64_t>(value) << 10;
+					return false;
+				default:
+					break;
+			}
+			return true;
+		});
+
+		if (!got_avail) mem.stats[Field::available] = mem.stats[Field::free] 
+                                             + mem.stats[Field::cached];
+	}
+
 	auto collect(bool no_update) -> mem_info& {
-		if (Runner::stopping or (no_update and not current_mem.percent.at("used").empty())) return current_mem;
+		if (Runner::stopping or (no_update and not current_mem.percent[Field::used].empty())) return current_mem;
 		auto show_swap = Config::getB("show_swap");
 		auto swap_disk = Config::getB("swap_disk");
 		auto show_disks = Config::getB("show_disks");
@@ -1769,95 +2220,68 @@ namespace Mem {
 		auto totalMem = get_totalMem();
 		auto& mem = current_mem;
 
-		mem.stats.at("swap_total") = 0;
+		mem.stats[Field::swap_total] = 0;
 
 		//? Read ZFS ARC info from /proc/spl/kstat/zfs/arcstats
 		uint64_t arc_size = 0, arc_min_size = 0;
 		if (zfs_arc_cached) {
-			ifstream arcstats(Shared::procPath / "spl/kstat/zfs/arcstats");
-			if (arcstats.good()) {
-				for (string label; arcstats >> label;) {
-					if (label == "c_min") {
-						arcstats >> arc_min_size >> arc_min_size; // double read skips type column
+			static Procfs::ReadBuffer arcstats;
+			if (arcstats.read(Shared::procPath / "spl/kstat/zfs/arcstats")) {
+				//? Lines are "name type data"
+				Procfs::scan_keys(arcstats.view(), ' ', [&](std::string_view key, std::string_view value) {
+					Procfs::Fields fields(value);
+					if (key == "c_min" and fields.skip(1))
+						fields.next_int(arc_min_size);
+					else if (key == "size" and fields.skip(1)) {
+						fields.next_int(arc_size);
+						return false;
 					}
-					else if (label == "size") {
-						arcstats >> arc_size >> arc_size;
-						break;
-					}
-				}
+					return true;
+				});
 			}
-			arcstats.close();
 		}
 
 		//? Read memory info from /proc/meminfo
-		ifstream meminfo("/proc/meminfo");
-		if (!meminfo.good()) {
-         throw std::runtime_error("Failed to read /proc/meminfo");
-      }
+		static Procfs::ReadBuffer meminfo;
+		if (not meminfo.read(Shared::procPath / "meminfo"))
+			throw std::runtime_error("Failed to read /proc/meminfo");
 
-      bool got_avail = false, breakout = false;
-      std::string label;
-      while (meminfo.peek() != 'D' && meminfo >> label && !breakout) {
-         switch (fnv1a(label.c_str())) {
-            case mem_free_h:
-               meminfo >> mem.stats["free"];
-               mem.stats["free"] <<= 10;
-               break;
-            case mem_avail_h:
-               meminfo >> mem.stats["available"];
-               mem.stats["available"] <<= 10;
-               got_avail = true;
-               break;
-            case cached_h:
-               meminfo >> mem.stats["cached"];
-               mem.stats["cached"] <<= 10;
-               if (not show_swap and not swap_disk) breakout = true;
-               break;
-            case swap_total_h:
-               meminfo >> mem.stats["swap_total"];
-               mem.stats["swap_total"] <<= 10;
-               break;
-            case swap_free_h:
-               meminfo >> mem.stats["swap_free"];
-               mem.stats["swap_free"] <<= 10;
-               breakout = true;
-               break;
-            default:
-               break;
-         }
-			meminfo.ignore(SSmax, '\n');
-      }
+		parse_meminfo(meminfo.view(), mem, show_swap or swap_disk);
 
-		if (!got_avail) mem.stats["available"] = mem.stats["free"] 
-                                             + mem.stats["cached"];
 		if (zfs_arc_cached) {
-			mem.stats["cached"] += arc_size;
+			mem.stats[Field::cached] += arc_size;
 			// The ARC will not shrink below arc_min_size, so that memory is not available
 			if (arc_size > arc_min_size)
-				mem.stats.at("available") += arc_size - arc_min_size;
+				mem.stats[Field::available] += arc_size - arc_min_size;
 		}
-		mem.stats["used"] = totalMem - (mem.stats["available"] <= totalMem ? mem.stats["available"] : mem.stats["free"]);
+		mem.stats[Field::used] = totalMem - (mem.stats[Field::available] <= totalMem ? mem.stats[Field::available] : mem.stats[Field::free]);
 
-		if (mem.stats["swap_total"] > 0) mem.stats["swap_used"] = mem.stats["swap_total"] - mem.stats["swap_free"];
-
-		meminfo.close();
+		if (mem.stats[Field::swap_total] > 0) mem.stats[Field::swap_used] = mem.stats[Field::swap_total] - mem.stats[Field::swap_free];
 
 		//? Calculate percentages
-		for (const auto& name : mem_names) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / totalMem));
-			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		for (const auto& name : mem_fields) {
+			mem.percent[name].push_back(round((double)mem.stats[name] * 100 / totalMem));
+			mem.percent[name].set_capacity(width * 2);
 		}
 
-		if (show_swap and mem.stats.at("swap_total") > 0) {
-			for (const auto& name : swap_names) {
-				mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem.stats.at("swap_total")));
-				while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
+		if (show_swap and mem.stats[Field::swap_total] > 0) {
+			for (const auto& name : swap_fields) {
+				mem.percent[name].push_back(round((double)mem.stats[name] * 100 / mem.stats[Field::swap_total]));
+				mem.percent[name].set_capacity(width * 2);
 			}
 			has_swap = true;
 		}
 		else
 			has_swap = false;
 
+		//? Memory and io pressure stall information
+		const bool show_pressure = g_CfgMgr.get<CfgB>("show_pressure").v();
+		if (show_pressure) {
+			for (const auto resource : {Pressure::Resource::memory, Pressure::Resource::io})
+				Pressure::update(resource, mem.pressure[resource], width * 2);
+		}
+		has_pressure = show_pressure and mem.pressure[Pressure::Resource::memory].supported and mem.pressure[Pressure::Resource::io].supported;
+
 		//? Get disks stats
 		if (show_disks) {
 			static vector<string> ignore_list;
@@ -1871,7 +2295,7 @@ namespace Mem {
 				auto zfs_hide_datasets = Config::getB("zfs_hide_datasets");
 				auto& disks = mem.disks;
 				static std::unordered_map<string, future<pair<disk_info, int>>> disks_stats_promises;
-				ifstream diskread;
+				static Procfs::ReadBuffer diskread;
 
 				vector<string> filter;
 				if (not disks_filter.empty()) {
@@ -1886,41 +2310,36 @@ namespace Mem {
 				vector<string> fstypes;
 				if (only_physical and not use_fstab) {
 					fstypes = {"zfs", "wslfs", "drvfs"};
-					diskread.open(Shared::procPath / "filesystems");
-					if (diskread.good()) {
-						for (string fstype; diskread >> fstype;) {
-							if (not is_in(fstype, "nodev", "squashfs", "nullfs"))
-								fstypes.push_back(fstype);
-							diskread.ignore(SSmax, '\n');
+					if (diskread.read(Shared::procPath / "filesystems")) {
+						Procfs::Lines lines(diskread.view());
+						for (std::string_view line, fstype; lines.next(line);) {
+							if (Procfs::Fields(line).next(fstype) and not is_in(fstype, "nodev", "squashfs", "nullfs"))
+								fstypes.emplace_back(fstype);
 						}
 					}
 					else
 						throw std::runtime_error("Failed to read /proc/filesystems");
-					diskread.close();
 				}
 
 				//? Get disk list to use from fstab if enabled
 				if (use_fstab and fs::last_write_time("/etc/fstab") != fstab_time) {
 					fstab.clear();
 					fstab_time = fs::last_write_time("/etc/fstab");
-					diskread.open("/etc/fstab");
-					if (diskread.good()) {
-						for (string instr; diskread >> instr;) {
-							if (not instr.starts_with('#')) {
-								diskread >> instr;
-								#ifdef SNAPPED
-									if (instr == "/") fstab.push_back("/mnt");
-									else if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
-								#else
-									if (not is_in(instr, "none", "swap")) fstab.push_back(instr);
-								#endif
-							}
-							diskread.ignore(SSmax, '\n');
+					if (diskread.read("/etc/fstab")) {
+						Procfs::Lines lines(diskread.view());
+						for (std::string_view line, instr; lines.next(line);) {
+							Procfs::Fields fields(line);
+							if (not fields.next(instr) or instr.starts_with('#') or not fields.next(instr)) continue;
+							#ifdef SNAPPED
+								if (instr == "/") fstab.push_back("/mnt");
+								else if (not is_in(instr, "none", "swap")) fstab.emplace_back(instr);
+							#else
+								if (not is_in(instr, "none", "swap")) fstab.emplace_back(instr);
+							#endif
 						}
 					}
 					else
 						throw std::runtime_error("Failed to read /etc/fstab");
-					diskread.close();
 				}
 
             /// /etc/mtab is good enough, as even on systemd systems, it will
@@ -1933,19 +2352,24 @@ namespace Mem {
                : nullptr)) {
                throw std::runtime_error("Failed to access mount files");
             }
-            diskread.open(procDir);
-            if (!diskread.good()) {
-               diskread.close();
+            if (not diskread.read(procDir)) {
                throw std::runtime_error("Bad disk read");
             }
 
 				vector<string> found;
 				found.reserve(last_found.size());
 				string dev, mountpoint, fstype;
-				while (not diskread.eof()) {
+				Procfs::Lines mounts(diskread.view());
+				for (std::string_view line; mounts.next(line);) {
 					std::error_code ec;
-					diskread >> dev >> mountpoint >> fstype;
-					diskread.ignore(SSmax, '\n');
+					Procfs::Fields fields(line);
+					std::string_view field;
+					if (not fields.next(field)) continue;
+					dev.assign(field);
+					if (not fields.next(field)) continue;
+					mountpoint.assign(field);
+					if (not fields.next(field)) continue;
+					fstype.assign(field);
 
 					if (v_contains(ignore_list, mountpoint) or v_contains(found, mountpoint)) continue;
 
@@ -2017,7 +2441,6 @@ namespace Mem {
 				}
 				if (found.size() != last_found.size()) redraw = true;
 				last_found = std::move(found);
-			diskread.close();
 
 			//? Get disk/partition stats
 			for (auto it = disks.begin(); it != disks.end(); ) {
@@ -2078,11 +2501,11 @@ namespace Mem {
 			if (swap_disk and has_swap) {
 				mem.disks_order.push_back("swap");
 				if (not disks.contains("swap")) disks["swap"] = {"", "swap", "swap"};
-				disks.at("swap").total = mem.stats.at("swap_total");
-				disks.at("swap").used = mem.stats.at("swap_used");
-				disks.at("swap").free = mem.stats.at("swap_free");
-				disks.at("swap").used_percent = mem.percent.at("swap_used").back();
-            disks.at("swap").free_percent = mem.percent.at("swap_free").back();
+				disks.at("swap").total = mem.stats[Field::swap_total];
+				disks.at("swap").used = mem.stats[Field::swap_used];
+				disks.at("swap").free = mem.stats[Field::swap_free];
+				disks.at("swap").used_percent = mem.percent[Field::swap_used].back();
+            disks.at("swap").free_percent = mem.percent[Field::swap_free].back();
 			}
 			for (const auto& name : last_found)
 				#ifdef SNAPPED
@@ -2092,7 +2515,7 @@ namespace Mem {
 				#endif
 
 			//? Get disks IO
-			int64_t sectors_read, sectors_write, io_ticks, io_ticks_temp;
+			int64_t sectors_read, sectors_write, io_ticks;
 			disk_ios = 0;
 			for (auto& [ignored, disk] : disks) {
 				if (disk.stat.empty() or access(disk.stat.c_str(), R_OK) != 0) continue;
@@ -2100,80 +2523,67 @@ namespace Mem {
 					disk_ios++;
 					continue;
 				}
-				diskread.open(disk.stat);
-				if (diskread.good()) {
+				if (diskread.read(disk.stat)) {
 					disk_ios++;
                //? ZFS Pool Support
 				   if (disk.fstype == "zfs") {
-					   // skip first three lines
-						for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> sectors_write; // nbytes written
+						array<int64_t, 4> objset;
+						if (not parse_zfs_objset(diskread.view(), objset)) continue;
+						io_ticks = objset[0] + objset[2];
+						sectors_write = objset[1]; // nbytes written
+						sectors_read = objset[3]; // nbytes read
+
 						if (disk.io_write.empty())
 							disk.io_write.push_back(0);
 						else
 							disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1))));
 						disk.old_io.at(1) = sectors_write;
-						while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+						disk.io_write.set_capacity(width * 2);
 
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks_temp;
-						io_ticks += io_ticks_temp;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> sectors_read; // nbytes read
 						if (disk.io_read.empty())
 							disk.io_read.push_back(0);
 						else
 							disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0))));
 						disk.old_io.at(0) = sectors_read;
-						while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+						disk.io_read.set_capacity(width * 2);
 
 						if (disk.io_activity.empty())
 							disk.io_activity.push_back(0);
 						else
 							disk.io_activity.push_back(max((int64_t)0, (io_ticks - disk.old_io.at(2))));
 						disk.old_io.at(2) = io_ticks;
-						while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+						disk.io_activity.set_capacity(width * 2);
 					} else {
-						for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-						diskread >> sectors_read;
+						//? Fields 3, 7 and 10 are sectors read, sectors written and milliseconds spent doing io
+						Procfs::Fields fields(diskread.view());
+						if (not (fields.skip(2) and fields.next_int(sectors_read)
+							and fields.skip(3) and fields.next_int(sectors_write)
+							and fields.skip(2) and fields.next_int(io_ticks))) continue;
+
 						if (disk.io_read.empty())
 							disk.io_read.push_back(0);
 						else
 							disk.io_read.push_back(max((int64_t)0, (sectors_read - disk.old_io.at(0)) * 512));
 						disk.old_io.at(0) = sectors_read;
-						while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+						disk.io_read.set_capacity(width * 2);
 
-						for (int i = 0; i < 3; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-						diskread >> sectors_write;
 						if (disk.io_write.empty())
 							disk.io_write.push_back(0);
 						else
 							disk.io_write.push_back(max((int64_t)0, (sectors_write - disk.old_io.at(1)) * 512));
 						disk.old_io.at(1) = sectors_write;
-						while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+						disk.io_write.set_capacity(width * 2);
 
-						for (int i = 0; i < 2; i++) { diskread >> std::ws; diskread.ignore(SSmax, ' '); }
-						diskread >> io_ticks;
 						if (disk.io_activity.empty())
 							disk.io_activity.push_back(0);
 						else
 							disk.io_activity.push_back(clamp((long)round((double)(io_ticks - disk.old_io.at(2)) / (uptime - old_uptime) / 10), 0l, 100l));
 						disk.old_io.at(2) = io_ticks;
-						while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+						disk.io_activity.set_capacity(width * 2);
 					}
 				} else {
 					Logger::debug("Error in Mem::collect() : when opening " + string{disk.stat});
 				}
-				diskread.close();
 			}
 			old_uptime = uptime;
 		}
@@ -2197,9 +2607,8 @@ namespace Mem {
 			}
 		}
 
-		ifstream filestream;
+		Procfs::ReadBuffer filestream;
 		string filename;
-		string name_compare;
 
 		if (dataset_name_start != std::string::npos) { // device is a dataset
 			zfs_pool_stat_path = Shared::procPath / "spl/kstat/zfs" / device_name.substr(0, dataset_name_start);
@@ -2212,15 +2621,16 @@ namespace Mem {
 			for (const auto& file: fs::directory_iterator(zfs_pool_stat_path)) {
 				filename = file.path().filename();
 				if (filename.starts_with("objset")) {
-					filestream.open(file.path());
-					if (filestream.good()) {
-						// skip first two lines
-						for (int i = 0; i < 2; i++) filestream.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '7' is reached, indicating data type 7, next value will be object name
-						filestream.ignore(numeric_limits<streamsize>::max(), '7');
-						filestream >> name_compare;
+					if (filestream.read(file.path())) {
+						//? The object name is the data column of the dataset_name row
+						std::string_view name_compare;
+						Procfs::scan_keys(filestream.view(), ' ', [&](std::string_view key, std::string_view value) {
+							if (key != "dataset_name") return true;
+							Procfs::Fields fields(value);
+							if (fields.skip(1)) fields.next(name_compare);
+							return false;
+						});
 						if (name_compare == device_name) {
-							filestream.close();
 							if (access(file.path().c_str(), R_OK) == 0) {
 								return file.path();
 							} else {
@@ -2229,7 +2639,6 @@ namespace Mem {
 							}
 						}
 					}
-					filestream.close();
 				}
 			}
 		}
@@ -2240,11 +2649,8 @@ namespace Mem {
 	}
 
 	bool zfs_collect_pool_total_stats(struct disk_info &disk) {
-		ifstream diskread;
+		static Procfs::ReadBuffer diskread;
 
-		int64_t bytes_read;
-		int64_t bytes_write;
-		int64_t io_ticks;
 		int64_t bytes_read_total{};
 		int64_t bytes_write_total{};
 		int64_t io_ticks_total{};
@@ -2253,40 +2659,17 @@ namespace Mem {
 		// looking through all files that start with 'objset'
 		for (const auto& file: fs::directory_iterator(disk.stat)) {
 			if ((file.path().filename()).string().starts_with("objset")) {
-				diskread.open(file.path());
-				if (diskread.good()) {
-					try {
-						// skip first three lines
-						for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_write;
-						bytes_write_total += bytes_write;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_read;
-						bytes_read_total += bytes_read;
-					} catch (const std::exception& e) {
-						continue;
-					}
+				array<int64_t, 4> objset;
+				if (diskread.read(file.path()) and parse_zfs_objset(diskread.view(), objset)) {
+					io_ticks_total += objset[0] + objset[2];
+					bytes_write_total += objset[1];
+					bytes_read_total += objset[3];
 
 					// increment read objects counter if no errors were encountered
 					objects_read++;
 				} else {
 					Logger::debug("Could not read file: " + file.path().string());
 				}
-				diskread.close();
 			}
 		}
 
@@ -2298,21 +2681,21 @@ namespace Mem {
 		else
 			disk.io_write.push_back(max((int64_t)0, (bytes_write_total - disk.old_io.at(1))));
 		disk.old_io.at(1) = bytes_write_total;
-		while (cmp_greater(disk.io_write.size(), width * 2)) disk.io_write.pop_front();
+		disk.io_write.set_capacity(width * 2);
 
 		if (disk.io_read.empty())
 			disk.io_read.push_back(0);
 		else
 			disk.io_read.push_back(max((int64_t)0, (bytes_read_total - disk.old_io.at(0))));
 		disk.old_io.at(0) = bytes_read_total;
-		while (cmp_greater(disk.io_read.size(), width * 2)) disk.io_read.pop_front();
+		disk.io_read.set_capacity(width * 2);
 
 		if (disk.io_activity.empty())
 			disk.io_activity.push_back(0);
 		else
 			disk.io_activity.push_back(max((int64_t)0, (io_ticks_total - disk.old_io.at(2))));
 		disk.old_io.at(2) = io_ticks_total;
-		while (cmp_greater(disk.io_activity.size(), width * 2)) disk.io_activity.pop_front();
+		disk.io_activity.set_capacity(width * 2);
 
 		return true;
 	}
@@ -2325,11 +2708,14 @@ namespace Net {
 	vector<string> interfaces;
 	string selected_iface;
 	int errors{};
-	std::unordered_map<string, uint64_t> graph_max = { {"download", {}}, {"upload", {}} };
-	std::unordered_map<string, array<int, 2>> max_count = { {"download", {}}, {"upload", {}} };
+	EnumArray<Direction, uint64_t, direction_names> graph_max;
+	EnumArray<Direction, array<int, 2>, direction_names> max_count;
 	bool rescale{true};
 	uint64_t timestamp{};
 
+	//* rx_bytes and tx_bytes of each interface, opened when the interface is first seen and closed when it goes away
+	std::unordered_map<string, EnumArray<Direction, Procfs::SysfsHandle, direction_names>> counters;
+
 	auto collect(bool no_update) -> net_info& {
 		if (Runner::stopping) return empty_net;
 		auto& net = current_net;
@@ -2365,6 +2751,12 @@ namespace Net {
 					interfaces.push_back(iface);
 					net[iface].connected = (ifa->ifa_flags & IFF_RUNNING);
 
+					if (not counters.contains(iface)) {
+						auto& handles = counters[iface];
+						handles[Direction::download] = Procfs::SysfsHandle("/sys/class/net/"s + iface + "/statistics/rx_bytes");
+						handles[Direction::upload] = Procfs::SysfsHandle("/sys/class/net/"s + iface + "/statistics/tx_bytes");
+					}
+
 					// An interface can have more than one IP of the same family associated with it,
 					// but we pick only the first one to show in the NET box.
 					// Note: Interfaces without any IPv4 and IPv6 set are still valid and monitorable!
@@ -2402,15 +2794,12 @@ namespace Net {
 				if (net.at(iface).ipv4.empty() and net.at(iface).ipv6.empty())
 					net.at(iface).ipv4 = readfile("/sys/class/net/" + iface + "/address");
 
-				for (const string dir : {"download", "upload"}) {
-					const fs::path sys_file = "/sys/class/net/" + iface + "/statistics/" + (dir == "download" ? "rx_bytes" : "tx_bytes");
-					auto& saved_stat = net.at(iface).stat.at(dir);
-					auto& bandwidth = net.at(iface).bandwidth.at(dir);
+				auto& handles = counters.at(iface);
+				for (const auto dir : directions) {
+					auto& saved_stat = net.at(iface).stat[dir];
+					auto& bandwidth = net.at(iface).bandwidth[dir];
 
-					uint64_t val{};
-					try { val = (uint64_t)stoull(readfile(sys_file, "0")); }
-					catch (const std::invalid_argument&) {}
-					catch (const std::out_of_range&) {}
+					const uint64_t val = handles[dir].read_int<uint64_t>();
 
 					//? Update speed, total and top values
 					if (val < saved_stat.last) {
@@ -2429,11 +2818,11 @@ namespace Net {
 
 					//? Add values to graph
 					bandwidth.push_back(saved_stat.speed);
-					while (cmp_greater(bandwidth.size(), width * 2)) bandwidth.pop_front();
+					bandwidth.set_capacity(width * 2);
 
 					//? Set counters for auto scaling
 					if (net_auto and selected_iface == iface) {
-						if (net_sync and saved_stat.speed < net.at(iface).stat.at(dir == "download" ? "upload" : "download").speed) continue;
+						if (net_sync and saved_stat.speed < net.at(iface).stat[dir == Direction::download ? Direction::upload : Direction::download].speed) continue;
 						if (saved_stat.speed > graph_max[dir]) {
 							++max_count[dir][0];
 							if (max_count[dir][1] > 0) --max_count[dir][1];
@@ -2456,6 +2845,9 @@ namespace Net {
 						it++;
 				}
 			}
+			if (counters.size() > interfaces.size()) {
+				std::erase_if(counters, [](const auto& entry) { return not v_contains(interfaces, entry.first); });
+			}
 
 			timestamp = new_timestamp;
 		}
@@ -2466,7 +2858,7 @@ namespace Net {
 
 		//? Find an interface to display if selected isn't set or valid
 		if (selected_iface.empty() or not v_contains(interfaces, selected_iface)) {
-			max_count["download"][0] = max_count["download"][1] = max_count["upload"][0] = max_count["upload"][1] = 0;
+			max_count = {};
 			redraw = true;
 			if (net_auto) rescale = true;
 			if (not config_iface.empty() and v_contains(interfaces, config_iface)) selected_iface = config_iface;
@@ -2474,8 +2866,8 @@ namespace Net {
 				//? Sort interfaces by total upload + download bytes
 				auto sorted_interfaces = interfaces;
 				rng::sort(sorted_interfaces, [&](const auto& a, const auto& b){
-					return 	cmp_greater(net.at(a).stat["download"].total + net.at(a).stat["upload"].total,
-										net.at(b).stat["download"].total + net.at(b).stat["upload"].total);
+					return 	cmp_greater(net.at(a).stat[Direction::download].total + net.at(a).stat[Direction::upload].total,
+										net.at(b).stat[Direction::download].total + net.at(b).stat[Direction::upload].total);
 				});
 				selected_iface.clear();
 				//? Try to set to a connected interface
@@ -2493,11 +2885,12 @@ namespace Net {
 		//? Calculate max scale for graphs if needed
 		if (net_auto) {
 			bool sync = false;
-			for (const auto& dir: {"download", "upload"}) {
+			for (const auto dir : directions) {
 				for (const auto& sel : {0, 1}) {
 					if (rescale or max_count[dir][sel] >= 5) {
-						const long long avg_speed = (net[selected_iface].bandwidth[dir].size() > 5
-							? std::accumulate(net.at(selected_iface).bandwidth.at(dir).rbegin(), net.at(selected_iface).bandwidth.at(dir).rbegin() + 5, 0ll) / 5
+						const auto& bandwidth = net[selected_iface].bandwidth[dir];
+						const long long avg_speed = (bandwidth.size() > 5
+							? std::accumulate(bandwidth.rbegin(), bandwidth.rbegin() + 5, 0ll) / 5
 							: net[selected_iface].stat[dir].speed);
 						graph_max[dir] = max(uint64_t(avg_speed * (sel == 0 ? 1.3 : 3.0)), (uint64_t)10 << 10);
 						max_count[dir][0] = max_count[dir][1] = 0;
@@ -2508,7 +2901,7 @@ namespace Net {
 				}
 				//? Sync download/upload graphs if enabled
 				if (sync) {
-					const auto other = (string(dir) == "upload" ? "download" : "upload");
+					const auto other = (dir == Direction::upload ? Direction::download : Direction::upload);
 					graph_max[other] = graph_max[dir];
 					max_count[other][0] = max_count[other][1] = 0;
 					break;
@@ -2558,7 +2951,7 @@ namespace Proc {
 		//? Update cpu percent deque for process cpu graph
 		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
 		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
-		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
+		detailed.cpu_percent.set_capacity(width);
 
 		//? Process runtime
 		detailed.elapsed = sec_to_dhms(uptime - (detailed.entry.cpu_s / Shared::clkTck));
@@ -2573,33 +2966,22 @@ namespace Proc {
 		//? Expand process status from single char to explanative string
 		detailed.status = (proc_states.contains(detailed.entry.state)) ? proc_states.at(detailed.entry.state) : "Unknown";
 
-		ifstream d_read;
-		string short_str;
+		static Procfs::ReadBuffer d_read;
 
 		//? Try to get RSS mem from proc/[pid]/smaps
 		detailed.memory.clear();
-		if (not detailed.skip_smaps and fs::exists(pid_path / "smaps")) {
-			d_read.open(pid_path / "smaps");
+		if (not detailed.skip_smaps and d_read.read(pid_path / "smaps")) {
 			uint64_t rss = 0;
-			try {
-				while (d_read.good()) {
-					d_read.ignore(SSmax, 'R');
-					if (d_read.peek() == 's') {
-						d_read.ignore(SSmax, ':');
-						getline(d_read, short_str, 'k');
-						rss += stoull(short_str);
-					}
-				}
-				if (rss == detailed.entry.mem >> 10)
-					detailed.skip_smaps = true;
-				else {
-					detailed.mem_bytes.push_back(rss << 10);
-					detailed.memory = floating_humanizer(rss, false, 1);
-				}
+			Procfs::scan_keys(d_read.view(), ':', [&](std::string_view key, std::string_view value) {
+				if (key == "Rss") rss += Procfs::to_int<uint64_t>(value);
+				return true;
+			});
+			if (rss == detailed.entry.mem >> 10)
+				detailed.skip_smaps = true;
+			else {
+				detailed.mem_bytes.push_back(rss << 10);
+				detailed.memory = floating_humanizer(rss, false, 1);
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
 		}
 		if (detailed.memory.empty()) {
 			detailed.mem_bytes.push_back(detailed.entry.mem);
@@ -2610,31 +2992,19 @@ namespace Proc {
 			redraw = true;
 		}
 
-		while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
+		detailed.mem_bytes.set_capacity(width);
 
 		//? Get bytes read and written from proc/[pid]/io
-		if (fs::exists(pid_path / "io")) {
-			d_read.open(pid_path / "io");
-			try {
-				string name;
-				while (d_read.good()) {
-					getline(d_read, name, ':');
-					if (name.ends_with("read_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_read = floating_humanizer(stoull(short_str));
-					}
-					else if (name.ends_with("write_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_write = floating_humanizer(stoull(short_str));
-						break;
-					}
-					else
-						d_read.ignore(SSmax, '\n');
+		if (d_read.read(pid_path / "io")) {
+			Procfs::scan_keys(d_read.view(), ':', [&](std::string_view key, std::string_view value) {
+				if (key == "read_bytes")
+					detailed.io_read = floating_humanizer(Procfs::to_int<uint64_t>(value));
+				else if (key == "write_bytes") {
+					detailed.io_write = floating_humanizer(Procfs::to_int<uint64_t>(value));
+					return false;
 				}
-			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
+				return true;
+			});
 		}
 	}
 
@@ -2656,9 +3026,8 @@ namespace Proc {
 			current_sort = sorting;
 			current_rev = reverse;
 		}
-		ifstream pread;
-		string long_string;
-		string short_str;
+		static Procfs::ReadBuffer pread;
+		static string pid_path;
 
 		static vector<size_t> found;
 
@@ -2692,47 +3061,50 @@ namespace Proc {
 
 			//? Update uid_user map if /etc/passwd changed since last run
 			if (not Shared::passwdPath.empty() and fs::last_write_time(Shared::passwdPath) != passwd_time) {
-				string r_uid, r_user;
 				passwd_time = fs::last_write_time(Shared::passwdPath);
 				uid_user.clear();
-				pread.open(Shared::passwdPath);
-				if (pread.good()) {
-					while (pread.good()) {
-						getline(pread, r_user, ':');
-						pread.ignore(SSmax, ':');
-						getline(pread, r_uid, ':');
-						if (uid_user.contains(r_uid)) break;
-						uid_user[r_uid] = r_user;
-						pread.ignore(SSmax, '\n');
+				if (pread.read(Shared::passwdPath)) {
+					//? Lines are "user:password:uid:..."
+					Procfs::Lines lines(pread.view());
+					for (std::string_view line, r_user, r_uid; lines.next(line);) {
+						Procfs::Splitter fields(line, ':');
+						if (not (fields.next(r_user) and fields.next(r_uid) and fields.next(r_uid))) continue;
+						const string uid(r_uid);
+						if (uid_user.contains(uid)) break;
+						uid_user[uid] = r_user;
 					}
 				}
 				else {
 					Shared::passwdPath.clear();
 				}
-				pread.close();
 			}
 
 			//? Get cpu total times from /proc/stat
 			cputimes = 0;
-			pread.open(Shared::procPath / "stat");
-			if (pread.good()) {
-				pread.ignore(SSmax, ' ');
-				for (uint64_t times; pread >> times; cputimes += times);
+			if (pread.read(Shared::procPath / "stat", 1024)) {
+				std::string_view line;
+				Procfs::Lines(pread.view()).next(line);
+				Procfs::Fields fields(line);
+				fields.skip(1);
+				for (uint64_t times; fields.next_int(times); cputimes += times);
 			}
 			else throw std::runtime_error("Failure to read /proc/stat");
-			pread.close();
 
 			//? Iterate over all pids in /proc
 			for (const auto& d: fs::directory_iterator(Shared::procPath)) {
 				if (Runner::stopping)
 					return current_procs;
 
-				if (pread.is_open()) pread.close();
-
-				const string pid_str = d.path().filename();
-				if (not isdigit(pid_str[0])) continue;
+				const string& dir_path = d.path().native();
+				const std::string_view pid_str = std::string_view(dir_path).substr(dir_path.rfind('/') + 1);
+				size_t pid;
+				if (std::from_chars(pid_str.data(), pid_str.data() + pid_str.size(), pid).ec != std::errc{}) continue;
 
-				const size_t pid = stoul(pid_str);
+				//? Read a file in the pid directory into pread, at most <limit> bytes if not 0
+				auto read_pid_file = [&](std::string_view name, size_t limit = 0) {
+					pid_path.assign(dir_path).append(name);
+					return pread.read(pid_path, limit);
+				};
 
 				if (should_filter_kernel and kernels_procs.contains(pid)) {
 					continue;
@@ -2753,41 +3125,28 @@ namespace Proc {
 
 				//? Get program name, command and username
 				if (no_cache) {
-					pread.open(d.path() / "comm");
-					if (not pread.good()) continue;
-					getline(pread, new_proc.name);
-					pread.close();
-					//? Check for whitespace characters in name and set offset to get correct fields from stat file
-					new_proc.name_offset = rng::count(new_proc.name, ' ');
-
-					pread.open(d.path() / "cmdline");
-					if (not pread.good()) continue;
-					long_string.clear();
-					while(getline(pread, long_string, '\0')) {
-						new_proc.cmd += long_string + ' ';
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							break;
-						}
-					}
-					pread.close();
+					if (not read_pid_file("/comm")) continue;
+					std::string_view name;
+					Procfs::Lines(pread.view()).next(name);
+					new_proc.name = name;
+
+					//? Arguments are separated by null characters, the command line is cut at 1000 characters
+					if (not read_pid_file("/cmdline", 1001)) continue;
+					new_proc.cmd = pread.view();
+					if (not new_proc.cmd.empty() and new_proc.cmd.back() != '\0') new_proc.cmd += ' ';
+					rng::replace(new_proc.cmd, '\0', ' ');
+					if (new_proc.cmd.size() > 1000) new_proc.cmd.resize(1000);
 					if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
 
-					pread.open(d.path() / "status");
-					if (not pread.good()) continue;
+					if (not read_pid_file("/status")) continue;
 					string uid;
-					string line;
-					while (pread.good()) {
-						getline(pread, line, ':');
-						if (line == "Uid") {
-							pread.ignore();
-							getline(pread, uid, '\t');
-							break;
-						} else {
-							pread.ignore(SSmax, '\n');
-						}
-					}
-					pread.close();
+					Procfs::scan_keys(pread.view(), ':', [&](std::string_view key, std::string_view value) {
+						if (key != "Uid") return true;
+						std::string_view real_uid;
+						Procfs::Fields(value).next(real_uid);
+						uid = real_uid;
+						return false;
+					});
 					if (uid_user.contains(uid)) {
 						new_proc.user = uid_user.at(uid);
 					}
@@ -2810,82 +3169,51 @@ namespace Proc {
 					}
 				}
 
-				//? Parse /proc/[pid]/stat
-				pread.open(d.path() / "stat");
-				if (not pread.good()) continue;
-
-				const auto& offset = new_proc.name_offset;
-				short_str.clear();
-				int x = 0, next_x = 3;
-				uint64_t cpu_t = 0;
-				try {
-					for (;;) {
-						while (pread.good() and ++x < next_x + offset) pread.ignore(SSmax, ' ');
-						if (not pread.good()) break;
-						else getline(pread, short_str, ' ');
-
-						switch (x-offset) {
-							case 3: //? Process state
-								new_proc.state = short_str.at(0);
-								if (new_proc.ppid != 0) next_x = 14;
-								continue;
-							case 4: //? Parent pid
-								new_proc.ppid = stoull(short_str);
-								next_x = 14;
-								continue;
-							case 14: //? Process utime
-								cpu_t = stoull(short_str);
-								continue;
-							case 15: //? Process stime
-								cpu_t += stoull(short_str);
-								next_x = 19;
-								continue;
-							case 19: //? Nice value
-								new_proc.p_nice = stoll(short_str);
-								continue;
-							case 20: //? Number of threads
-								new_proc.threads = stoull(short_str);
-								if (new_proc.cpu_s == 0) {
-									next_x = 22;
-									new_proc.cpu_t = cpu_t;
-								}
-								else
-									next_x = 24;
-								continue;
-							case 22: //? Get cpu seconds if missing
-								new_proc.cpu_s = stoull(short_str);
-								next_x = 24;
-								continue;
-							case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
-								if (cmp_greater(short_str.size(), totalMem_len))
-									new_proc.mem = totalMem;
-								else
-									new_proc.mem = stoull(short_str) * Shared::pageSize;
-						}
-						break;
-					}
-
-				}
-				catch (const std::invalid_argument&) { continue; }
-				catch (const std::out_of_range&) { continue; }
-
-				pread.close();
+				//? Parse /proc/[pid]/stat, fields are counted after the name as it can contain spaces and parentheses
+				if (not read_pid_file("/stat")) continue;
+				const auto stat = pread.view();
+				const size_t name_end = stat.rfind(')');
+				if (name_end == std::string_view::npos) continue;
+
+				Procfs::Fields fields(stat.substr(name_end + 1));
+				std::string_view state, rss;
+				uint64_t ppid, utime, stime, threads, starttime;
+				int64_t nice;
+				if (not (fields.next(state)											//? 3: Process state
+					and fields.next_int(ppid)										//? 4: Parent pid
+					and fields.skip(9) and fields.next_int(utime)					//? 14: Process utime
+					and fields.next_int(stime)										//? 15: Process stime
+					and fields.skip(3) and fields.next_int(nice)					//? 19: Nice value
+					and fields.next_int(threads)									//? 20: Number of threads
+					and fields.skip(1) and fields.next_int(starttime)				//? 22: Start time, used for cpu seconds
+					and fields.skip(1) and fields.next(rss))) continue;				//? 24: RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
+
+				new_proc.state = state.front();
+				if (new_proc.ppid == 0) new_proc.ppid = ppid;
+				const uint64_t cpu_t = utime + stime;
+				new_proc.p_nice = nice;
+				new_proc.threads = threads;
+				if (new_proc.cpu_s == 0) {
+					new_proc.cpu_s = starttime;
+					new_proc.cpu_t = cpu_t;
+				}
+				if (cmp_greater(rss.size(), totalMem_len))
+					new_proc.mem = totalMem;
+				else
+					new_proc.mem = Procfs::to_int<uint64_t>(rss) * Shared::pageSize;
 
 				if (should_filter_kernel and new_proc.ppid == KTHREADD) {
 					kernels_procs.emplace(new_proc.pid);
 					found.pop_back();
 				}
 
-				if (x-offset < 24) continue;
-
 				//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
 				if (new_proc.mem >= totalMem) {
-					pread.open(d.path() / "statm");
-					if (not pread.good()) continue;
-					pread.ignore(SSmax, ' ');
-					pread >> new_proc.mem;
+					if (not read_pid_file("/statm")) continue;
+					Procfs::Fields statm(pread.view());
+					statm.skip(1);
+					statm.next_int(new_proc.mem);
 					new_proc.mem *= Shared::pageSize;
-					pread.close();
 				}
 
 				//? Process cpu usage since last update
@@ -0,0 +1,80 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+
+//* Minimal test harness, every test case is a function registered under a name that ctest passes to btop_tests
+namespace Test {
+
+	inline int failures = 0;
+
+	inline std::map<std::string_view, std::function<void()>>& cases() {
+		static std::map<std::string_view, std::function<void()>> registered;
+		return registered;
+	}
+
+	//* Registers <func> as test case <name> when constructed at namespace scope
+	struct Case {
+		Case(std::string_view name, std::function<void()> func) { cases().emplace(name, std::move(func)); }
+	};
+
+	inline bool check(bool ok, std::string_view what, std::source_location loc = std::source_location::current()) {
+		if (not ok) {
+			failures++;
+			fmt::println(stderr, "{}:{}: check failed: {}", loc.file_name(), loc.line(), what);
+		}
+		return ok;
+	}
+
+	//* Strings are printed quoted and escaped so control characters in terminal output are readable
+	template <typename T>
+	std::string show(const T& value) {
+		if constexpr (std::is_convertible_v<const T&, std::string_view>) return fmt::format("{:?}", std::string_view(value));
+		else return fmt::format("{}", value);
+	}
+
+	//* Compare <got> to <want>, both are printed on failure
+	template <typename T, typename U>
+	bool equal(const T& got, const U& want, std::string_view what, std::source_location loc = std::source_location::current()) {
+		if (got == want) return true;
+		failures++;
+		fmt::println(stderr, "{}:{}: {}: got {} expected {}", loc.file_name(), loc.line(), what, show(got), show(want));
+		return false;
+	}
+
+	//* Contents of tests/fixtures/<name>, ctest runs the cases from the tests directory
+	inline std::string fixture(const std::string& name, std::source_location loc = std::source_location::current()) {
+		std::ifstream file("fixtures/" + name);
+		check(file.good(), "missing fixture " + name, loc);
+		std::stringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+}
@@ -0,0 +1,211 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <array>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "btop_screen.hpp"
+#include "btop_test.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+
+namespace {
+	//* Send <frame> through Screen::write() as an unbuffered frame and return what reached std::cout
+	string write_raw(const string& frame) {
+		std::ostringstream captured;
+		auto* old = std::cout.rdbuf(captured.rdbuf());
+		Screen::write(frame, false);
+		std::cout.rdbuf(old);
+		string out = captured.str();
+		if (out.starts_with(Term::sync_start) and out.ends_with(Term::sync_end))
+			out = out.substr(Term::sync_start.size(), out.size() - Term::sync_start.size() - Term::sync_end.size());
+		else Test::check(false, "output not wrapped in synchronized output markers");
+		return out;
+	}
+
+	//* Reference for what a terminal does with a stream: every text byte with the colors and styles it's drawn with,
+	//* erases with the background they fill with and all other sequences in order
+	struct Oracle {
+		std::array<bool, 10> attrs{};
+		string fg, bg;
+		std::vector<string> events;
+
+		string pen() const {
+			string s;
+			for (size_t i = 0; i < attrs.size(); i++) if (attrs[i]) s += static_cast<char>('0' + i);
+			return s + '|' + fg + '|' + bg;
+		}
+
+		void sgr(const string& params) {
+			std::vector<int> p;
+			size_t start = 0;
+			while (start <= params.size()) {
+				const size_t end = std::min(params.find(';', start), params.size());
+				p.push_back(end > start ? std::stoi(params.substr(start, end - start)) : 0);
+				start = end + 1;
+			}
+			for (size_t i = 0; i < p.size(); i++) {
+				const int v = p[i];
+				if (v == 0) *this = {{}, {}, {}, std::move(events)};
+				else if (v >= 1 and v <= 9) attrs[v] = true;
+				else if (v == 22) attrs[1] = attrs[2] = false;
+				else if (v >= 23 and v <= 29) attrs[v - 20] = false;
+				else if ((v >= 30 and v <= 37) or (v >= 90 and v <= 97)) fg = fmt::format("b{}", v % 60 - 30 + (v >= 90 ? 8 : 0));
+				else if ((v >= 40 and v <= 47) or (v >= 100 and v <= 107)) bg = fmt::format("b{}", v % 60 - 40 + (v >= 100 ? 8 : 0));
+				else if (v == 39) fg.clear();
+				else if (v == 49) bg.clear();
+				else if (v == 38 or v == 48) {
+					string& color = (v == 38 ? fg : bg);
+					if (p.at(i + 1) == 5) {
+						color = fmt::format("i{}", p.at(i + 2));
+						i += 2;
+					}
+					else {
+						color = fmt::format("rgb{},{},{}", p.at(i + 2), p.at(i + 3), p.at(i + 4));
+						i += 4;
+					}
+				}
+			}
+		}
+
+		void feed(const string& s) {
+			for (size_t i = 0; i < s.size();) {
+				if (s[i] != '\x1b') {
+					const auto c = static_cast<unsigned char>(s[i++]);
+					events.push_back(c < 0x20 ? string(1, c) : string(1, c) + pen());
+					continue;
+				}
+				if (s[i + 1] == ']') {
+					const size_t end = s.find('\a', i);
+					events.push_back(s.substr(i, end + 1 - i));
+					i = end + 1;
+					continue;
+				}
+				size_t end = i + 2;
+				while (s[end] < 0x40 or s[end] > 0x7e) end++;
+				const string params = s.substr(i + 2, end - i - 2);
+				if (s[end] == 'm' and not params.starts_with('?')) sgr(params);
+				else if (s[end] == 'J' or s[end] == 'K' or s[end] == 'X') events.push_back(s.substr(i, end + 1 - i) + pen());
+				else events.push_back(s.substr(i, end + 1 - i));
+				i = end + 1;
+			}
+		}
+	};
+
+	//* Random mix of the sequences btop draws with, every frame ends on a complete sequence
+	string random_frame(std::mt19937& rng) {
+		const std::vector<string> sgr_codes = {
+			"", "0", "1", "2", "22", "3", "23", "4", "24", "5", "25", "7", "27", "8", "28", "9", "29",
+			"31", "37", "39", "92", "42", "49", "104", "38;5;208", "48;5;17", "38;2;255;128;0", "48;2;0;0;40", "0;1;38;2;1;2;3"
+		};
+		const std::vector<string> pieces = {
+			"ab", " ", "█", "─", "⣿⣀", "\x1b[K", "\x1b[2X", "\x1b[J", "\r\n", "\x1b[C", "\x1b[5;10H", "\x1b[?25l", "\x1b]0;btop\a"
+		};
+		string frame;
+		const int len = std::uniform_int_distribution(0, 60)(rng);
+		for (int i = 0; i < len; i++) {
+			if (rng() % 2 == 0) {
+				frame += "\x1b[" + sgr_codes[rng() % sgr_codes.size()];
+				//? At most four codes joined, which stays under the 32 parameters Screen keeps of a sequence
+				for (int joined = 0; joined < 3 and rng() % 3 == 0; joined++) frame += ';' + sgr_codes[1 + rng() % (sgr_codes.size() - 1)];
+				frame += 'm';
+			}
+			else frame += pieces[rng() % pieces.size()];
+		}
+		return frame;
+	}
+
+	//* A full truecolor screen the way the graphs and meters draw it, a color sequence in front of every symbol
+	string graph_frame(int width, int height) {
+		string frame;
+		for (int y = 0; y < height; y++) {
+			frame += Mv::to(y + 1, 1);
+			for (int x = 0; x < width; x++) {
+				const int step = (x / 8 + y / 4) % 16;
+				frame += fmt::format("\x1b[38;2;{};{};{}m", 40 + step * 12, 200 - step * 8, 80);
+				if (x % 40 == 0) frame += "\x1b[49m";
+				frame += (x % 3 == 0 ? "⣿" : "⣀");
+			}
+			frame += "\x1b[0m";
+		}
+		return frame;
+	}
+
+	Test::Case coalesce_case("coalesce", [] {
+		Term::width = 200;
+		Term::height = 60;
+		Screen::invalidate();
+
+		//? The pen carries over between frames, only sequences that change what is drawn are kept
+		Test::equal(write_raw("\x1b[1m\x1b[31m\x1b[0m\x1b[32mab"), "\x1b[0;32mab", "sequences before text merged");
+		Test::equal(write_raw("\x1b[32mcd"), "cd", "pen already set by the last frame");
+		Test::equal(write_raw("\x1b[44m\x1b[K"), "\x1b[44m\x1b[K", "erase gets the background");
+		Test::equal(write_raw("\x1b[2;5H\x1b[?25l\x1b]0;title\a\x1b[0m"), "\x1b[2;5H\x1b[?25l\x1b]0;title\a", "trailing pen change dropped");
+		Test::equal(write_raw("\x1b[0mx"), "\x1b[0mx", "reset when shorter than the changes");
+		Test::equal(write_raw("\x1b[1my\x1b[3"), "\x1b[1my\x1b[3", "truncated sequence kept");
+		Screen::invalidate();
+		Test::equal(write_raw("\x1b[1mz"), "\x1b[0;1mz", "full pen after invalidate");
+
+		//? A clock written between two frames adds to the byte counts instead of replacing them
+		const uint64_t in_before = Screen::bytes_in, out_before = Screen::bytes_out;
+		const string frame_a = "\x1b[1;1H\x1b[32mframe", clock = "\x1b[1;20H\x1b[1m12:00:00", frame_b = "\x1b[2;1Hnext";
+		const size_t written = write_raw(frame_a).size() + write_raw(clock).size() + write_raw(frame_b).size();
+		Test::equal(Screen::bytes_in - in_before, frame_a.size() + clock.size() + frame_b.size(), "bytes passed to write()");
+		Test::equal(Screen::bytes_out - out_before, written, "bytes sent to the terminal");
+
+		//? Random frames drawn through the coalesced output must look the same as the frames themselves
+		std::mt19937 rng(1234);
+		for (int round = 0; round < 500; round++) {
+			Screen::invalidate();
+			Oracle original, coalesced;
+			original.feed("\x1b[0m");
+			coalesced.feed(write_raw("\x1b[0m"));
+			for (int frame_nr = 0; frame_nr < 5; frame_nr++) {
+				const string frame = random_frame(rng);
+				original.feed(frame);
+				coalesced.feed(write_raw(frame));
+			}
+			if (not Test::equal(fmt::format("{}", coalesced.events), fmt::format("{}", original.events), fmt::format("random frames round {}", round)))
+				break;
+		}
+
+		//? Size and time for a full screen of graphs
+		Screen::invalidate();
+		const string frame = graph_frame(Term::width, Term::height);
+		constexpr int runs = 50;
+		size_t out_size = 0;
+		const uint64_t start = Tools::time_micros();
+		for (int i = 0; i < runs; i++) {
+			Screen::invalidate();
+			out_size = write_raw(frame).size();
+		}
+		const uint64_t elapsed = Tools::time_micros() - start;
+		fmt::println("coalesce: {}x{} graph frame {} -> {} bytes ({:.1f}%), {} us per write",
+			Term::width.load(), Term::height.load(), frame.size(), out_size, 100.0 * out_size / frame.size(), elapsed / runs);
+		Test::check(out_size < frame.size() / 2, "repeated colors in a graph frame not coalesced");
+
+		Term::width = Term::height = 0;
+		Screen::invalidate();
+	});
+}
@@ -0,0 +1,74 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "btop_draw.hpp"
+#include "btop_test.hpp"
+
+namespace {
+	//? Compare the SSE2 or NEON kernel with graph_level() one value at a time for every row of graphs up to 10 high,
+	//? the row bounds and rounding modifiers are the ones Graph::_create() uses
+	void compare(const std::vector<int32_t>& values, std::string_view what) {
+		for (int height = 1; height <= 10; height++) {
+			const float mod = (height == 1 ? 0.3 : 0.1);
+			for (int horizon = 0; horizon < height; horizon++) {
+				const int high = (height > 1 ? std::round(100.0 * (height - horizon) / height) : 100);
+				const int low = (height > 1 ? std::round(100.0 * (height - (horizon + 1)) / height) : 0);
+				std::vector<uint8_t> levels(values.size() + 1, 0xff);
+				Draw::graph_levels(values.data(), values.size(), low, high, mod, levels.data());
+				for (size_t i = 0; i < values.size(); i++) {
+					const uint8_t want = Draw::graph_level(values[i], low, high, mod);
+					if (not Test::equal((int)levels[i], (int)want, fmt::format("{} value {} at {} of {} in row {}-{}", what, values[i], i, values.size(), low, high)))
+						return;
+				}
+				Test::equal((int)levels.back(), 0xff, fmt::format("{} wrote past {} values", what, values.size()));
+			}
+		}
+	}
+
+	Test::Case graph_levels_case("graph_levels", [] {
+		std::mt19937 rng(20240611);
+
+		//? Every value in range and around it, in one long row and again shifted to land in different lanes
+		std::vector<int32_t> all;
+		for (int v = -5; v <= 105; v++) all.push_back(v);
+		compare(all, "range");
+		all.erase(all.begin());
+		compare(all, "range shifted");
+
+		//? Edges and values outside the 0-100 clamp
+		compare({0, 100, 0, 100, 0, 100, 0, 100, 100, 0, 100, 0, 100, 0, 100, 0}, "edges");
+		compare({101, 150, 1000, INT_MAX, -1, -100, INT_MIN, 99, 1, 50, 25, 75, 12, 13, 87, 88, 37}, "outside clamp");
+
+		//? Random rows of every length up to 40, covering odd widths and tails shorter than a full vector
+		for (size_t count = 0; count <= 40; count++) {
+			for (const auto& [min, max] : {std::pair{0, 100}, std::pair{-20, 130}}) {
+				std::uniform_int_distribution<int32_t> dist(min, max);
+				std::vector<int32_t> values(count);
+				for (auto& v : values) v = dist(rng);
+				compare(values, fmt::format("random {}-{}", min, max));
+			}
+		}
+	});
+}
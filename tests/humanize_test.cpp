@@ -0,0 +1,180 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "btop_config.hpp"
+#include "btop_test.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+using std::to_string;
+
+namespace {
+	//* floating_humanizer() as it was before humanize(), the reference humanize() is tested against
+	string reference_humanizer(uint64_t value, bool shorten, size_t start, bool bit, bool per_second, bool mega) {
+		string out;
+		const size_t mult = (bit) ? 8 : 1;
+
+		static const std::array<string, 11> mebiUnits_bit {"bit", "Kib", "Mib", "Gib", "Tib", "Pib", "Eib", "Zib", "Yib", "Bib", "GEb"};
+		static const std::array<string, 11> mebiUnits_byte {"Byte", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", "BiB", "GEB"};
+		static const std::array<string, 11> megaUnits_bit {"bit", "Kb", "Mb", "Gb", "Tb", "Pb", "Eb", "Zb", "Yb", "Bb", "Gb"};
+		static const std::array<string, 11> megaUnits_byte {"Byte", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", "BB", "GB"};
+		const auto& units = (bit) ? ( mega ? megaUnits_bit : mebiUnits_bit) : ( mega ? megaUnits_byte : mebiUnits_byte);
+
+		value *= 100 * mult;
+
+		if (mega) {
+			while (value >= 100000) {
+				value /= 1000;
+				if (value < 100) {
+					out = to_string(value);
+					break;
+				}
+				start++;
+			}
+		}
+		else {
+			while (value >= 102400) {
+				value >>= 10;
+				if (value < 100) {
+					out = to_string(value);
+					break;
+				}
+				start++;
+			}
+		}
+		if (out.empty()) {
+			out = to_string(value);
+			if (not mega and out.size() == 4 and start > 0) {
+				out.pop_back();
+				out.insert(2, ".");
+			}
+			else if (out.size() == 3 and start > 0) {
+				out.insert(1, ".");
+			}
+			else if (out.size() >= 2) {
+				out.resize(out.size() - 2);
+			}
+		}
+		if (shorten) {
+			auto f_pos = out.find('.');
+			if (f_pos == 1 and out.size() > 3) {
+				out = to_string(round(stod(out) * 10) / 10).substr(0,3);
+			}
+			else if (f_pos != string::npos) {
+				out = to_string((int)round(stod(out)));
+			}
+			if (out.size() > 3) {
+				out = to_string((int)(out[0] - '0')) + ".0";
+				start++;
+			}
+			out.push_back(units[start][0]);
+		}
+		else out += " " + units[start];
+
+		if (per_second) out += (bit) ? "ps" : "/s";
+		return out;
+	}
+
+	struct Row {
+		uint64_t value;
+		size_t start;
+		bool mega, bit, shorten;
+		string expected;
+	};
+
+	//? Rounding and unit step edges, 10189 bytes is 9.95 KiB, 102349 is 99.95 KiB and 1023488 is 999.5 KiB
+	const std::vector<Row> table = {
+		{10189, 0, false, false, false, "9.95 KiB"},
+		{10189, 0, false, false, true, "10.K"},
+		{102349, 0, false, false, false, "99.9 KiB"},
+		{102349, 0, false, false, true, "100K"},
+		{1023488, 0, false, false, false, "999 KiB"},
+		{1023488, 0, false, false, true, "999K"},
+		{1023, 0, false, false, false, "1023 Byte"},
+		{1023, 0, false, false, true, "1.0K"},
+		{1024, 0, false, false, false, "1.00 KiB"},
+		{1024, 0, false, false, true, "1.0K"},
+		{9950, 0, true, false, false, "9.95 KB"},
+		{9950, 0, true, false, true, "10.K"},
+		{99950, 0, true, false, false, "99 KB"},
+		{999500, 0, true, false, false, "999 KB"},
+		{1023, 0, true, false, false, "1.02 KB"},
+		{1024, 0, true, false, true, "1.0K"},
+		{128, 0, false, true, false, "1.00 Kib"},
+		{1024, 0, false, true, false, "8.00 Kib"},
+		{1024, 0, true, true, false, "8.19 Kb"},
+		{1024, 0, true, true, true, "8.2K"},
+		{0, 0, false, false, false, "0 Byte"},
+		{0, 1, false, false, true, "0K"},
+		{5, 2, false, false, false, "5.00 MiB"},
+		{1023, 3, false, false, true, "1.0T"},
+	};
+
+	//? Values around every unit step in both bases
+	std::vector<uint64_t> edge_values() {
+		std::vector<uint64_t> values;
+		for (uint64_t v = 0; v < 20000; v++) values.push_back(v);
+		for (const uint64_t base : {1000ull, 1024ull}) {
+			for (uint64_t unit = base; unit <= (1ull << 50); unit *= base) {
+				for (const uint64_t mult : {1ull, 9ull, 10ull, 99ull, 100ull, 999ull, 1000ull, 1023ull, 1024ull}) {
+					const uint64_t center = unit * mult;
+					for (uint64_t d = 0; d < 64; d++) values.insert(values.end(), {center + d, center - d, center - center / 200 + d, center - center / 2000 + d});
+				}
+			}
+		}
+		return values;
+	}
+
+	Test::Case humanize_case("humanize", [] {
+		Test::check(g_CfgMgr.init(), "default config loaded");
+		const auto values = edge_values();
+
+		for (const bool mega : {false, true}) {
+			(void)g_CfgMgr.set<CfgB>("base_10_sizes", mega);
+			Tools::update_units();
+
+			for (const auto& row : table) {
+				if (row.mega != mega) continue;
+				const string what = fmt::format("{} start {}{}{}{}", row.value, row.start, mega ? " base 10" : "", row.bit ? " bit" : "", row.shorten ? " shorten" : "");
+				Test::equal(Tools::floating_humanizer(row.value, row.shorten, row.start, row.bit), row.expected, what);
+				Test::equal(reference_humanizer(row.value, row.shorten, row.start, row.bit, false, mega), row.expected, what + " reference");
+			}
+
+			int mismatches = 0;
+			for (const uint64_t value : values) {
+				for (size_t start = 0; start < 4; start++) {
+					for (const int flags : {0, 1, 2, 3, 4, 5, 6, 7}) {
+						const bool shorten = flags & 1, bit = flags & 2, per_second = flags & 4;
+						char out[Tools::humanize_max];
+						const string got(out, Tools::humanize(out, value, shorten, start, bit, per_second));
+						const string want = reference_humanizer(value, shorten, start, bit, per_second, mega);
+						if (got != want and mismatches++ < 10)
+							Test::equal(got, want, fmt::format("{} start {}{}{}{}{}", value, start, mega ? " base 10" : "", bit ? " bit" : "", shorten ? " shorten" : "", per_second ? " per second" : ""));
+					}
+				}
+			}
+			Test::equal(mismatches, 0, mega ? "base 10 mismatches" : "base 2 mismatches");
+		}
+	});
+}
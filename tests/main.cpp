@@ -0,0 +1,39 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+#include "btop_test.hpp"
+
+//* Runs the test case named by the first argument, or all of them without arguments
+int main(int argc, char **argv) {
+	const auto& cases = Test::cases();
+	if (argc > 1) {
+		const auto it = cases.find(argv[1]);
+		if (it == cases.end()) {
+			fmt::println(stderr, "Unknown test case: {}", argv[1]);
+			return 2;
+		}
+		it->second();
+	}
+	else {
+		for (const auto& [name, func] : cases) {
+			fmt::println("{}", name);
+			func();
+		}
+	}
+	return (Test::failures == 0 ? 0 : 1);
+}
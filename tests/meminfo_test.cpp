@@ -0,0 +1,45 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include "btop_shared.hpp"
+#include "btop_test.hpp"
+
+namespace {
+	Test::Case meminfo_case("meminfo", [] {
+		//? MemAvailable is used as is, it was missed before since the key was looked up as "MemAvail:"
+		Mem::mem_info mem{};
+		Mem::parse_meminfo(Test::fixture("meminfo"), mem, true);
+		Test::equal(mem.stats[Mem::Field::free], 1250344ull << 10, "free");
+		Test::equal(mem.stats[Mem::Field::available], 20714912ull << 10, "available");
+		Test::equal(mem.stats[Mem::Field::cached], 17406736ull << 10, "cached");
+		Test::equal(mem.stats[Mem::Field::swap_total], 8388604ull << 10, "swap total");
+		Test::equal(mem.stats[Mem::Field::swap_free], 8126460ull << 10, "swap free");
+
+		Mem::mem_info no_swap{};
+		Mem::parse_meminfo(Test::fixture("meminfo"), no_swap, false);
+		Test::equal(no_swap.stats[Mem::Field::available], 20714912ull << 10, "available without swap");
+		Test::equal(no_swap.stats[Mem::Field::swap_total], 0ull, "swap not read");
+
+		//? Kernels before 3.14 have no MemAvailable
+		Mem::mem_info old{};
+		Mem::parse_meminfo(Test::fixture("meminfo_no_available"), old, true);
+		Test::equal(old.stats[Mem::Field::available], (512340ull + 1830592ull) << 10, "available from free and cached");
+		Test::equal(old.stats[Mem::Field::swap_free], 2097148ull << 10, "swap free without available");
+	});
+}
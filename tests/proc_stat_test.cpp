@@ -0,0 +1,76 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <set>
+#include <string>
+
+#include "btop_shared.hpp"
+#include "btop_test.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+
+namespace {
+	//? The fixtures are two reads of a 512 cpu machine, cpu100-103 and cpu508-511 are offline in both and cpu200 goes
+	//? offline between them. Every other core N is busy for N % 101 of the 100 ticks between the reads.
+	const std::set<size_t> offline = {100, 101, 102, 103, 508, 509, 510, 511};
+	constexpr size_t hotplugged = 200;
+
+	Test::Case proc_stat_case("proc_stat", [] {
+		const string first = Test::fixture("proc_stat_512_a"), second = Test::fixture("proc_stat_512_b");
+		Shared::coreCount = 512;
+		Cpu::width = 20;
+
+		Cpu::cpu_info cpu;
+		Cpu::parse_stat(first, cpu);
+		Cpu::parse_stat(second, cpu);
+
+		Test::equal(cpu.core_percent.size(), 512u, "cores after offline cores at the end");
+		for (size_t core = 0; core < cpu.core_percent.size(); core++) {
+			const auto& percent = cpu.core_percent[core];
+			const string what = fmt::format("cpu{}", core);
+			if (not Test::equal(percent.size(), 2u, what + " values")) continue;
+			if (offline.contains(core)) {
+				Test::equal(percent[0], 0, what + " zero filled in the first read");
+				Test::equal(percent[1], 0, what + " zero filled in the second read");
+			}
+			else if (core == hotplugged) Test::equal(percent[1], 0, what + " zero filled after going offline");
+			else Test::equal(percent[1], static_cast<long long>(core % 101), what + " usage");
+		}
+
+		//? The total line counts the offlined core with frozen values, 25051 of 50300 ticks busy
+		Test::equal(cpu.cpu_percent[Cpu::Field::total].back(), 50, "total usage");
+		Test::equal(cpu.cpu_percent[Cpu::Field::user].back(), 50, "user time");
+		Test::equal(cpu.cpu_percent[Cpu::Field::nice].back(), 0, "nice time");
+		Test::equal(cpu.procs_running, 7, "procs_running");
+		Test::equal(cpu.procs_blocked, 2, "procs_blocked");
+
+		//? Same read again, cores that didn't tick show 0% instead of dividing by zero
+		Cpu::parse_stat(second, cpu);
+		Test::equal(cpu.core_percent[1].back(), 0, "cpu1 without new ticks");
+
+		constexpr int runs = 2000;
+		const uint64_t start = Tools::time_micros();
+		for (int i = 0; i < runs; i++) Cpu::parse_stat(i % 2 == 0 ? first : second, cpu);
+		const uint64_t elapsed = Tools::time_micros() - start;
+		fmt::println("proc_stat: {} byte /proc/stat with {} cpus, {:.1f} us per parse",
+			second.size(), cpu.core_percent.size(), static_cast<double>(elapsed) / runs);
+		Test::equal(cpu.core_percent.size(), 512u, "cores after repeated parses");
+	});
+}
@@ -0,0 +1,92 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <string>
+#include <vector>
+
+#include "btop_procfs.hpp"
+#include "btop_test.hpp"
+
+using std::string;
+
+namespace {
+	struct FixedSample {
+		string text;
+		int64_t two, three;
+	};
+
+	//? Values the way /proc/pressure, /proc/cpuinfo and cpufreq in sysfs write them, -1 is the fallback
+	const std::vector<FixedSample> fixed_samples = {
+		{"2400.123", 240012, 2400123},
+		{"2400.1", 240010, 2400100},
+		{"2400.12", 240012, 2400120},
+		{"2400", 240000, 2400000},
+		{"2400.", 240000, 2400000},
+		{"2400.123456", 240012, 2400123},
+		{"0.05", 5, 50},
+		{"0.00", 0, 0},
+		{"1.5\n", 150, 1500},
+		{"3.25\n\n", 325, 3250},
+		{"  12.30 \t\n", 1230, 12300},
+		{"800000\n", 80000000, 800000000},
+		{"-1.5", -150, -1500},
+		{"-0.25", -25, -250},
+		{"7.9 total=123", 790, 7900},
+		{"", -1, -1},
+		{"\n", -1, -1},
+		{".5", -1, -1},
+		{"abc", -1, -1},
+	};
+
+	Test::Case to_fixed_case("to_fixed", [] {
+		for (const auto& sample : fixed_samples) {
+			Test::equal(Procfs::to_fixed<2>(sample.text, -1), sample.two, fmt::format("to_fixed<2>({:?})", sample.text));
+			Test::equal(Procfs::to_fixed<3>(sample.text, -1), sample.three, fmt::format("to_fixed<3>({:?})", sample.text));
+		}
+		Test::equal(Procfs::to_fixed<0>("42.9"), 42, "to_fixed<0> truncates");
+	});
+
+	static_assert(Procfs::fnv1a("MemAvailable") != Procfs::fnv1a("MemAvail"));
+	static_assert(Procfs::fnv1a("") == 14695981039346656037ULL);
+
+	Test::Case scan_keys_case("scan_keys", [] {
+		//? Known FNV-1a 64 values, so the hashes stay the same as the ones the switch cases were written against
+		Test::equal(Procfs::fnv1a("a"), 0xaf63dc4c8601ec8cULL, "fnv1a(\"a\")");
+		Test::equal(Procfs::fnv1a("foobar"), 0x85944171f73967e8ULL, "fnv1a(\"foobar\")");
+
+		std::vector<string> pairs;
+		const auto collect = [&](std::string_view key, std::string_view value) {
+			pairs.push_back(string(key) + '=' + string(value));
+			return true;
+		};
+		Procfs::scan_keys("processor\t: 0\ncpu MHz\t\t: 2400.000\n\nflags\t\t:\nno separator\nmodel name\t: A: B\n", ':', collect);
+		Test::equal(fmt::format("{}", pairs), R"(["processor=0", "cpu MHz=2400.000", "flags=", "model name=A: B"])", "cpuinfo lines");
+
+		pairs.clear();
+		Procfs::scan_keys("c_min                           4    2097152\nsize\t4 1024\n\n", ' ', collect);
+		Test::equal(fmt::format("{}", pairs), R"(["c_min=4    2097152", "size=4 1024"])", "arcstats lines");
+
+		pairs.clear();
+		Procfs::scan_keys("a: 1\nb: 2\nc: 3", ':', [&](std::string_view key, std::string_view value) {
+			pairs.push_back(string(key) + '=' + string(value));
+			return key != "b";
+		});
+		Test::equal(fmt::format("{}", pairs), R"(["a=1", "b=2"])", "stops when asked");
+	});
+}
@@ -0,0 +1,147 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "btop_config.hpp"
+#include "btop_draw.hpp"
+#include "btop_shared.hpp"
+#include "btop_theme.hpp"
+#include "btop_tools.hpp"
+#include "btop_test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+	//? Kills the test if the runner deadlocks, the waits in Runner give up and quit after 5 seconds on their own
+	void watchdog(std::atomic<bool>& done, std::chrono::seconds limit) {
+		std::thread([&done, limit] {
+			const auto end = std::chrono::steady_clock::now() + limit;
+			while (not done and std::chrono::steady_clock::now() < end) std::this_thread::sleep_for(10ms);
+			if (not done) {
+				fmt::println(stderr, "runner deadlocked, state {} after {} cycles", (int)Runner::state.load(), Runner::cycles.load());
+				std::_Exit(1);
+			}
+		}).detach();
+	}
+
+	//? Runs the real runner thread through collect and draw of the boxes it's handed while other threads pause it and
+	//? ask it to redraw, and boxes are toggled and the terminal resized between cycles the way input and the main loop
+	//? do. Quits at the end and waits for the thread to exit
+	Test::Case runner_stress_case("runner_stress", [] {
+		static std::atomic<bool> done{};
+		watchdog(done, 60s);
+
+		Test::check(g_CfgMgr.init(), "default config loaded");
+		(void)g_CfgMgr.set<CfgB>("pause_unfocused", true);
+		Global::clock = "clock";
+		std::cout.rdbuf(nullptr);
+
+		Shared::init();
+		Theme::updateThemes();
+		Theme::setTheme();
+		Term::width = 160;
+		Term::height = 50;
+		Test::check(Config::set_boxes("cpu mem net proc"), "boxes set");
+		Draw::calcSizes();
+
+		Test::check(Runner::start(), "runner thread started");
+
+		std::atomic<bool> stop_toggling{};
+		std::vector<std::thread> togglers;
+		togglers.emplace_back([&] {
+			std::mt19937 rng(1);
+			while (not stop_toggling) {
+				Runner::focused = not Runner::focused;
+				std::this_thread::sleep_for(std::chrono::microseconds(rng() % 500));
+			}
+			Runner::focused = true;
+		});
+		togglers.emplace_back([&] {
+			std::mt19937 rng(3);
+			while (not stop_toggling) {
+				Runner::redraw = true;
+				std::this_thread::sleep_for(std::chrono::microseconds(rng() % 1000));
+			}
+		});
+
+		//? The runner is only driven from one thread at a time, like the main loop
+		const std::array<std::string, 4> box_sets = {"cpu", "mem net", "proc cpu", "cpu mem net proc"};
+		std::string shown = "cpu mem net proc";
+		std::mt19937 rng(4);
+		const auto end = std::chrono::steady_clock::now() + 2s;
+		while (std::chrono::steady_clock::now() < end) {
+			switch (rng() % 8) {
+				case 0: Runner::stop(); break;
+				case 1: Test::check(Runner::wait_idle(5000), "runner went idle"); break;
+				case 2: {
+					//? Like the box toggle keys in Input::process
+					shown = box_sets.at(rng() % box_sets.size());
+					Tools::atomic_wait(Runner::active);
+					Test::check(Config::set_boxes(shown), "boxes toggled");
+					Config::set("shown_boxes", shown);
+					Draw::calcSizes();
+					Runner::run("all", false, true);
+					break;
+				}
+				case 3: {
+					//? Like term_resize and the main loop after a SIGWINCH
+					Global::resized = true;
+					if (Runner::active) Runner::stop();
+					Term::width = 120 + rng() % 120;
+					Term::height = 40 + rng() % 40;
+					Draw::calcSizes();
+					Global::resized = false;
+					Runner::run("all", true, true);
+					break;
+				}
+				default: {
+					const auto boxes = Tools::ssplit(shown);
+					Runner::run(boxes.at(rng() % boxes.size()), rng() % 2, rng() % 4 == 0);
+				}
+			}
+		}
+
+		stop_toggling = true;
+		for (auto& thread : togglers) thread.join();
+
+		const uint64_t before = Runner::cycles;
+		Runner::run("all");
+		Test::check(Runner::wait_idle(5000), "runner idle after the last cycle");
+		Test::check(Runner::cycles > before, "runner still runs cycles after the stress");
+
+		Global::quitting = true;
+		Runner::stop();
+		Test::equal(pthread_join(Runner::runner_id, nullptr), 0, "runner thread joined");
+		done = true;
+
+		Test::check(not Global::thread_exception, "no exception in collect or draw");
+		Test::equal(Runner::overlapped_cycles.load(), (uint64_t)0, "cycles started while another was running");
+		Test::check(Runner::state == Runner::State::idle, "runner idle after quitting");
+	});
+}
@@ -0,0 +1,77 @@
+/* Copyright 2021 Aristocratos (jakob@qvantnet.com)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+
+indent = tab
+tab-size = 4
+*/
+
+
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "btop_test.hpp"
+#include "btop_tools.hpp"
+
+using std::string;
+
+namespace {
+	struct Sample {
+		string name, input;
+		//? Set where uncolor() is meant to differ from Fx::color_regex, which only matches up to five parameters
+		//? and a second parameter of at most one digit when all five are used
+		std::optional<string> expected{};
+	};
+
+	const std::vector<Sample> samples = {
+		{"plain text", "hello world"},
+		{"empty", ""},
+		{"reset", "\x1b[0mtext\x1b[0m"},
+		{"bold and color", "\x1b[1;31mred\x1b[22;39m"},
+		{"three parameters", "\x1b[0;1;4munderlined"},
+		{"truecolor foreground", "\x1b[38;2;255;128;0morange\x1b[0m"},
+		{"truecolor background", "a\x1b[48;2;10;20;30mb\x1b[49mc"},
+		{"256 color foreground", "\x1b[38;5;196mred"},
+		{"256 color background", "\x1b[48;5;17mblue\x1b[0m"},
+		{"adjacent sequences", "\x1b[1m\x1b[38;5;10m\x1b[48;5;0mx\x1b[0m\x1b[0m"},
+		{"cursor moves are kept", "\x1b[5;10Hab\x1b[2Ccd\x1b[1A\x1b[3D\x1b[s\x1b[u"},
+		{"cursor move between colors", "\x1b[31m\x1b[2;3fx\x1b[0m"},
+		{"sgr without parameters is kept", "\x1b[mtext"},
+		{"lone escape", "a\x1b b"},
+		{"truncated escape at end", "text\x1b"},
+		{"truncated introducer at end", "text\x1b["},
+		{"truncated parameters at end", "text\x1b[38;5"},
+		{"truncated after separator", "text\x1b[38;2;255;"},
+		{"non digit after introducer", "\x1b[?25lhidden\x1b[?25h"},
+		{"utf-8 text", "\x1b[38;5;46m\xe2\x96\x88\xe2\x96\x88\x1b[0m caf\xc3\xa9"},
+		{"high bytes after introducer", "\x1b[\xc3\xa9m\x1b[1\xe2\x94\x80m"},
+		{"high bytes in parameters", "\x1b[3\xff;1mx"},
+		{"high bytes before sequence", "\xff\xfe\x1b[1mx"},
+		{"six parameters", "\x1b[1;38;2;10;20;30mx\x1b[0m", "x"},
+		{"multi digit second of five", "\x1b[0;100;200;300;400mx", "x"},
+	};
+
+	Test::Case uncolor_case("uncolor", [] {
+		for (const auto& sample : samples) {
+			const string oracle = std::regex_replace(sample.input, Fx::color_regex, "");
+			const string got = Fx::uncolor(sample.input);
+			if (sample.expected.has_value()) {
+				Test::equal(got, *sample.expected, sample.name);
+				Test::check(got != oracle, sample.name + ": no longer differs from color_regex, drop the expected value");
+			}
+			else Test::equal(got, oracle, sample.name);
+		}
+	});
+}